@@ -1,9 +1,17 @@
 #include "AIActor.hpp"
 #include "Game/Actor.hpp"
+#include "Game/AgentParallelUpdater.hpp"
 #include "Game/PlayerActor.hpp"
 #include "Game/Map.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/ActorDefinitions.hpp"
+#include "Game/Diagnostics/Profiler.hpp"
+#include "Game/Diagnostics/Telemetry.hpp"
+#include "Game/Navigation/NavDStarLite.hpp"
+#include "Game/Navigation/NavFlowField.hpp"
+#include "Game/Navigation/NavGraph.hpp"
+#include "Game/Navigation/NavPathfinder.hpp"
+#include "Game/Navigation/NavTileStreamer.hpp"
 #include "Engine/AI/Pathfinding/NavMeshPathfinding.hpp"
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/Timer.hpp"
@@ -18,12 +26,15 @@
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Renderer/NavMesh.hpp"
 #include "Engine/Renderer/DebugRenderer.hpp"
+#include <algorithm>
 #include <map>
 #include <cmath>
 
 AIActor::AIActor(Game* game, Map* map, NavMesh* navMesh, NavMeshPathfinding* path)
 	: m_currentGame(game), m_currentMap(map), m_currentNavMesh(navMesh), m_currentPath(path)
 {
+	m_game = game;
+	m_navPathfinder = map->m_navPathfinder;
 	m_obstacleAvoidance = new ObstacleAvoidnace(m_currentNavMesh, m_currentNavMesh->m_heatMap);
 	g_rng.SetSeed(static_cast<unsigned int>(std::chrono::high_resolution_clock::now().time_since_epoch().count()));
 	m_repathDuration = g_rng.SRollRandomFloatInRange(1.5f, 2.5f);
@@ -33,10 +44,18 @@ AIActor::AIActor(Game* game, Map* map, NavMesh* navMesh, NavMeshPathfinding* pat
 AIActor::AIActor(Game* game, PlayGround* playGround)
 	: m_currentGame(game), m_currentPlayGround(playGround)
 {
+	m_game = game;
 	m_obstacleAvoidance = new ObstacleAvoidnace();
 }
 
 void AIActor::Update()
+{
+	PROFILE_ZONE("AIActor::Update");
+	PrepareUpdate();
+	UpdateSteering();
+}
+
+void AIActor::PrepareUpdate()
 {
 	if (m_currentMap)
 	{
@@ -47,31 +66,21 @@ void AIActor::Update()
 		m_actor = m_currentPlayGround->GetActorByUID(m_actorUID);
 	}
 
-	if (m_currentGame->m_gameModeConfig.m_useAStar || m_currentGame->m_gameModeConfig.m_useAStar && m_currentGame->m_gameModeConfig.m_useORCA)
+	if (m_currentGame->m_gameModeConfig.m_useFlowField)
 	{
-		AiTraversalUpdate(GetActor()->m_position);
-		
-		std::vector<Job*> completedJobs;
-		g_theJobSystem->RetrieveCompletedJobs(completedJobs, 20);
-		for (Job* completedPathingJob : completedJobs)
-		{
-			AStarPathfindingJob* pathingJob = dynamic_cast<AStarPathfindingJob*>(completedPathingJob);
-			if (!pathingJob)
-			{
-				delete completedPathingJob;
-				continue;
-			}
-
-			pathingJob->m_ai->m_aiPath = pathingJob->GetResult();
-			pathingJob->m_ai->m_isWaitingForPath = false;
-			if (pathingJob->m_ai->m_aiPath.empty())
-			{
-				pathingJob->m_ai->m_hasReachedGoal = true;          // Trigger new goal generation
-				pathingJob->m_ai->m_repathTimeRemaining = -1.f;     // Force immediate retry
-			}
-			delete pathingJob;
-		}
+		FlowFieldTraversalUpdate(GetActor()->GetPosition());
+	}
+	else if (m_currentGame->m_gameModeConfig.m_useAStar || m_currentGame->m_gameModeConfig.m_useAStar && m_currentGame->m_gameModeConfig.m_useORCA)
+	{
+		// Path results are delivered by the map's job completion stage before any agent updates
+		AiTraversalUpdate(GetActor()->GetPosition());
+	}
+}
 
+void AIActor::UpdateSteering()
+{
+	if (m_currentGame->m_gameModeConfig.m_useAStar || m_currentGame->m_gameModeConfig.m_useAStar && m_currentGame->m_gameModeConfig.m_useORCA)
+	{
 		MoveAlongPathUpdate();
 	}
 	else if (!m_currentGame->m_gameModeConfig.m_useAStar)
@@ -80,6 +89,54 @@ void AIActor::Update()
 	}
 }
 
+void AIActor::OnPathfindingJobCompleted(GameJob* job, Actor* requester)
+{
+	AIActor* ai = requester->GetAiController();
+	if (ai == nullptr) return;
+
+	// Swap buffers so the old path's memory is reused by the next request instead of freed
+	AStarPathfindingJob* pathingJob = static_cast<AStarPathfindingJob*>(job);
+	ai->m_aiPath.swap(pathingJob->m_resultPath);
+	ai->m_spareAiPath.swap(pathingJob->m_resultPath);
+	ai->m_spareAiPath.clear();
+	ai->m_isWaitingForPath = false;
+	ai->m_isWaitingForTiles = false;
+	if (ai->m_aiPath.empty() && pathingJob->m_isWaitingForTiles && ai->m_numTileRetries < NAV_TILE_MAX_RETRIES)
+	{
+		// The goal is fine, its tiles are just not built yet. Keep it and ask again shortly.
+		ai->m_isWaitingForTiles = true;
+		ai->m_tileRetryTimeRemaining = NAV_TILE_RETRY_SECONDS;
+		ai->m_numTileRetries++;
+	}
+	else if (ai->m_aiPath.empty())
+	{
+		ai->m_hasReachedGoal = true;          // Trigger new goal generation
+		ai->m_repathTimeRemaining = -1.f;     // Force immediate retry
+	}
+	else
+	{
+		ai->m_numTileRetries = 0;
+	}
+
+	// The debug renderer is main thread only, so the path is drawn here rather than in the job
+	std::vector<Vec3> const& outPath = ai->m_aiPath;
+	if (ai->m_currentGame->m_enablePathVisual)
+	{
+		for (size_t i = 0; i < outPath.size(); i++)
+		{
+			Vec3 point = outPath[i];
+			Rgba8 pointColor = (i == 0) ? Rgba8::RED : (i == outPath.size() - 1 ? Rgba8::GREEN : Rgba8::MAGENTA);
+			DebugAddWorldPoint(point, 0.1f, 8, 2.5f, pointColor, pointColor, DebugRenderMode::ALWAYS);
+
+			if (i > 0)
+			{
+				Vec3 prevPoint = outPath[i - 1];
+				DebugAddWorldLine(prevPoint, point, 0.1f, 2.5f, Rgba8::BUBBLEGUM_PINK, Rgba8::BUBBLEGUM_PINK, DebugRenderMode::ALWAYS);
+			}
+		}
+	}
+}
+
 FOVZone AIActor::GetFOVZone(Vec3 const& selfPosition, Vec3 const& fwdDir, Vec3 const& otherPosition)
 {
 	Vec3 toOther = (otherPosition - selfPosition).GetNormalized();
@@ -111,7 +168,7 @@ void AIActor::AgentFOV(Vec3 const& originPos, Vec3 const& forwardDir, float angl
 	}
 
 	// Draw wireframe triangles for FOV cone
-	if (m_currentGame->m_enableFOVZoneVisual)
+	if (CanSteeringDebugDraw(m_currentGame->m_enableFOVZoneVisual))
 	{
 		for (int i = 1; i < static_cast<int>(conePoints.size()) - 1; i++)
 		{
@@ -120,6 +177,12 @@ void AIActor::AgentFOV(Vec3 const& originPos, Vec3 const& forwardDir, float angl
 	}
 }
 
+// Steering can run from a worker thread, and the DebugRenderer must only be fed from the main thread
+bool AIActor::CanSteeringDebugDraw(bool isVisualEnabled) const
+{
+	return isVisualEnabled && !AgentParallelUpdater::IsSteeringInParallel();
+}
+
 void AIActor::ApplyFinalMovement(Vec3 const& finalDirection, float maxTurnAngle, float maxAngleBeforeApplyingMovement)
 {
 	if (finalDirection.IsNearlyZero()) return;
@@ -127,7 +190,7 @@ void AIActor::ApplyFinalMovement(Vec3 const& finalDirection, float maxTurnAngle,
 	float turnTowards = finalDirection.GetAngleAboutZDegrees();
 	m_actor->TurnInDirection(turnTowards, maxTurnAngle);
 
-	float angleDiff = fabsf(GetShortestAngularDispDegrees(m_actor->m_orientation.m_yawDegrees, turnTowards));
+	float angleDiff = fabsf(GetShortestAngularDispDegrees(m_actor->GetOrientation().m_yawDegrees, turnTowards));
 	if (angleDiff <= maxAngleBeforeApplyingMovement)
 	{
 		float moveSpeedScale = RangeMapClamped(angleDiff, 0.f, 90.f, 1.f, 0.f);
@@ -140,47 +203,41 @@ void AIActor::CurrentObstacleMode()
 	if (m_currentGame->m_gameModeConfig.m_useVO)
 	{
 		Vec3 direction;
-		std::vector<Actor*> nearbyAgents;
-		GetNearbyAgentsOnThePlayGround(nearbyAgents, m_actor->m_position, m_actor->m_searchRadius);
+		std::vector<int> nearbyAgentSlots;
+		GetNearbyAgentsOnThePlayGround(nearbyAgentSlots, m_actor->GetPosition(), m_actor->m_searchRadius);
 
-		if (!nearbyAgents.empty())
+		if (!nearbyAgentSlots.empty())
 		{
-			direction = m_actor->m_orientation.GetForwardVector();
-			m_actor->m_preferredVelocity = direction * m_actor->m_moveSpeed;
+			direction = m_actor->GetOrientation().GetForwardVector();
+			m_actor->SetPreferredVelocity(direction * m_actor->m_moveSpeed);
 
-			m_actor->UpdateAIAgent();
+			AIAgent selfAgent = m_actor->MakeAIAgent();
 
 			std::vector<AIAgent*> nearbyAI;
-			nearbyAI.reserve(nearbyAgents.size());
+			BuildNearbyAIAgents(nearbyAgentSlots, nearbyAI);
 
-			for (Actor* other : nearbyAgents)
-			{
-				other->UpdateAIAgent(); // Sync each nearby actor's agent
-				nearbyAI.emplace_back(&other->m_agent);
-			}
-
-			m_obstacleAvoidance->ComputeVO(m_actor->m_agent, m_actor->m_searchRadius, nearbyAI, m_currentGame->m_enableCurrentVOAlgorithmVisual);
-			m_actor->m_velocity = m_actor->m_agent.m_velocity;
+			m_obstacleAvoidance->ComputeVO(selfAgent, m_actor->m_searchRadius, nearbyAI, CanSteeringDebugDraw(m_currentGame->m_enableCurrentVOAlgorithmVisual));
+			m_actor->SetVelocity(selfAgent.m_velocity);
 
-			Vec3 adjustedDirection = m_actor->m_velocity.GetNormalized();
+			Vec3 adjustedDirection = m_actor->GetVelocity().GetNormalized();
 			float turnTowards = adjustedDirection.GetAngleAboutZDegrees();
-			float maxTurnAngle = m_actor->m_turnSpeed * m_actor->m_moveSpeed * m_currentGame->m_clock->GetDeltaSeconds();
+			float maxTurnAngle = m_actor->m_turnSpeed * m_actor->m_moveSpeed * m_currentGame->GetDeltaSeconds();
 
 			m_actor->TurnInDirection(turnTowards, maxTurnAngle);
-			float angleDiff = fabsf(GetShortestAngularDispDegrees(m_actor->m_orientation.m_yawDegrees, turnTowards));
+			float angleDiff = fabsf(GetShortestAngularDispDegrees(m_actor->GetOrientation().m_yawDegrees, turnTowards));
 			float moveSpeedScale = RangeMapClamped(angleDiff, 0.f, 90.f, 1.f, 0.f);
 			m_actor->MoveInDirection(adjustedDirection, m_actor->m_moveSpeed * moveSpeedScale);
 		}
 		else
 		{
 			direction = m_actor->m_initialDirection;
-			m_actor->m_preferredVelocity = direction * m_actor->m_moveSpeed;
+			m_actor->SetPreferredVelocity(direction * m_actor->m_moveSpeed);
 
 			float turnTowards = direction.GetAngleAboutZDegrees();
-			float maxTurnAngle = m_actor->m_turnSpeed * m_currentGame->m_clock->GetDeltaSeconds();
+			float maxTurnAngle = m_actor->m_turnSpeed * m_currentGame->GetDeltaSeconds();
 
 			m_actor->TurnInDirection(turnTowards, maxTurnAngle);
-			float angleDiff = fabsf(GetShortestAngularDispDegrees(m_actor->m_orientation.m_yawDegrees, turnTowards));
+			float angleDiff = fabsf(GetShortestAngularDispDegrees(m_actor->GetOrientation().m_yawDegrees, turnTowards));
 			float moveSpeedScale = RangeMapClamped(angleDiff, 0.f, 90.f, 1.f, 0.f);
 			m_actor->MoveInDirection(direction, m_actor->m_moveSpeed * moveSpeedScale);
 		}
@@ -188,47 +245,41 @@ void AIActor::CurrentObstacleMode()
 	else if (m_currentGame->m_gameModeConfig.m_useRVO)
 	{
 		Vec3 direction;
-		std::vector<Actor*> nearbyAgents;
-		GetNearbyAgentsOnThePlayGround(nearbyAgents, m_actor->m_position, m_actor->m_searchRadius);
+		std::vector<int> nearbyAgentSlots;
+		GetNearbyAgentsOnThePlayGround(nearbyAgentSlots, m_actor->GetPosition(), m_actor->m_searchRadius);
 
-		if (!nearbyAgents.empty())
+		if (!nearbyAgentSlots.empty())
 		{
-			direction = m_actor->m_orientation.GetForwardVector();
-			m_actor->m_preferredVelocity = direction * m_actor->m_moveSpeed;
+			direction = m_actor->GetOrientation().GetForwardVector();
+			m_actor->SetPreferredVelocity(direction * m_actor->m_moveSpeed);
 
-			m_actor->UpdateAIAgent();
+			AIAgent selfAgent = m_actor->MakeAIAgent();
 
 			std::vector<AIAgent*> nearbyAI;
-			nearbyAI.reserve(nearbyAgents.size());
-
-			for (Actor* other : nearbyAgents)
-			{
-				other->UpdateAIAgent(); // Sync each nearby actor's agent
-				nearbyAI.emplace_back(&other->m_agent);
-			}
+			BuildNearbyAIAgents(nearbyAgentSlots, nearbyAI);
 
-			m_obstacleAvoidance->ComputeRVO(m_actor->m_agent, m_actor->m_searchRadius, nearbyAI, m_currentGame->m_enableCurrentVOAlgorithmVisual);
-			m_actor->m_velocity = m_actor->m_agent.m_velocity;
+			m_obstacleAvoidance->ComputeRVO(selfAgent, m_actor->m_searchRadius, nearbyAI, CanSteeringDebugDraw(m_currentGame->m_enableCurrentVOAlgorithmVisual));
+			m_actor->SetVelocity(selfAgent.m_velocity);
 
-			Vec3 adjustedDirection = m_actor->m_velocity.GetNormalized();
+			Vec3 adjustedDirection = m_actor->GetVelocity().GetNormalized();
 			float turnTowards = adjustedDirection.GetAngleAboutZDegrees();
-			float maxTurnAngle = m_actor->m_turnSpeed * m_actor->m_moveSpeed * m_currentGame->m_clock->GetDeltaSeconds();
+			float maxTurnAngle = m_actor->m_turnSpeed * m_actor->m_moveSpeed * m_currentGame->GetDeltaSeconds();
 
 			m_actor->TurnInDirection(turnTowards, maxTurnAngle);
-			float angleDiff = fabsf(GetShortestAngularDispDegrees(m_actor->m_orientation.m_yawDegrees, turnTowards));
+			float angleDiff = fabsf(GetShortestAngularDispDegrees(m_actor->GetOrientation().m_yawDegrees, turnTowards));
 			float moveSpeedScale = RangeMapClamped(angleDiff, 0.f, 90.f, 1.f, 0.f);
 			m_actor->MoveInDirection(adjustedDirection, m_actor->m_moveSpeed * moveSpeedScale);
 		}
 		else
 		{
 			direction = m_actor->m_initialDirection;
-			m_actor->m_preferredVelocity = direction * m_actor->m_moveSpeed;
+			m_actor->SetPreferredVelocity(direction * m_actor->m_moveSpeed);
 
 			float turnTowards = direction.GetAngleAboutZDegrees();
-			float maxTurnAngle = m_actor->m_turnSpeed * m_currentGame->m_clock->GetDeltaSeconds();
+			float maxTurnAngle = m_actor->m_turnSpeed * m_currentGame->GetDeltaSeconds();
 
 			m_actor->TurnInDirection(turnTowards, maxTurnAngle);
-			float angleDiff = fabsf(GetShortestAngularDispDegrees(m_actor->m_orientation.m_yawDegrees, turnTowards));
+			float angleDiff = fabsf(GetShortestAngularDispDegrees(m_actor->GetOrientation().m_yawDegrees, turnTowards));
 			float moveSpeedScale = RangeMapClamped(angleDiff, 0.f, 90.f, 1.f, 0.f);
 			m_actor->MoveInDirection(direction, m_actor->m_moveSpeed * moveSpeedScale);
 		}
@@ -236,47 +287,41 @@ void AIActor::CurrentObstacleMode()
 	else if (m_currentGame->m_gameModeConfig.m_useHRVO)
 	{
 		Vec3 direction;
-		std::vector<Actor*> nearbyAgents;
-		GetNearbyAgentsOnThePlayGround(nearbyAgents, m_actor->m_position, m_actor->m_searchRadius);
+		std::vector<int> nearbyAgentSlots;
+		GetNearbyAgentsOnThePlayGround(nearbyAgentSlots, m_actor->GetPosition(), m_actor->m_searchRadius);
 
-		if (!nearbyAgents.empty())
+		if (!nearbyAgentSlots.empty())
 		{
-			direction = m_actor->m_orientation.GetForwardVector();
-			m_actor->m_preferredVelocity = direction * m_actor->m_moveSpeed;
+			direction = m_actor->GetOrientation().GetForwardVector();
+			m_actor->SetPreferredVelocity(direction * m_actor->m_moveSpeed);
 
-			m_actor->UpdateAIAgent();
+			AIAgent selfAgent = m_actor->MakeAIAgent();
 
 			std::vector<AIAgent*> nearbyAI;
-			nearbyAI.reserve(nearbyAgents.size());
+			BuildNearbyAIAgents(nearbyAgentSlots, nearbyAI);
 
-			for (Actor* other : nearbyAgents)
-			{
-				other->UpdateAIAgent(); // Sync each nearby actor's agent
-				nearbyAI.emplace_back(&other->m_agent);
-			}
+			m_obstacleAvoidance->ComputeHRVO(selfAgent, m_actor->m_searchRadius, nearbyAI, CanSteeringDebugDraw(m_currentGame->m_enableCurrentVOAlgorithmVisual));
+			m_actor->SetVelocity(selfAgent.m_velocity);
 
-			m_obstacleAvoidance->ComputeHRVO(m_actor->m_agent, m_actor->m_searchRadius, nearbyAI, m_currentGame->m_enableCurrentVOAlgorithmVisual);
-			m_actor->m_velocity = m_actor->m_agent.m_velocity;
-
-			Vec3 adjustedDirection = m_actor->m_velocity.GetNormalized();
+			Vec3 adjustedDirection = m_actor->GetVelocity().GetNormalized();
 			float turnTowards = adjustedDirection.GetAngleAboutZDegrees();
-			float maxTurnAngle = m_actor->m_turnSpeed * m_actor->m_moveSpeed * m_currentGame->m_clock->GetDeltaSeconds();
+			float maxTurnAngle = m_actor->m_turnSpeed * m_actor->m_moveSpeed * m_currentGame->GetDeltaSeconds();
 
 			m_actor->TurnInDirection(turnTowards, maxTurnAngle);
-			float angleDiff = fabsf(GetShortestAngularDispDegrees(m_actor->m_orientation.m_yawDegrees, turnTowards));
+			float angleDiff = fabsf(GetShortestAngularDispDegrees(m_actor->GetOrientation().m_yawDegrees, turnTowards));
 			float moveSpeedScale = RangeMapClamped(angleDiff, 0.f, 90.f, 1.f, 0.f);
 			m_actor->MoveInDirection(adjustedDirection, m_actor->m_moveSpeed* moveSpeedScale);
 		}
 		else
 		{
 			direction = m_actor->m_initialDirection;
-			m_actor->m_preferredVelocity = direction * m_actor->m_moveSpeed;
+			m_actor->SetPreferredVelocity(direction * m_actor->m_moveSpeed);
 
 			float turnTowards = direction.GetAngleAboutZDegrees();
-			float maxTurnAngle = m_actor->m_turnSpeed * m_currentGame->m_clock->GetDeltaSeconds();
+			float maxTurnAngle = m_actor->m_turnSpeed * m_currentGame->GetDeltaSeconds();
 
 			m_actor->TurnInDirection(turnTowards, maxTurnAngle);
-			float angleDiff = fabsf(GetShortestAngularDispDegrees(m_actor->m_orientation.m_yawDegrees, turnTowards));
+			float angleDiff = fabsf(GetShortestAngularDispDegrees(m_actor->GetOrientation().m_yawDegrees, turnTowards));
 			float moveSpeedScale = RangeMapClamped(angleDiff, 0.f, 90.f, 1.f, 0.f);
 			m_actor->MoveInDirection(direction, m_actor->m_moveSpeed * moveSpeedScale);
 		}
@@ -284,123 +329,130 @@ void AIActor::CurrentObstacleMode()
 	else if (m_currentGame->m_gameModeConfig.m_useORCA)
 	{
 		Vec3 direction;
-		std::vector<Actor*> nearbyAgents;
-		GetNearbyAgentsOnThePlayGround(nearbyAgents, m_actor->m_position, m_actor->m_searchRadius);
+		std::vector<int> nearbyAgentSlots;
+		GetNearbyAgentsOnThePlayGround(nearbyAgentSlots, m_actor->GetPosition(), m_actor->m_searchRadius);
 
-		if (!nearbyAgents.empty())
+		if (!nearbyAgentSlots.empty())
 		{
-			direction = m_actor->m_orientation.GetForwardVector();
-			m_actor->m_preferredVelocity = direction * m_actor->m_moveSpeed;
+			direction = m_actor->GetOrientation().GetForwardVector();
+			m_actor->SetPreferredVelocity(direction * m_actor->m_moveSpeed);
 
 			// Ensure "agent" is moving if interacting with a static "other"
-			for (Actor* other : nearbyAgents)
-			{
-				if (m_actor->m_velocity.GetLengthSquared() <= 0.f && other->m_velocity.GetLengthSquared() > 0.f)
-				{
-					// Swap roles: Treat "other" as the agent and "m_actor" as the static other
-					std::swap(m_actor, other);
-					break;
-				}
-			}
+			SwapWithMovingNeighbor(nearbyAgentSlots);
 
-			m_actor->UpdateAIAgent();
+			AIAgent selfAgent = m_actor->MakeAIAgent();
 
 			std::vector<AIAgent*> nearbyAI;
-			nearbyAI.reserve(nearbyAgents.size());
+			BuildNearbyAIAgents(nearbyAgentSlots, nearbyAI);
 
-			for (Actor* other : nearbyAgents)
 			{
-				other->UpdateAIAgent();
-				nearbyAI.emplace_back(&other->m_agent);
+				PROFILE_ZONE("ComputeORCA");
+				m_obstacleAvoidance->ComputeORCA(selfAgent, m_actor->m_searchRadius, nearbyAI, CanSteeringDebugDraw(m_currentGame->m_enableCurrentVOAlgorithmVisual));
 			}
-
-			m_obstacleAvoidance->ComputeORCA(m_actor->m_agent, m_actor->m_searchRadius, nearbyAI, m_currentGame->m_enableCurrentVOAlgorithmVisual);
-			Vec3 finalDirection = m_actor->m_agent.m_velocity;
-			float maxTurnAngle = 180.f * m_actor->m_moveSpeed * m_currentGame->m_clock->GetDeltaSeconds();
+			Vec3 finalDirection = selfAgent.m_velocity;
+			float maxTurnAngle = 180.f * m_actor->m_moveSpeed * m_currentGame->GetDeltaSeconds();
 			ApplyFinalMovement(finalDirection, maxTurnAngle, 15.f);
 		}
 		else
 		{
 			direction = m_actor->m_initialDirection;
-			m_actor->m_preferredVelocity = direction * m_actor->m_moveSpeed;
+			m_actor->SetPreferredVelocity(direction * m_actor->m_moveSpeed);
 
 			float turnTowards = direction.GetAngleAboutZDegrees();
-			float maxTurnAngle = m_actor->m_turnSpeed * m_currentGame->m_clock->GetDeltaSeconds();
+			float maxTurnAngle = m_actor->m_turnSpeed * m_currentGame->GetDeltaSeconds();
 
 			m_actor->TurnInDirection(turnTowards, maxTurnAngle);
-			float angleDiff = fabsf(GetShortestAngularDispDegrees(m_actor->m_orientation.m_yawDegrees, turnTowards));
+			float angleDiff = fabsf(GetShortestAngularDispDegrees(m_actor->GetOrientation().m_yawDegrees, turnTowards));
 			float moveSpeedScale = RangeMapClamped(angleDiff, 0.f, 90.f, 1.f, 0.f);
 			m_actor->MoveInDirection(direction, m_actor->m_moveSpeed* moveSpeedScale);
 		}
 	}
 }
 
-void AIActor::GetNearbyAgentsOnTheMap(std::vector<Actor*>& agents, const Vec3& position, float radius)
+void AIActor::GetNearbyAgentsOnTheMap(std::vector<int>& agentSlots, const Vec3& position, float radius)
 {
 	if (m_currentGame->m_gameModeConfig.m_useORCA && m_currentGame->m_gameModeConfig.m_useAStar)
 	{
 		float radiusSq = radius * radius;
 
-		for (Actor* agent : m_currentMap->GetAllAgents())
-		{
-			if (agent == nullptr || agent == m_actor) continue; // Skip if null or self
-
-			Vec3 fwdDir = m_actor->m_orientation.GetForwardVector();
-			Vec3 originPos = Vec3(m_actor->m_position.x, m_actor->m_position.y, m_actor->m_position.z + m_actor->m_eyeHeight);
+		Vec3 fwdDir = m_actor->GetOrientation().GetForwardVector();
+		Vec3 originPos = Vec3(m_actor->GetPosition().x, m_actor->GetPosition().y, m_actor->GetPosition().z + m_actor->m_eyeHeight);
 
-			AgentFOV(originPos, fwdDir, radiusSq);
+		AgentFOV(originPos, fwdDir, radiusSq);
 
-			Vec3 toOtherAgent = agent->m_position - originPos;
-			toOtherAgent.z = 0.f;
-			toOtherAgent.Normalize();
+		size_t firstNewAgent = agentSlots.size();
+		m_currentMap->m_agentSpatialHash.GetAgentsInRadius(position, radius, agentSlots, static_cast<int>(m_actor->m_uid.GetIndex()));
 
-			float d = DotProduct3D(fwdDir, toOtherAgent);
-			float fovCosThreshold = CosDegrees(FOV_DEGREES * 0.5f);
-			if (d < fovCosThreshold) { continue; }
-			float distacneSq = GetDistanceSquared3D(position, agent->m_position);
-			if (distacneSq <= radiusSq)
+		// Drop everyone outside the FOV cone
+		std::vector<Vec3> const& agentPositions = m_currentMap->m_agentStates.m_snapshotPositions;
+		float fovCosThreshold = CosDegrees(FOV_DEGREES * 0.5f);
+		auto isOutsideFOV = [&](int agentSlot)
 			{
-				agents.emplace_back(agent);
-			}
-		}
+				Vec3 toOtherAgent = agentPositions[agentSlot] - originPos;
+				toOtherAgent.z = 0.f;
+				toOtherAgent.Normalize();
+				return DotProduct3D(fwdDir, toOtherAgent) < fovCosThreshold;
+			};
+		agentSlots.erase(std::remove_if(agentSlots.begin() + firstNewAgent, agentSlots.end(), isOutsideFOV), agentSlots.end());
 	}
 }
  
-void AIActor::GetNearbyAgentsOnThePlayGround(std::vector<Actor*>& agents, const Vec3& position, float radius)
+void AIActor::GetNearbyAgentsOnThePlayGround(std::vector<int>& agentSlots, const Vec3& position, float radius)
 {
 	if (!m_currentGame->m_gameModeConfig.m_useAStar)
 	{
-		float radiusSq = radius * radius;
-
-		for (Actor* agent : m_currentPlayGround->GetAllAgents())
-		{
-			if (agent == nullptr || agent == m_actor) continue;
-
-			float distacneSq = GetDistanceSquared3D(position, agent->m_position);
-			if (distacneSq <= radiusSq)
-			{
-				agents.emplace_back(agent);
-			}
-		}
+		m_currentPlayGround->m_agentSpatialHash.GetAgentsInRadius(position, radius, agentSlots, static_cast<int>(m_actor->m_uid.GetIndex()));
 	}
 }
 
-void AIActor::AiTraversalUpdate(Vec3 currentPos)
+AgentStateStore& AIActor::GetAgentStates() const
 {
-	if (m_hasReachedGoal && m_repathTimeRemaining <= 0.f)
+	if (m_currentMap)
 	{
-		// Get random goal triangle position within nav mesh 
-		int randomTriangleIndex = m_currentNavMesh->GetRandomNavMeshTriangleIndex();
+		return m_currentMap->m_agentStates;
+	}
+	return m_currentPlayGround->m_agentStates;
+}
+
+void AIActor::SwapWithMovingNeighbor(std::vector<int> const& nearbyAgentSlots)
+{
+	if (m_actor->GetVelocity().GetLengthSquared() > 0.f) return;
 
-		m_goalPoint = m_currentPath->GetRandomPointWithinTriangleIndex(randomTriangleIndex); // Don't know why this does not work
+	// Steering another agent from a worker would race with that agent's own job
+	if (m_currentGame->m_gameModeConfig.m_useParallelAgentUpdate) return;
 
-		if (!m_currentNavMesh->GetContainingTriangleIndex(m_goalPoint))
+	AgentStateStore& agentStates = GetAgentStates();
+	for (int otherSlot : nearbyAgentSlots)
+	{
+		if (agentStates.GetAIAgent(otherSlot)->m_velocity.GetLengthSquared() > 0.f)
 		{
-			int fallBackTriangleIndex = m_currentNavMesh->GetRandomNavMeshTriangleIndex();
-			m_goalPoint = m_currentPath->GetRandomPointWithinTriangleIndex(fallBackTriangleIndex);
+			// Swap roles: Treat "other" as the agent and "m_actor" as the static other
+			std::vector<Actor*> const& agentSlots = m_currentMap ? m_currentMap->GetAllAgents() : m_currentPlayGround->GetAllAgents();
+			m_actor = agentSlots[otherSlot];
+			break;
 		}
+	}
+}
 
-		RequestPathfindingJob(currentPos, m_goalPoint);
+void AIActor::BuildNearbyAIAgents(std::vector<int> const& nearbyAgentSlots, std::vector<AIAgent*>& nearbyAI)
+{
+	AgentStateStore& agentStates = GetAgentStates();
+	int selfSlot = static_cast<int>(m_actor->m_uid.GetIndex());
+
+	// Neighbors point into the store's snapshot, which holds their state from the start of this frame
+	nearbyAI.reserve(nearbyAI.size() + nearbyAgentSlots.size());
+	for (int otherSlot : nearbyAgentSlots)
+	{
+		if (otherSlot == selfSlot) continue;
+		nearbyAI.emplace_back(agentStates.GetAIAgent(otherSlot));
+	}
+}
+
+void AIActor::AiTraversalUpdate(Vec3 currentPos)
+{
+	if (m_hasReachedGoal && m_repathTimeRemaining <= 0.f)
+	{
+		m_goalPoint = GetRandomReachableGoalPoint(currentPos);
 
 		// Reset timer
 		g_rng.SetSeed(static_cast<unsigned int>(std::chrono::high_resolution_clock::now().time_since_epoch().count()));
@@ -409,10 +461,32 @@ void AIActor::AiTraversalUpdate(Vec3 currentPos)
 		
 		// Set goal as not yet reached
 		m_hasReachedGoal = false;
+		m_isWaitingForTiles = false;
+		m_numTileRetries = 0;
+
+		RequestPathfindingJob(currentPos, m_goalPoint);
+	}
+	else if (!m_hasReachedGoal && !m_isWaitingForPath && m_isWaitingForNavChange && !m_currentMap->IsNavChangePending())
+	{
+		RequestPathfindingJob(currentPos, m_goalPoint);
+	}
+	else if (!m_hasReachedGoal && !m_isWaitingForPath && m_currentGame->m_gameModeConfig.m_useIncrementalReplanning && m_replanner != nullptr && m_replanner->HasPendingChanges(m_currentMap->m_navGraph))
+	{
+		// Obstacles changed the graph under the current path, repair the search from where we stand
+		RequestPathfindingJob(currentPos, m_goalPoint);
+	}
+	else if (!m_hasReachedGoal && !m_isWaitingForPath && m_isWaitingForTiles)
+	{
+		m_tileRetryTimeRemaining -= m_currentGame->GetDeltaSeconds();
+		if (m_tileRetryTimeRemaining <= 0.f)
+		{
+			m_isWaitingForTiles = false;
+			RequestPathfindingJob(currentPos, m_goalPoint);
+		}
 	}
 
 	// Calculate the position within the goal point & check if we have reached the goal
-	float distanceSqToGoalPoint = GetDistanceSquared3D(GetActor()->m_position, m_goalPoint);
+	float distanceSqToGoalPoint = GetDistanceSquared3D(GetActor()->GetPosition(), m_goalPoint);
 	float actorRadiusSq = GetActor()->m_physicsRadius * GetActor()->m_physicsRadius;
 
 	if (distanceSqToGoalPoint <= actorRadiusSq * 1.1f) // Initial check for floating point errors that can occur 
@@ -424,12 +498,12 @@ void AIActor::AiTraversalUpdate(Vec3 currentPos)
 	// If goal is reached, tick down timer until we find a new goal
 	if (m_hasReachedGoal)
 	{
-		m_repathTimeRemaining -= m_currentGame->m_clock->GetDeltaSeconds();
+		m_repathTimeRemaining -= m_currentGame->GetDeltaSeconds();
 	}
-	else if (!m_hasReachedGoal && m_aiPath.empty())
+	else if (!m_hasReachedGoal && m_aiPath.empty() && !m_isWaitingForTiles && !m_isWaitingForNavChange)
 	{
 		// Fail-safe: no path and haven't reached goal = maybe we got stuck?
-		m_goalCheckTimer += m_currentGame->m_clock->GetDeltaSeconds();
+		m_goalCheckTimer += m_currentGame->GetDeltaSeconds();
 		if (m_goalCheckTimer >= 0.5f)
 		{
 			m_hasReachedGoal = true;
@@ -443,6 +517,26 @@ void AIActor::AiTraversalUpdate(Vec3 currentPos)
 	}
 }
 
+void AIActor::FlowFieldTraversalUpdate(Vec3 currentPos)
+{
+	// No path job, the path is just the flow field's next hop and gets refreshed every frame
+	m_aiPath.clear();
+	NavFlowField const* flowField = m_currentMap->m_flowField;
+	if (flowField == nullptr || !flowField->IsBuiltFor(m_currentMap->m_navGraph)) return;
+
+	m_goalPoint = flowField->m_goalPoint;
+	float arrivalRadius = FLOW_FIELD_ARRIVAL_RADIUS_SCALE * GetActor()->m_physicsRadius;
+	if (GetDistanceSquared3D(currentPos, m_goalPoint) <= arrivalRadius * arrivalRadius) return;
+
+	m_currentNavTriangle = m_currentMap->m_navGraph->FindNearestTriangleFromHint(currentPos, m_currentNavTriangle);
+
+	Vec3 steeringTarget;
+	if (flowField->GetSteeringTarget(m_currentNavTriangle, steeringTarget))
+	{
+		m_aiPath.emplace_back(steeringTarget);
+	}
+}
+
 void AIActor::MoveAlongPathUpdate()
 {
 	if (!m_aiPath.empty())
@@ -450,65 +544,62 @@ void AIActor::MoveAlongPathUpdate()
 		Vec3 nextPoint = m_aiPath.back();
 
 		// Calculate direction from the current position to the center of the next mesh (triangle)
-		Vec3 directionToPoint = nextPoint - m_actor->m_position;
+		Vec3 directionToPoint = nextPoint - m_actor->GetPosition();
 
 		// Find nearby agents
-		std::vector<Actor*> nearbyAgents;
-		GetNearbyAgentsOnTheMap(nearbyAgents, m_actor->m_position, m_actor->m_searchRadius);
+		std::vector<int> nearbyAgentSlots;
+		GetNearbyAgentsOnTheMap(nearbyAgentSlots, m_actor->GetPosition(), m_actor->m_searchRadius);
 
 		Vec3 finalDirection = directionToPoint.GetNormalized() * m_actor->m_moveSpeed;
 		float maxTurnAngle = 0.f;
 
 		if (m_currentGame->m_gameModeConfig.m_useORCA && m_currentGame->m_gameModeConfig.m_useAStar)
 		{
-			if (!nearbyAgents.empty())
+			if (!nearbyAgentSlots.empty())
 			{
 				// Set preferred Velocity
-				m_actor->m_preferredVelocity = directionToPoint * m_actor->m_moveSpeed;
+				m_actor->SetPreferredVelocity(directionToPoint * m_actor->m_moveSpeed);
 
 				// Ensure "agent" is moving if interacting with a static "other"
-				for (Actor* other : nearbyAgents)
-				{
-					if (m_actor->m_velocity.GetLengthSquared() <= 0.f && other->m_velocity.GetLengthSquared() > 0.f)
-					{
-						// Swap roles: Treat "other" as the agent and "m_actor" as the static other
-						std::swap(m_actor, other);
-						break;
-					}
-				}
+				SwapWithMovingNeighbor(nearbyAgentSlots);
 
-				m_actor->UpdateAIAgent();
+				AIAgent selfAgent = m_actor->MakeAIAgent();
 
 				std::vector<AIAgent*> nearbyAI;
-				AgentPrioritization(nearbyAgents, nearbyAI);
+				AgentPrioritization(nearbyAgentSlots, nearbyAI);
 
 				//float angleDiff = fabsf(GetShortestAngularDispDegrees(m_actor->m_orientation.m_yawDegrees, finalDirection.GetAngleAboutZDegrees()));
-				m_obstacleAvoidance->ComputeORCA(m_actor->m_agent, m_actor->m_searchRadius, nearbyAI, m_currentGame->m_enableCurrentVOAlgorithmVisual);
-				m_actor->m_velocity = m_actor->m_agent.m_velocity;
+				{
+					PROFILE_ZONE("ComputeORCA");
+					m_obstacleAvoidance->ComputeORCA(selfAgent, m_actor->m_searchRadius, nearbyAI, CanSteeringDebugDraw(m_currentGame->m_enableCurrentVOAlgorithmVisual));
+				}
+				m_actor->SetVelocity(selfAgent.m_velocity);
 				//m_actor->m_position.z =  m_currentPath->GetHeightOnTriangle(m_actor->m_position);
-				finalDirection = m_actor->m_velocity;
-				maxTurnAngle = /*m_actor->m_turnSpeed*/ 180.f * m_actor->m_moveSpeed * m_currentGame->m_clock->GetDeltaSeconds();
+				finalDirection = m_actor->GetVelocity();
+				maxTurnAngle = /*m_actor->m_turnSpeed*/ 180.f * m_actor->m_moveSpeed * m_currentGame->GetDeltaSeconds();
 				ApplyFinalMovement(finalDirection, maxTurnAngle, MAX_ANGLE_BEFORE_MOVEMENT);
 			}
 			else
 			{
-				maxTurnAngle = 180.f * m_currentGame->m_clock->GetDeltaSeconds();
+				maxTurnAngle = 180.f * m_currentGame->GetDeltaSeconds();
 				ApplyFinalMovement(finalDirection, maxTurnAngle, MAX_ANGLE_BEFORE_MOVEMENT);
 			}
 		}
 		else if (!m_currentGame->m_gameModeConfig.m_useORCA && m_currentGame->m_gameModeConfig.m_useAStar)
 		{
-			maxTurnAngle = 180.f * m_currentGame->m_clock->GetDeltaSeconds();
+			maxTurnAngle = 180.f * m_currentGame->GetDeltaSeconds();
 			ApplyFinalMovement(finalDirection, maxTurnAngle, MAX_ANGLE_BEFORE_MOVEMENT);
 		}
 
-		if (m_actor->m_position.z > ALLOWED_HEIGHT_DEVIATION)
+		if (m_actor->GetPosition().z > ALLOWED_HEIGHT_DEVIATION)
 		{
-			m_actor->m_position.z = Interpolate(m_actor->m_position.z, m_currentPath->GetHeightOnTriangle(m_actor->m_position), 0.3f);
+			Vec3 agentPosition = m_actor->GetPosition();
+			agentPosition.z = Interpolate(agentPosition.z, GetGroundHeight(agentPosition), 0.3f);
+			m_actor->SetPosition(agentPosition);
 		}
 
 		// Determine if the agent should move to the next waypoint in the path
-		float distanceSqToNextWaypoint = GetDistanceSquared3D(m_actor->m_position, nextPoint);
+		float distanceSqToNextWaypoint = GetDistanceSquared3D(m_actor->GetPosition(), nextPoint);
 		float actorRadiusSq = m_actor->m_physicsRadius * m_actor->m_physicsRadius;
 
 		// Skip current waypoint if effectively bypassed after ORCA adjustment
@@ -519,7 +610,7 @@ void AIActor::MoveAlongPathUpdate()
 		else
 		{
 			// Check if the agent has moved past the waypoint after ORCA adjustment
-			Vec3 directionToNext = (nextPoint - m_actor->m_previousPosition).GetNormalized();
+			Vec3 directionToNext = (nextPoint - m_actor->GetPreviousPosition()).GetNormalized();
 			float dotProduct = DotProduct3D(directionToNext, finalDirection.GetNormalized());
 
 			if (dotProduct < 0.f) // Agent has passed the target point
@@ -530,21 +621,25 @@ void AIActor::MoveAlongPathUpdate()
 	}
 }
 
-void AIActor::AgentPrioritization(std::vector<Actor*>& nearbyAgents, std::vector<AIAgent*>& nearbyAI)
+void AIActor::AgentPrioritization(std::vector<int>& nearbyAgentSlots, std::vector<AIAgent*>& nearbyAI)
 {
-	nearbyAI.reserve(nearbyAgents.size());
+	AgentStateStore& agentStates = GetAgentStates();
+	int selfSlot = static_cast<int>(m_actor->m_uid.GetIndex());
 
-	std::vector<std::pair<Actor*, FOVZone>> prioritizeAgents;
+	nearbyAI.reserve(nearbyAgentSlots.size());
 
-	for (Actor* other : nearbyAgents)
-	{
-		if (other == nullptr || other == m_actor) continue;
+	Vec3 fwd = m_actor->GetOrientation().GetForwardVector();
+	Vec3 eyePos = m_actor->GetPosition() + Vec3(0.f, 0.f, m_actor->m_eyeHeight);
 
-		Vec3 fwd = m_actor->m_orientation.GetForwardVector();
-		Vec3 eyePos = m_actor->m_position + Vec3(0.f, 0.f, m_actor->m_eyeHeight);
+	std::vector<std::pair<int, FOVZone>> prioritizeAgents;
+	prioritizeAgents.reserve(nearbyAgentSlots.size());
+
+	for (int otherSlot : nearbyAgentSlots)
+	{
+		if (otherSlot == selfSlot || !agentStates.IsActive(otherSlot)) continue;
 
-		FOVZone priority = GetFOVZone(eyePos, fwd, other->m_position);
-		prioritizeAgents.emplace_back(other, priority);
+		FOVZone priority = GetFOVZone(eyePos, fwd, agentStates.m_snapshotPositions[otherSlot]);
+		prioritizeAgents.emplace_back(otherSlot, priority);
 	}
 
 	std::sort(prioritizeAgents.begin(), prioritizeAgents.end(),
@@ -553,79 +648,134 @@ void AIActor::AgentPrioritization(std::vector<Actor*>& nearbyAgents, std::vector
 			return static_cast<int>(a.second) < static_cast<int>(b.second); // Lower zone enum = higher priority
 		});
 
-	for (const auto& [other, zone] : prioritizeAgents)
+	for (const auto& [otherSlot, zone] : prioritizeAgents)
 	{
-		other->UpdateAIAgent();
-		nearbyAI.emplace_back(&other->m_agent);
+		nearbyAI.emplace_back(agentStates.GetAIAgent(otherSlot));
 	}
 }
 
 void AIActor::HeighDeviationCheck()
 {
-	if (m_actor->m_position.z > ALLOWED_HEIGHT_DEVIATION)
+	if (m_actor->GetPosition().z > ALLOWED_HEIGHT_DEVIATION)
 	{
 		if (m_aiPath.size() >= 2)
 		{
 			Vec3 currentWaypoint = m_aiPath[m_aiPath.size() - 1];
 			Vec3 previousWaypoint = m_aiPath[m_aiPath.size() - 2];
 
-			Vec3 agentPosition = m_actor->m_position;
+			Vec3 agentPosition = m_actor->GetPosition();
 			Vec3 pathSegment = previousWaypoint - currentWaypoint;
 			Vec3 agentToWaypointStart = agentPosition - currentWaypoint;
 
 			Vec3 projectionPoint = GetProjectedOnto3D(agentToWaypointStart, pathSegment);
 			Vec3 projectedPositionOnPath = currentWaypoint + projectionPoint;
 			//DebugAddWorldLine(m_actor->m_position, projectedPositionOnPath, 0.1f, 0.f, Rgba8::WISTERIA, Rgba8::WISTERIA, DebugRenderMode::ALWAYS);;
-			m_actor->m_position.z = Interpolate(m_actor->m_position.z, projectedPositionOnPath.z, 0.2f);
+			agentPosition.z = Interpolate(agentPosition.z, projectedPositionOnPath.z, 0.2f);
+			m_actor->SetPosition(agentPosition);
 		}
 	}
 }
 
-void AIActor::RequestPathfindingJob(Vec3 startPoint, Vec3 goalPoint)
+float AIActor::GetGroundHeight(Vec3 const& position)
 {
-	if (m_isWaitingForPath || m_currentGame == nullptr || m_currentPath == nullptr) return;
+	// Agents move a fraction of a triangle per frame, so the walk from last frame's triangle is O(1)
+	NavGraph const* navGraph = m_currentMap->m_navGraph;
+	if (navGraph->IsEmpty())
+	{
+		// Streamed maps have no engine mesh, the agent holds its height until the tile under it streams in
+		float height = position.z;
+		if (m_currentMap->m_navTileStreamer != nullptr)
+		{
+			m_currentMap->m_navTileStreamer->TryGetHeight(position, height);
+		}
+		return height;
+	}
 
-	AStarPathfindingJob* job = new AStarPathfindingJob(this, startPoint, goalPoint);
-	g_theJobSystem->QueueJob(job);
-	m_isWaitingForPath = true;
+	m_currentNavTriangle = navGraph->FindNearestTriangleFromHint(position, m_currentNavTriangle);
+	return navGraph->GetHeightOnTriangle(m_currentNavTriangle, position);
 }
 
-void AIActor::AStar(Vec3 startPoint, Vec3 goalPoint, std::vector<Vec3>& outPath)
+Vec3 AIActor::GetRandomReachableGoalPoint(Vec3 const& currentPos)
 {
-	double timeBefore = GetCurrentTimeSeconds();
-	m_currentPath->ComputeAStar(startPoint, goalPoint, outPath);
-	double timeAfter = GetCurrentTimeSeconds();
+	// Only draw from the triangles the agent can actually walk to
+	NavGraph const* navGraph = m_currentMap->m_navGraph;
+	if (navGraph->HasUpToDateComponents())
+	{
+		m_currentNavTriangle = navGraph->FindNearestTriangleFromHint(currentPos, m_currentNavTriangle);
+		int componentIndex = navGraph->GetComponent(m_currentNavTriangle);
+		if (componentIndex != NAV_INVALID_INDEX)
+		{
+			m_goalNavTriangle = navGraph->GetRandomTriangleInComponent(componentIndex, g_rng.SRollRandomFloatInRange(0.f, 1.f), g_rng.SRollRandomFloatInRange(0.f, 1.f));
+			return navGraph->GetPointInTriangle(m_goalNavTriangle, g_rng.SRollRandomFloatInRange(0.f, 1.f), g_rng.SRollRandomFloatInRange(0.f, 1.f));
+		}
+	}
 
-	float msElapsed = 1000.f * float(timeAfter - timeBefore);
-	g_theConsole->AddLine(Rgba8::RED, Stringf("Generated a path of %i steps from triangle %i to triangle %i in %.02f ms", outPath.size(), startPoint, goalPoint, msElapsed));
+	// Streamed graphs have no components, and an agent standing on a blocked triangle has none either
+	return m_currentMap->GetRandomNavPoint();
+}
 
-	size_t pathSizeInBytes = outPath.size() * sizeof(size_t); // Approximate size of one path
-	g_theConsole->AddLine(Rgba8::DARK_ORANGE, Stringf("The approximate size of one path is %zu bytes", pathSizeInBytes));
+void AIActor::RequestPathfindingJob(Vec3 startPoint, Vec3 goalPoint)
+{
+	if (m_isWaitingForPath || m_currentGame == nullptr || m_navPathfinder == nullptr) return;
 
-	m_currentGame->PrintAverageFPS();
+	// An obstacle change lands once no nav job is reading the graph, so nothing new goes out until then
+	m_isWaitingForNavChange = m_currentMap->IsNavChangePending();
+	if (m_isWaitingForNavChange) return;
 
-	if (m_currentGame->m_enablePathVisual)
+	// A goal in another component, or on a blocked triangle, would only come back empty after the
+	// search exhausted everything reachable. Treat it like that empty result right away.
+	NavGraph const* navGraph = m_currentMap->m_navGraph;
+	if (navGraph->HasUpToDateComponents())
 	{
-		if (!outPath.empty())
+		m_currentNavTriangle = navGraph->FindNearestTriangleFromHint(startPoint, m_currentNavTriangle);
+		m_goalNavTriangle = navGraph->FindNearestTriangleFromHint(goalPoint, m_goalNavTriangle);
+		if (!navGraph->IsGoalReachable(m_currentNavTriangle, m_goalNavTriangle))
 		{
-			for (size_t i = 0; i < outPath.size(); i++)
-			{
-				Vec3 point = outPath[i];
-				Rgba8 pointColor = (i == 0) ? Rgba8::RED : (i == outPath.size() - 1 ? Rgba8::GREEN : Rgba8::MAGENTA);
-				DebugAddWorldPoint(point, 0.1f, 8, 2.5f, pointColor, pointColor, DebugRenderMode::ALWAYS);
+			m_aiPath.clear();
+			m_hasReachedGoal = true;          // Trigger new goal generation
+			m_repathTimeRemaining = -1.f;     // Force immediate retry
+			return;
+		}
+	}
 
-				if (i > 0)
-				{
-					Vec3 prevPoint = outPath[i - 1];
-					DebugAddWorldLine(prevPoint, point, 0.1f, 2.5f, Rgba8::BUBBLEGUM_PINK, Rgba8::BUBBLEGUM_PINK, DebugRenderMode::ALWAYS);
-				}
-			}
+	AStarPathfindingJob* job = new AStarPathfindingJob(m_actorUID, m_navPathfinder, startPoint, goalPoint, m_currentMap->m_numNavJobsInFlight);
+	job->m_resultPath.swap(m_spareAiPath);
+	if (m_currentGame->m_gameModeConfig.m_useIncrementalReplanning)
+	{
+		if (m_replanner == nullptr)
+		{
+			m_replanner = std::make_shared<NavDStarLite>();
 		}
+		job->m_replanner = m_replanner;
+	}
+	m_currentMap->m_numNavJobsInFlight++;
+	QueueGameJob(job);
+	m_isWaitingForPath = true;
+}
+
+void AIActor::AStar(NavPathfinder const* pathfinder, NavDStarLite* replanner, Vec3 startPoint, Vec3 goalPoint, std::vector<Vec3>& outPath, bool& out_isWaitingForTiles)
+{
+	// Workers only push a record, the main thread formats, prints and aggregates it in Game::DrainTelemetry
+	TelemetryRecord record;
+	record.m_type = TelemetryRecordType::PATH_QUERY;
+	if (replanner != nullptr)
+	{
+		pathfinder->ComputeIncremental(*replanner, startPoint, goalPoint, outPath, &record.m_queryStats);
+	}
+	else
+	{
+		pathfinder->ComputeAStar(startPoint, goalPoint, outPath, &record.m_queryStats);
 	}
+	record.m_timeSeconds = GetCurrentTimeSeconds();
+	record.m_startPoint = startPoint;
+	record.m_goalPoint = goalPoint;
+	out_isWaitingForTiles = record.m_queryStats.m_isWaitingForTiles;
+	Telemetry::Record(record);
 }
 
-void AStarPathfindingJob::Execute()
+void AStarPathfindingJob::ExecuteGameJob()
 {
-	m_ai->AStar(m_start, m_goal, m_resultPath);
-	m_state = JobStatus::COMPLETED;
+	PROFILE_ZONE("AStarPathfindingJob");
+	AIActor::AStar(m_pathfinder, m_replanner.get(), m_start, m_goal, m_resultPath, m_isWaitingForTiles);
+	m_numNavJobsInFlight--;
 }
@@ -1,9 +1,11 @@
 #pragma once
+#include <memory>
 #include <vector>
 #include "Game/Controller.hpp"
 #include "Game/Game.hpp"
 #include "Game/Map.hpp"
 #include "Game/PlayGround.hpp"
+#include "Game/JobCompletionDispatcher.hpp"
 #include "Engine/Core/JobSystem.hpp"
 #include "Engine/Core/Timer.hpp"
 #include "Engine/AI/ObstacleAvoidance.hpp"
@@ -11,6 +13,9 @@
 constexpr float MAX_ANGLE_BEFORE_MOVEMENT = 5.f; // tweakable: 515 degrees is good range
 constexpr float FOV_DEGREES = 180.f;
 constexpr int NUM_CONE_SEGMENTS = 10;
+constexpr float NAV_TILE_RETRY_SECONDS = 0.1f; // A streamed path waiting on tiles asks again this often for the same goal
+constexpr int NAV_TILE_MAX_RETRIES = 30; // Then the goal is given up like any other unreachable one
+constexpr float FLOW_FIELD_ARRIVAL_RADIUS_SCALE = 4.f; // Crowds settle around the rally point instead of all pushing into it
 
 enum class FOVZone
 {
@@ -30,6 +35,9 @@ struct LineTraceResult
 	Actor*  m_impactedActor         = nullptr;
 };
 
+class NavDStarLite;
+class NavPathfinder;
+
 class AIActor : public Controller
 {
 public:
@@ -40,26 +48,42 @@ public:
 
 	virtual void Update() override;
 
+	// Update split for the parallel agent update. PrepareUpdate touches shared state (goal picking
+	// and path requests) and stays on the main thread. UpdateSteering only writes this
+	// agent and reads neighbors from the AgentStateStore, so it can run from a job.
+	void PrepareUpdate();
+	void UpdateSteering();
+	static void OnPathfindingJobCompleted(GameJob* job, Actor* requester);
+
 	// ORCA helper functions for decision making 
 	FOVZone GetFOVZone(Vec3 const& selfPosition, Vec3 const& fwdDir, Vec3 const& otherPosition);
 	void AgentFOV(Vec3 const& originPos, Vec3 const& forwardDir, float angleRadius);
+	bool CanSteeringDebugDraw(bool isVisualEnabled) const;
 
 	void ApplyFinalMovement(Vec3 const& finalDirection, float maxTurnAngle, float maxAngleBeforeApplyingMovement);
 
 	// Obstacle velocity 
 	void CurrentObstacleMode();
-	void GetNearbyAgentsOnTheMap(std::vector<Actor*>& agents, const Vec3& position, float radius);
-	void GetNearbyAgentsOnThePlayGround(std::vector<Actor*>& agents, const Vec3& position, float radius);
+	void GetNearbyAgentsOnTheMap(std::vector<int>& agentSlots, const Vec3& position, float radius);
+	void GetNearbyAgentsOnThePlayGround(std::vector<int>& agentSlots, const Vec3& position, float radius);
+
+	// ORCA input read from the owner's AgentStateStore
+	AgentStateStore& GetAgentStates() const;
+	void SwapWithMovingNeighbor(std::vector<int> const& nearbyAgentSlots);
+	void BuildNearbyAIAgents(std::vector<int> const& nearbyAgentSlots, std::vector<AIAgent*>& nearbyAI);
 	
 	// Path construction and movement along path update
 	void AiTraversalUpdate(Vec3 currentPos);
+	void FlowFieldTraversalUpdate(Vec3 currentPos);
 	void MoveAlongPathUpdate();
-	void AgentPrioritization(std::vector<Actor*>& nearbyAgents, std::vector<AIAgent*>& nearbyAI);
+	void AgentPrioritization(std::vector<int>& nearbyAgentSlots, std::vector<AIAgent*>& nearbyAI);
 	void HeighDeviationCheck();
+	float GetGroundHeight(Vec3 const& position);
 
 	// A-Star
+	Vec3 GetRandomReachableGoalPoint(Vec3 const& currentPos);
 	void RequestPathfindingJob(Vec3 startPoint, Vec3 goalPoint);
-	void AStar(Vec3 startPoint, Vec3 goalPoint, std::vector<Vec3>& outPath);
+	static void AStar(NavPathfinder const* pathfinder, NavDStarLite* replanner, Vec3 startPoint, Vec3 goalPoint, std::vector<Vec3>& outPath, bool& out_isWaitingForTiles);
 
 public:
 	Game* m_currentGame = nullptr;
@@ -67,6 +91,8 @@ public:
 	PlayGround* m_currentPlayGround = nullptr;
 	NavMesh* m_currentNavMesh = nullptr;
 	NavMeshPathfinding* m_currentPath = nullptr;
+	NavPathfinder* m_navPathfinder = nullptr;
+	std::shared_ptr<NavDStarLite> m_replanner; // Shared with the in-flight path job so despawning mid-search is safe
 	ObstacleAvoidnace* m_obstacleAvoidance = nullptr;
 	std::vector<Actor*> m_visibleActorsInLOS;
 
@@ -82,9 +108,20 @@ public:
 
  	bool m_hasReachedGoal = true;
  	Vec3 m_goalPoint = Vec3::ZERO;
+	int m_currentNavTriangle = -1; // Nav graph triangle the agent was last found in, the hint for the next lookup
+	int m_goalNavTriangle = -1;
+
+	// The last streamed path came back empty only because its tiles were still being built
+	bool m_isWaitingForTiles = false;
+	float m_tileRetryTimeRemaining = 0.f;
+	int m_numTileRetries = 0;
+
+	// The last path request was held back while the map applies an obstacle change
+	bool m_isWaitingForNavChange = false;
 
 public:
 	std::vector<Vec3> m_aiPath;
+	std::vector<Vec3> m_spareAiPath; // Previous path's buffer, handed to the next path job to fill
 	LineTraceResult m_closestResult;
 	ActorUID m_otherActorUID = ActorUID::INVALID;
 	Actor* m_actor = nullptr;
@@ -97,19 +134,22 @@ public:
 	bool m_isWaitingForPath = false; // Tracks if a path request is in progress
 };
 
-class AStarPathfindingJob : public Job 
+class AStarPathfindingJob : public GameJob
 {
 public:
-	AStarPathfindingJob(AIActor* ai, Vec3 start, Vec3 goal)
-		: Job(JobType::AI), m_ai(ai), m_start(start), m_goal(goal) { m_state = JobStatus::NEW; }
+	AStarPathfindingJob(ActorUID requesterUID, NavPathfinder const* pathfinder, Vec3 start, Vec3 goal, std::atomic<int>& numNavJobsInFlight)
+		: GameJob(GameJobType::PATHFINDING, requesterUID), m_pathfinder(pathfinder), m_start(start), m_goal(goal), m_numNavJobsInFlight(numNavJobsInFlight) {}
 
-	virtual void Execute() override;
+	virtual void ExecuteGameJob() override;
 
 	std::vector<Vec3> GetResult() const { return m_resultPath; }
 
 public:
-	AIActor* m_ai;
+	NavPathfinder const* m_pathfinder = nullptr;
 	Vec3 m_start;
 	Vec3 m_goal;
 	std::vector<Vec3> m_resultPath;
+	bool m_isWaitingForTiles = false;
+	std::shared_ptr<NavDStarLite> m_replanner;
+	std::atomic<int>& m_numNavJobsInFlight;
 };
@@ -4,6 +4,7 @@
 #include "Game/ActorDefinitions.hpp"
 #include "Game/Game.hpp"
 #include "Game/Controller.hpp"
+#include "Game/Diagnostics/Profiler.hpp"
 #include "Game/AIActor.hpp"
 #include "Game/Game.hpp"
 #include "Game/Map.hpp"
@@ -27,10 +28,7 @@ Actor::Actor(Map* owner, Game* game, MapSpawnInfo mapSpawnInfo, ActorUID actorUI
 	m_map = owner;
 	m_currentGame = game;
 	m_actorDefName = mapSpawnInfo.m_actorType;
-	m_position = mapSpawnInfo.m_actorPosition;
-	m_previousPosition = m_position;
-	m_orientation = mapSpawnInfo.m_actorOrientation;
-	m_initialDirection = m_orientation.GetForwardVector();
+	m_initialDirection = mapSpawnInfo.m_actorOrientation.GetForwardVector();
 	m_actorDef = ActorDefinition::GetActorDefByName(m_actorDefName);
 
 	if (m_actorDef)
@@ -53,14 +51,19 @@ Actor::Actor(Map* owner, Game* game, MapSpawnInfo mapSpawnInfo, ActorUID actorUI
 
 		if (m_actorDef->m_name.find("Agent") != std::string::npos) // Check if the name contains "Agent"
 		{
-			CreateZAlignedAgent();
-			CreateBuffers();
+			if (!m_currentGame->m_gameModeConfig.m_isHeadless)
+			{
+				CreateZAlignedAgent();
+				CreateBuffers();
+			}
 			m_bodyColor = Rgba8::SLATE_GRAY;
 			m_eyeColor = Rgba8::RED;
 		}
 	}
 
 	m_uid = actorUID;
+	m_agentStates = &m_map->m_agentStates;
+	m_agentStates->AddAgent(GetSlotIndex(), mapSpawnInfo.m_actorPosition, mapSpawnInfo.m_actorOrientation, m_physicsRadius, m_moveSpeed, m_dragForce);
 
 	if (m_isAI)
 	{
@@ -74,10 +77,7 @@ Actor::Actor(PlayGround* owner, Game* game, PlayGroundSpawnInfo playGroundSpawnI
 	m_playGround = owner;
 	m_currentGame = game;
 	m_actorDefName = playGroundSpawnInfo.m_actorType;
-	m_position = playGroundSpawnInfo.m_actorPosition;
-	m_previousPosition = m_position;
-	m_orientation = playGroundSpawnInfo.m_actorOrientation;
-	m_initialDirection = m_orientation.GetForwardVector();
+	m_initialDirection = playGroundSpawnInfo.m_actorOrientation.GetForwardVector();
 	m_actorDef = ActorDefinition::GetActorDefByName(m_actorDefName);
 
 	if (m_actorDef)
@@ -100,14 +100,19 @@ Actor::Actor(PlayGround* owner, Game* game, PlayGroundSpawnInfo playGroundSpawnI
 
 		if (m_actorDef->m_name.find("Agent") != std::string::npos) // Check if the name contains "Agent"
 		{
-			CreateZAlignedAgent();
-			CreateBuffers();
+			if (!m_currentGame->m_gameModeConfig.m_isHeadless)
+			{
+				CreateZAlignedAgent();
+				CreateBuffers();
+			}
 			m_bodyColor = Rgba8::SLATE_GRAY;
 			m_eyeColor = Rgba8::RED;
 		}
 	}
 
 	m_uid = actorUID;
+	m_agentStates = &m_playGround->m_agentStates;
+	m_agentStates->AddAgent(GetSlotIndex(), playGroundSpawnInfo.m_actorPosition, playGroundSpawnInfo.m_actorOrientation, m_physicsRadius, m_moveSpeed, m_dragForce);
 
 	if (m_isAI)
 	{
@@ -118,6 +123,11 @@ Actor::Actor(PlayGround* owner, Game* game, PlayGroundSpawnInfo playGroundSpawnI
 
 Actor::~Actor()
 {
+	if (m_agentStates)
+	{
+		m_agentStates->ClearSlot(GetSlotIndex());
+	}
+
 	SafeDelete(m_bodyVertexBuffer);
 	SafeDelete(m_bodyIndexBuffer);
 
@@ -153,6 +163,13 @@ void Actor::CreateBuffers()
 }
 
 void Actor::Update()
+{
+	m_owningController->Update();
+
+	UpdatePhysiscs();
+}
+
+void Actor::UpdateSearchRadius()
 {
 	if (m_currentGame->m_gameModeConfig.m_useORCA)
 	{
@@ -165,10 +182,7 @@ void Actor::Update()
 	{
 		m_searchRadius = 10.f;
 	}
-
-	m_owningController->Update();
-
-	UpdatePhysiscs();
+	m_agentStates->m_searchRadii[GetSlotIndex()] = m_searchRadius;
 }
 
 void Actor::Render()
@@ -190,8 +204,8 @@ void Actor::Render()
 
 Mat44 Actor::GetModelMatrix() const
 {
-	Mat44 translation = Mat44::CreateTranslation3D(m_position);
-	Mat44 orientation = m_orientation.GetAsMatrix_IFwd_JLeft_KUp();
+	Mat44 translation = Mat44::CreateTranslation3D(GetPosition());
+	Mat44 orientation = GetOrientation().GetAsMatrix_IFwd_JLeft_KUp();
 
 	translation.Append(orientation);
 	return translation;
@@ -217,35 +231,25 @@ AIActor* Actor::GetAiController() const
 	return m_aiController;
 }
 
-void Actor::UpdatePhysiscs()
+AgentStateStore* Actor::GetAgentStateStore() const
 {
-	m_previousPosition = m_position;
-
-	float deltaSeconds = m_currentGame->m_clock->GetDeltaSeconds();
-
-	Vec3 drag = -m_velocity;
-	AddForce(drag);
-
-	// Update velocity 
-	m_velocity += m_acceleration * deltaSeconds * 0.5f;
-
-	// update position
-	m_position += m_velocity * deltaSeconds;
-
-	m_velocity += m_acceleration * deltaSeconds * 0.5f;
+	return m_agentStates;
+}
 
-	// Reset acceleration for next frame
-	m_acceleration = Vec3::ZERO;
+void Actor::UpdatePhysiscs()
+{
+	PROFILE_ZONE("Actor::UpdatePhysiscs");
+	m_agentStates->IntegrateAgent(GetSlotIndex(), m_currentGame->GetDeltaSeconds());
 }
 
 void Actor::AddForce(const Vec3& force)
 {
-	m_acceleration += force * m_dragForce;
+	m_agentStates->m_accelerations[GetSlotIndex()] += force * m_dragForce;
 }
 
 void Actor::AddImpulse(const Vec3& impulse)
 {
-	m_velocity += impulse;
+	m_agentStates->m_velocities[GetSlotIndex()] += impulse;
 }
 
 void Actor::MoveInDirection(Vec3 direction, float speed)
@@ -256,7 +260,8 @@ void Actor::MoveInDirection(Vec3 direction, float speed)
 
 void Actor::TurnInDirection(float goalDegree, float maxAngle)
 {
-	m_orientation.m_yawDegrees = GetTurnedTowardDegrees(m_orientation.m_yawDegrees, goalDegree, maxAngle);
+	EulerAngles& orientation = m_agentStates->m_orientations[GetSlotIndex()];
+	orientation.m_yawDegrees = GetTurnedTowardDegrees(orientation.m_yawDegrees, goalDegree, maxAngle);
 }
 
 void Actor::OnPossessed(Controller* controller)
@@ -276,5 +281,45 @@ void Actor::OnUnPossessed(Controller* controller)
 
 Vec3 Actor::GetActorPosition() const
 {
-	return m_position;
+	return GetPosition();
+}
+
+Vec3 const& Actor::GetPosition() const
+{
+	return m_agentStates->m_positions[GetSlotIndex()];
+}
+
+Vec3 const& Actor::GetPreviousPosition() const
+{
+	return m_agentStates->m_previousPositions[GetSlotIndex()];
+}
+
+Vec3 const& Actor::GetVelocity() const
+{
+	return m_agentStates->m_velocities[GetSlotIndex()];
+}
+
+EulerAngles const& Actor::GetOrientation() const
+{
+	return m_agentStates->m_orientations[GetSlotIndex()];
+}
+
+void Actor::SetPosition(Vec3 const& position)
+{
+	m_agentStates->m_positions[GetSlotIndex()] = position;
+}
+
+void Actor::SetVelocity(Vec3 const& velocity)
+{
+	m_agentStates->m_velocities[GetSlotIndex()] = velocity;
+}
+
+void Actor::SetPreferredVelocity(Vec3 const& preferredVelocity)
+{
+	m_agentStates->m_preferredVelocities[GetSlotIndex()] = preferredVelocity;
+}
+
+AIAgent Actor::MakeAIAgent() const
+{
+	return m_agentStates->MakeAIAgent(GetSlotIndex());
 }
@@ -15,6 +15,7 @@ class PlayGround;
 class Game;
 class Controller;
 class AIActor;
+class AgentStateStore;
 class Timer;
 class Shader;
 class Camera;
@@ -36,6 +37,7 @@ public:
 	void CreateZAlignedAgent();
 	void CreateBuffers();
 	void Update();
+	void UpdateSearchRadius();
 	void Render();
 	Mat44 GetModelMatrix() const;
 
@@ -43,6 +45,7 @@ public:
 	void SetUID(ActorUID uid);
 	Controller* GetController() const;
 	AIActor* GetAiController() const;
+	AgentStateStore* GetAgentStateStore() const;
 
 	// Movement 
 	void UpdatePhysiscs();
@@ -51,26 +54,26 @@ public:
 	void MoveInDirection(Vec3 direction, float speed);
 	void TurnInDirection(float goalDegree, float maxAngle);
 
-	AIAgent m_agent;
-
-	void UpdateAIAgent()
-	{
-		m_agent.m_position = m_position;
-		m_agent.m_velocity = m_velocity;
-		m_agent.m_preferredVelocity = m_preferredVelocity;
-		m_agent.m_orientation = m_orientation;
-		m_agent.m_searchRadius = m_searchRadius;
-		m_agent.m_physicsRadius = m_physicsRadius;
-		m_agent.m_moveSpeed = m_moveSpeed;
-	}
-
 	void OnPossessed(Controller* controller);
 	void OnUnPossessed(Controller* controller);
 
 	Vec3 GetActorPosition() const;
 
+	// Kinematic state lives in the owner's AgentStateStore at this actor's slot
+	Vec3 const& GetPosition() const;
+	Vec3 const& GetPreviousPosition() const;
+	Vec3 const& GetVelocity() const;
+	EulerAngles const& GetOrientation() const;
+	void SetPosition(Vec3 const& position);
+	void SetVelocity(Vec3 const& velocity);
+	void SetPreferredVelocity(Vec3 const& preferredVelocity);
+	AIAgent MakeAIAgent() const;
+
 	std::string GetName() const { return m_uniqueName; }
 
+private:
+	int GetSlotIndex() const { return static_cast<int>(m_uid.GetIndex()); }
+
 public:
 	Map* m_map = nullptr;
 	Game* m_currentGame = nullptr;
@@ -81,15 +84,9 @@ public:
 	
 	ActorUID m_uid;
 	ActorUID m_ownerUID;
+	AgentStateStore* m_agentStates = nullptr;
 
 	Vec3 m_initialDirection = Vec3::ZERO;
-	Vec3 m_acceleration = Vec3::ZERO;
-	Vec3 m_velocity = Vec3::ZERO;
-	Vec3 m_preferredVelocity = Vec3::ZERO;
-	Vec3 m_position = Vec3::ZERO;
-	Vec3 m_previousPosition = Vec3::ZERO;
-	
-	EulerAngles m_orientation = EulerAngles::ZERO;
 	
 	Rgba8 m_bodyColor = Rgba8::WHITE;
 	Rgba8 m_eyeColor = Rgba8::WHITE;
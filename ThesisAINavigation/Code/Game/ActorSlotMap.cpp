@@ -0,0 +1,74 @@
+#include "Game/ActorSlotMap.hpp"
+#include "Game/Actor.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+ActorUID ActorSlotMap::AllocateUID()
+{
+	unsigned int slotIndex = 0;
+	if (!m_freeSlots.empty())
+	{
+		slotIndex = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else
+	{
+		GUARANTEE_OR_DIE(m_slots.size() < MAX_ACTOR_SLOTS, "Ran out of actor slots, ActorUID only has 16 bits of index");
+		slotIndex = static_cast<unsigned int>(m_slots.size());
+		m_slots.emplace_back(nullptr);
+		m_slotSalts.emplace_back(0);
+	}
+
+	return ActorUID(m_slotSalts[slotIndex], slotIndex);
+}
+
+void ActorSlotMap::AssignActor(ActorUID uid, Actor* actor)
+{
+	unsigned int slotIndex = uid.GetIndex();
+	GUARANTEE_OR_DIE(slotIndex < m_slots.size() && m_slotSalts[slotIndex] == uid.GetSalt(), "Assigning an actor to a UID that was not allocated");
+	GUARANTEE_OR_DIE(m_slots[slotIndex] == nullptr, "Actor slot is already occupied");
+
+	m_slots[slotIndex] = actor;
+	m_numActors++;
+}
+
+Actor* ActorSlotMap::RemoveActor(ActorUID uid)
+{
+	if (!IsValid(uid)) return nullptr;
+
+	unsigned int slotIndex = uid.GetIndex();
+	Actor* removedActor = m_slots[slotIndex];
+	m_slots[slotIndex] = nullptr;
+	m_numActors--;
+
+	// Bump the generation so every UID still pointing at this slot goes stale
+	m_slotSalts[slotIndex] = (m_slotSalts[slotIndex] >= MAX_ACTOR_SALT) ? 0 : m_slotSalts[slotIndex] + 1;
+	m_freeSlots.emplace_back(slotIndex);
+
+	return removedActor;
+}
+
+void ActorSlotMap::DeleteAllActors()
+{
+	for (Actor*& actor : m_slots)
+	{
+		delete actor;
+		actor = nullptr;
+	}
+
+	m_slots.clear();
+	m_slotSalts.clear();
+	m_freeSlots.clear();
+	m_numActors = 0;
+}
+
+Actor* ActorSlotMap::GetActor(ActorUID uid) const
+{
+	if (!IsValid(uid)) return nullptr;
+	return m_slots[uid.GetIndex()];
+}
+
+bool ActorSlotMap::IsValid(ActorUID uid) const
+{
+	unsigned int slotIndex = uid.GetIndex();
+	return slotIndex < m_slots.size() && m_slotSalts[slotIndex] == uid.GetSalt() && m_slots[slotIndex] != nullptr;
+}
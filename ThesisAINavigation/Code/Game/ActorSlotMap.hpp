@@ -0,0 +1,39 @@
+#pragma once
+#include "Game/ActorUID.hpp"
+#include <vector>
+
+class Actor;
+
+//------------------------------------------------------------------------------------------------
+// Generational slot map behind Map and PlayGround. The ActorUID index is the slot and the salt is
+// the slot's generation, so lookups are one array read plus a salt compare and freed slots are
+// recycled from a free list. A UID kept past its actor's despawn simply resolves to nullptr.
+class ActorSlotMap
+{
+public:
+	ActorSlotMap() = default;
+	~ActorSlotMap() = default;
+
+	ActorUID AllocateUID();
+	void AssignActor(ActorUID uid, Actor* actor);
+	Actor* RemoveActor(ActorUID uid);
+	void DeleteAllActors();
+
+	Actor* GetActor(ActorUID uid) const;
+	bool IsValid(ActorUID uid) const;
+
+	// Indexed by ActorUID::GetIndex(), free slots are nullptr
+	std::vector<Actor*> const& GetSlots() const { return m_slots; }
+	int GetNumSlots() const { return static_cast<int>(m_slots.size()); }
+	int GetNumActors() const { return m_numActors; }
+	bool IsEmpty() const { return m_numActors == 0; }
+
+	static const unsigned int MAX_ACTOR_SALT = 0x0000fffeu;
+	static const unsigned int MAX_ACTOR_SLOTS = 0x0000ffffu;
+
+private:
+	std::vector<Actor*> m_slots;
+	std::vector<unsigned int> m_slotSalts;
+	std::vector<unsigned int> m_freeSlots;
+	int m_numActors = 0;
+};
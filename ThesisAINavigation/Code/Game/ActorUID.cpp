@@ -22,6 +22,11 @@ unsigned int ActorUID::GetIndex() const
 	return m_data & 0xFFFF;
 }
 
+unsigned int ActorUID::GetSalt() const
+{
+	return m_data >> 16;
+}
+
 bool ActorUID::operator==(const ActorUID& other) const
 {
 	return m_data == other.m_data;
@@ -8,6 +8,7 @@ public:
 
 	bool IsValid() const;
 	unsigned int GetIndex() const;
+	unsigned int GetSalt() const;
 	bool operator==(const ActorUID& other) const;
 	bool operator!=(const ActorUID& other) const;
 
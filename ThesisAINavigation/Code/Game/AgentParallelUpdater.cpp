@@ -0,0 +1,80 @@
+#include "Game/AgentParallelUpdater.hpp"
+#include "Game/Actor.hpp"
+#include "Game/AIActor.hpp"
+#include "Game/Controller.hpp"
+#include "Game/Diagnostics/Profiler.hpp"
+#include <thread>
+
+namespace
+{
+	// Only written by the main thread, before the batches are queued and after they are all done
+	bool s_isSteeringInParallel = false;
+}
+
+bool AgentParallelUpdater::IsSteeringInParallel()
+{
+	return s_isSteeringInParallel;
+}
+
+void AgentParallelUpdater::UpdateAgents(std::vector<Actor*> const& agentSlots)
+{
+	int numSlots = static_cast<int>(agentSlots.size());
+
+	// Anything that touches shared state runs serially first: goal picking and path requests, plus
+	// any agent that is not driven by its own AI controller
+	for (Actor* agent : agentSlots)
+	{
+		if (agent == nullptr) continue;
+
+		if (agent->m_aiController && agent->m_owningController == agent->m_aiController)
+		{
+			agent->m_aiController->PrepareUpdate();
+		}
+		else if (agent->m_owningController)
+		{
+			agent->m_owningController->Update();
+		}
+	}
+
+	// Phase one: steering in batches, the main thread takes the last batch itself
+	int firstSlot = 0;
+	s_isSteeringInParallel = (numSlots > AGENTS_PER_STEERING_JOB);
+	for (; firstSlot + AGENTS_PER_STEERING_JOB < numSlots; firstSlot += AGENTS_PER_STEERING_JOB)
+	{
+		m_numPendingSteeringJobs++;
+		QueueGameJob(new AgentSteeringJob(agentSlots, firstSlot, firstSlot + AGENTS_PER_STEERING_JOB, m_numPendingSteeringJobs));
+	}
+	AgentSteeringJob::SteerAgents(agentSlots, firstSlot, numSlots);
+
+	while (m_numPendingSteeringJobs > 0)
+	{
+		std::this_thread::yield();
+	}
+	s_isSteeringInParallel = false;
+
+	// Phase two: integrate everyone from the velocities chosen above
+	for (Actor* agent : agentSlots)
+	{
+		if (agent == nullptr) continue;
+		agent->UpdatePhysiscs();
+	}
+}
+
+void AgentSteeringJob::ExecuteGameJob()
+{
+	PROFILE_ZONE("AgentSteeringJob");
+	SteerAgents(m_agentSlots, m_firstSlot, m_lastSlot);
+	m_numPendingJobs--;
+}
+
+void AgentSteeringJob::SteerAgents(std::vector<Actor*> const& agentSlots, int firstSlot, int lastSlot)
+{
+	for (int slotIndex = firstSlot; slotIndex < lastSlot; slotIndex++)
+	{
+		Actor* agent = agentSlots[slotIndex];
+		if (agent == nullptr || agent->m_aiController == nullptr) continue;
+		if (agent->m_owningController != agent->m_aiController) continue;
+
+		agent->m_aiController->UpdateSteering();
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "Game/JobCompletionDispatcher.hpp"
+#include <atomic>
+#include <vector>
+
+class Actor;
+
+constexpr int AGENTS_PER_STEERING_JOB = 32;
+
+//------------------------------------------------------------------------------------------------
+// Two phase agent update. Phase one runs every AI controller's steering in batched jobs against the
+// AgentStateStore snapshot taken at the start of the frame, phase two integrates every agent.
+// Nobody moves until everyone has steered, so the result does not depend on slot order.
+class AgentParallelUpdater
+{
+public:
+	AgentParallelUpdater() = default;
+	~AgentParallelUpdater() = default;
+
+	void UpdateAgents(std::vector<Actor*> const& agentSlots);
+
+	// True while steering batches are out on worker threads. The DebugRenderer is main thread only,
+	// so the steering visuals stay off for every agent in such a frame, not just the worker batches.
+	static bool IsSteeringInParallel();
+
+private:
+	// Counted down by the jobs themselves, the finished jobs are cleaned up by the job completion stage
+	std::atomic<int> m_numPendingSteeringJobs{ 0 };
+};
+
+//------------------------------------------------------------------------------------------------
+class AgentSteeringJob : public GameJob
+{
+public:
+	AgentSteeringJob(std::vector<Actor*> const& agentSlots, int firstSlot, int lastSlot, std::atomic<int>& numPendingJobs)
+		: GameJob(GameJobType::AGENT_STEERING), m_agentSlots(agentSlots), m_firstSlot(firstSlot), m_lastSlot(lastSlot), m_numPendingJobs(numPendingJobs) {}
+
+	virtual void ExecuteGameJob() override;
+
+	static void SteerAgents(std::vector<Actor*> const& agentSlots, int firstSlot, int lastSlot);
+
+public:
+	std::vector<Actor*> const& m_agentSlots;
+	int m_firstSlot = 0;
+	int m_lastSlot = 0; // Exclusive
+	std::atomic<int>& m_numPendingJobs;
+};
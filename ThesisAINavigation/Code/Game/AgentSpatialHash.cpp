@@ -0,0 +1,112 @@
+#include "Game/AgentSpatialHash.hpp"
+#include "Game/AgentStateStore.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <cmath>
+
+constexpr float MIN_SPATIAL_HASH_CELL_SIZE = 0.5f;
+constexpr int MIN_SPATIAL_HASH_BUCKETS = 64;
+
+void AgentSpatialHash::Rebuild(AgentStateStore const& agentStates)
+{
+	m_agentStates = &agentStates;
+	m_unsortedEntries.clear();
+
+	int numSlots = agentStates.GetNumSlots();
+
+	float maxSearchRadius = 0.f;
+	for (int slotIndex = 0; slotIndex < numSlots; slotIndex++)
+	{
+		if (!agentStates.IsActive(slotIndex)) continue;
+		maxSearchRadius = GetMax(maxSearchRadius, agentStates.m_searchRadii[slotIndex]);
+	}
+
+	m_cellSize = GetMax(maxSearchRadius, MIN_SPATIAL_HASH_CELL_SIZE);
+	m_inverseCellSize = 1.f / m_cellSize;
+
+	// Power of two table with roughly two buckets per agent keeps collisions rare
+	int numBuckets = MIN_SPATIAL_HASH_BUCKETS;
+	while (numBuckets < numSlots * 2)
+	{
+		numBuckets <<= 1;
+	}
+	m_numBuckets = numBuckets;
+	m_bucketStarts.assign(m_numBuckets + 1, 0);
+
+	for (int slotIndex = 0; slotIndex < numSlots; slotIndex++)
+	{
+		if (!agentStates.IsActive(slotIndex)) continue;
+
+		Vec3 const& agentPosition = agentStates.m_snapshotPositions[slotIndex];
+
+		Entry entry;
+		entry.m_slotIndex = slotIndex;
+		entry.m_cellX = GetCellCoord(agentPosition.x);
+		entry.m_cellY = GetCellCoord(agentPosition.y);
+		m_unsortedEntries.emplace_back(entry);
+
+		m_bucketStarts[GetBucketIndex(entry.m_cellX, entry.m_cellY)]++;
+	}
+
+	// Inclusive prefix sum leaves each bucket's end offset in place
+	for (int bucketIndex = 1; bucketIndex <= m_numBuckets; bucketIndex++)
+	{
+		m_bucketStarts[bucketIndex] += m_bucketStarts[bucketIndex - 1];
+	}
+
+	// Scatter by walking every end offset back, which leaves the start offsets behind
+	m_entries.resize(m_unsortedEntries.size());
+	for (Entry const& entry : m_unsortedEntries)
+	{
+		int bucketIndex = GetBucketIndex(entry.m_cellX, entry.m_cellY);
+		m_entries[--m_bucketStarts[bucketIndex]] = entry;
+	}
+}
+
+void AgentSpatialHash::GetAgentsInRadius(Vec3 const& position, float radius, std::vector<int>& out_agentSlots, int slotToIgnore) const
+{
+	if (m_entries.empty() || m_agentStates == nullptr) return;
+
+	std::vector<Vec3> const& positions = m_agentStates->m_snapshotPositions;
+
+	float radiusSq = radius * radius;
+
+	int minCellX = GetCellCoord(position.x - radius);
+	int maxCellX = GetCellCoord(position.x + radius);
+	int minCellY = GetCellCoord(position.y - radius);
+	int maxCellY = GetCellCoord(position.y + radius);
+
+	for (int cellY = minCellY; cellY <= maxCellY; cellY++)
+	{
+		for (int cellX = minCellX; cellX <= maxCellX; cellX++)
+		{
+			int bucketIndex = GetBucketIndex(cellX, cellY);
+			for (int entryIndex = m_bucketStarts[bucketIndex]; entryIndex < m_bucketStarts[bucketIndex + 1]; entryIndex++)
+			{
+				Entry const& entry = m_entries[entryIndex];
+
+				// Different cells can share a bucket, only take the agents that really live in this cell
+				if (entry.m_cellX != cellX || entry.m_cellY != cellY) continue;
+				if (entry.m_slotIndex == slotToIgnore) continue;
+
+				// Agents despawned since the rebuild are skipped
+				if (!m_agentStates->IsActive(entry.m_slotIndex)) continue;
+
+				if (GetDistanceSquared3D(position, positions[entry.m_slotIndex]) <= radiusSq)
+				{
+					out_agentSlots.emplace_back(entry.m_slotIndex);
+				}
+			}
+		}
+	}
+}
+
+int AgentSpatialHash::GetCellCoord(float worldCoord) const
+{
+	return static_cast<int>(floorf(worldCoord * m_inverseCellSize));
+}
+
+int AgentSpatialHash::GetBucketIndex(int cellX, int cellY) const
+{
+	unsigned int hash = (static_cast<unsigned int>(cellX) * 92837111u) ^ (static_cast<unsigned int>(cellY) * 689287499u);
+	return static_cast<int>(hash & static_cast<unsigned int>(m_numBuckets - 1));
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "Engine/Math/Vec3.hpp"
+#include <vector>
+
+class AgentStateStore;
+
+//------------------------------------------------------------------------------------------------
+// Uniform XY grid hashed into a flat table and rebuilt once per frame with a counting sort.
+// Cells are sized to the largest agent search radius, so a radius query touches at most 3x3 cells.
+// Entries are agent slot indices and distance tests read the AgentStateStore snapshot positions.
+class AgentSpatialHash
+{
+public:
+	AgentSpatialHash() = default;
+	~AgentSpatialHash() = default;
+
+	void Rebuild(AgentStateStore const& agentStates);
+	void GetAgentsInRadius(Vec3 const& position, float radius, std::vector<int>& out_agentSlots, int slotToIgnore = -1) const;
+
+	float GetCellSize() const { return m_cellSize; }
+	int GetNumAgents() const { return static_cast<int>(m_entries.size()); }
+
+private:
+	struct Entry
+	{
+		int m_slotIndex = -1;
+		int m_cellX = 0;
+		int m_cellY = 0;
+	};
+
+	int GetCellCoord(float worldCoord) const;
+	int GetBucketIndex(int cellX, int cellY) const;
+
+private:
+	AgentStateStore const* m_agentStates = nullptr;
+	float m_cellSize = 1.f;
+	float m_inverseCellSize = 1.f;
+	int m_numBuckets = 0;
+
+	std::vector<int> m_bucketStarts;	// m_numBuckets + 1 offsets into m_entries
+	std::vector<Entry> m_entries;		// Agents sorted by bucket
+	std::vector<Entry> m_unsortedEntries;
+};
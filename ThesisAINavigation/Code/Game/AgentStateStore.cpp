@@ -0,0 +1,115 @@
+#include "Game/AgentStateStore.hpp"
+
+void AgentStateStore::AddAgent(int slotIndex, Vec3 const& position, EulerAngles const& orientation, float physicsRadius, float moveSpeed, float dragForce)
+{
+	if (slotIndex >= GetNumSlots())
+	{
+		Resize(slotIndex + 1);
+	}
+
+	m_positions[slotIndex] = position;
+	m_previousPositions[slotIndex] = position;
+	m_velocities[slotIndex] = Vec3::ZERO;
+	m_preferredVelocities[slotIndex] = Vec3::ZERO;
+	m_accelerations[slotIndex] = Vec3::ZERO;
+	m_orientations[slotIndex] = orientation;
+	m_physicsRadii[slotIndex] = physicsRadius;
+	m_searchRadii[slotIndex] = 0.f;
+	m_moveSpeeds[slotIndex] = moveSpeed;
+	m_dragForces[slotIndex] = dragForce;
+	m_isActive[slotIndex] = 1;
+
+	m_snapshotPositions[slotIndex] = position;
+	RefreshAIAgent(slotIndex);
+}
+
+void AgentStateStore::ClearSlot(int slotIndex)
+{
+	if (slotIndex < 0 || slotIndex >= GetNumSlots()) return;
+	m_isActive[slotIndex] = 0;
+}
+
+void AgentStateStore::Clear()
+{
+	m_positions.clear();
+	m_previousPositions.clear();
+	m_velocities.clear();
+	m_preferredVelocities.clear();
+	m_accelerations.clear();
+	m_orientations.clear();
+	m_physicsRadii.clear();
+	m_searchRadii.clear();
+	m_moveSpeeds.clear();
+	m_dragForces.clear();
+	m_isActive.clear();
+	m_snapshotPositions.clear();
+	m_aiAgents.clear();
+}
+
+void AgentStateStore::TakeSnapshot()
+{
+	m_snapshotPositions = m_positions;
+
+	for (int slotIndex = 0; slotIndex < GetNumSlots(); slotIndex++)
+	{
+		if (!IsActive(slotIndex)) continue;
+		RefreshAIAgent(slotIndex);
+	}
+}
+
+void AgentStateStore::IntegrateAgent(int slotIndex, float deltaSeconds)
+{
+	Vec3& position = m_positions[slotIndex];
+	Vec3& velocity = m_velocities[slotIndex];
+	Vec3& acceleration = m_accelerations[slotIndex];
+
+	m_previousPositions[slotIndex] = position;
+
+	// Drag, same as Actor::AddForce(-velocity)
+	acceleration += -velocity * m_dragForces[slotIndex];
+
+	// Half step velocity, full step position, half step velocity
+	velocity += acceleration * deltaSeconds * 0.5f;
+	position += velocity * deltaSeconds;
+	velocity += acceleration * deltaSeconds * 0.5f;
+
+	// Reset acceleration for next frame
+	acceleration = Vec3::ZERO;
+}
+
+AIAgent AgentStateStore::MakeAIAgent(int slotIndex) const
+{
+	AIAgent agent;
+	agent.m_position = m_positions[slotIndex];
+	agent.m_velocity = m_velocities[slotIndex];
+	agent.m_preferredVelocity = m_preferredVelocities[slotIndex];
+	agent.m_orientation = m_orientations[slotIndex];
+	agent.m_searchRadius = m_searchRadii[slotIndex];
+	agent.m_physicsRadius = m_physicsRadii[slotIndex];
+	agent.m_moveSpeed = m_moveSpeeds[slotIndex];
+	return agent;
+}
+
+void AgentStateStore::Resize(int numSlots)
+{
+	if (numSlots <= GetNumSlots()) return;
+
+	m_positions.resize(numSlots, Vec3::ZERO);
+	m_previousPositions.resize(numSlots, Vec3::ZERO);
+	m_velocities.resize(numSlots, Vec3::ZERO);
+	m_preferredVelocities.resize(numSlots, Vec3::ZERO);
+	m_accelerations.resize(numSlots, Vec3::ZERO);
+	m_orientations.resize(numSlots, EulerAngles::ZERO);
+	m_physicsRadii.resize(numSlots, 0.f);
+	m_searchRadii.resize(numSlots, 0.f);
+	m_moveSpeeds.resize(numSlots, 0.f);
+	m_dragForces.resize(numSlots, 0.f);
+	m_isActive.resize(numSlots, 0);
+	m_snapshotPositions.resize(numSlots, Vec3::ZERO);
+	m_aiAgents.resize(numSlots);
+}
+
+void AgentStateStore::RefreshAIAgent(int slotIndex)
+{
+	m_aiAgents[slotIndex] = MakeAIAgent(slotIndex);
+}
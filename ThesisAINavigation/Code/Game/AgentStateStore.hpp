@@ -0,0 +1,55 @@
+#pragma once
+#include "Engine/AI/ObstacleAvoidance.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include <vector>
+
+//------------------------------------------------------------------------------------------------
+// Kinematic state of every agent in contiguous arrays, indexed by ActorUID::GetIndex() so it lines
+// up with ActorSlotMap. The store is the only copy: Actor reads and writes its slot through
+// accessors, and integration runs in place. Neighbor queries read a snapshot taken once per frame
+// before anyone steers, so agents can write their own slot while others read theirs.
+class AgentStateStore
+{
+public:
+	AgentStateStore() = default;
+	~AgentStateStore() = default;
+
+	void AddAgent(int slotIndex, Vec3 const& position, EulerAngles const& orientation, float physicsRadius, float moveSpeed, float dragForce);
+	void ClearSlot(int slotIndex);
+	void Clear();
+
+	void TakeSnapshot();
+	void IntegrateAgent(int slotIndex, float deltaSeconds);
+
+	// ORCA input for the steering agent, built from its live slot
+	AIAgent MakeAIAgent(int slotIndex) const;
+
+	// Neighbor state as of the last snapshot
+	AIAgent* GetAIAgent(int slotIndex) { return &m_aiAgents[slotIndex]; }
+
+	bool IsActive(int slotIndex) const { return m_isActive[slotIndex] != 0; }
+	int GetNumSlots() const { return static_cast<int>(m_isActive.size()); }
+
+private:
+	void Resize(int numSlots);
+	void RefreshAIAgent(int slotIndex);
+
+public:
+	std::vector<Vec3> m_positions;
+	std::vector<Vec3> m_previousPositions;
+	std::vector<Vec3> m_velocities;
+	std::vector<Vec3> m_preferredVelocities;
+	std::vector<Vec3> m_accelerations;
+	std::vector<EulerAngles> m_orientations;
+	std::vector<float> m_physicsRadii;
+	std::vector<float> m_searchRadii;
+	std::vector<float> m_moveSpeeds;
+	std::vector<float> m_dragForces;
+	std::vector<unsigned char> m_isActive;
+
+	std::vector<Vec3> m_snapshotPositions;
+
+private:
+	std::vector<AIAgent> m_aiAgents;
+};
@@ -1,4 +1,5 @@
 #include "Game/App.hpp"
+#include "Game/Diagnostics/Profiler.hpp"
 #include "Game/Game.hpp"
 #include "Game/GameModes/NavigationMode.hpp"
 #include "Game/GameModes/ObstacleAvoidanceMode.hpp"
@@ -88,6 +89,7 @@ bool App::Command_DisplayGameModes([[maybe_unused]] EventArgs& args)
 
 void App::Startup()
 {
+	Profiler::SetCurrentThreadName("Main");
 	LoadGameData();
 
 	JobSystemConfig jobSystemConfig;
@@ -124,14 +126,7 @@ void App::Startup()
 	DebugRenderConfig debugConfig;
 	debugConfig.m_renderer = g_theRenderer;
 
-	GameModeConfig aStarGameSingleConfig;
-	aStarGameSingleConfig.m_useAStar = true;
-	aStarGameSingleConfig.m_terrianDimensions = IntVec2(20, 20);
-	aStarGameSingleConfig.m_groundHeight = 0.3f;
-	aStarGameSingleConfig.m_hillHeight = 0.6f;
-	aStarGameSingleConfig.m_mountainHeight = 1.f;
-	aStarGameSingleConfig.m_numberOfAgents = 1;
-	m_currentGame = new NavigationMode(aStarGameSingleConfig);
+	m_currentGame = new NavigationMode(GetGameModeConfig(GameModeType::ASTAR_SINGLE_AGENT_MODE));
 
 	g_theJobSystem->Startup();
 	g_theEventSystem->StartUp();
@@ -178,6 +173,10 @@ void App::Shutdown()
 
 void App::RunFrame()
 {
+	// Hands last frame's zones to the flame view before this frame's first zone opens
+	Profiler::BeginFrame();
+	PROFILE_ZONE("App::RunFrame");
+
 	BeginFrame();
 
 	if (!m_isPaused)
@@ -247,6 +246,7 @@ void App::ResetCurrentGameMode()
 
 void App::Update()
 {
+	PROFILE_ZONE("App::Update");
 	m_currentGame->UpdateGameMode();
 	if (g_theInput->WasKeyJustPressed('R'))
 	{
@@ -291,7 +291,21 @@ void App::SwitchToNewGameMode(GameModeType newGameModeType)
 
 	m_currentGameModeType = newGameModeType;
 
-	switch (m_currentGameModeType)
+	GameModeConfig gameModeConfig = GetGameModeConfig(m_currentGameModeType);
+	if (gameModeConfig.m_useAStar)
+	{
+		m_currentGame = new NavigationMode(gameModeConfig);
+	}
+	else
+	{
+		m_currentGame = new ObstacleAvoidanceMode(gameModeConfig);
+	}
+	m_currentGame->Startup();
+}
+
+GameModeConfig App::GetGameModeConfig(GameModeType mode)
+{
+	switch (mode)
 	{
 	case GameModeType::ASTAR_SINGLE_AGENT_MODE:
 	{
@@ -302,8 +316,7 @@ void App::SwitchToNewGameMode(GameModeType newGameModeType)
 		aStarGameSingleConfig.m_hillHeight = 0.6f;
 		aStarGameSingleConfig.m_mountainHeight = 1.f;
 		aStarGameSingleConfig.m_numberOfAgents = 1;
-		m_currentGame = new NavigationMode(aStarGameSingleConfig);
-		break;
+		return aStarGameSingleConfig;
 	}
 	case GameModeType::ASTAR_MULTIAGENT_MODE:
 	{
@@ -314,88 +327,77 @@ void App::SwitchToNewGameMode(GameModeType newGameModeType)
 		aStarGameMultiConfig.m_hillHeight = 0.6f;
 		aStarGameMultiConfig.m_mountainHeight = 1.f;
 		aStarGameMultiConfig.m_numberOfAgents = 80;
-		m_currentGame = new NavigationMode(aStarGameMultiConfig);
-		break;
+		return aStarGameMultiConfig;
 	}
 	case GameModeType::VO_TWOAGENTS_MODE:
 	{
 		GameModeConfig voTwoGameConfig;
 		voTwoGameConfig.m_useVO = true;
 		voTwoGameConfig.m_numberOfAgents = 2;
-		m_currentGame = new ObstacleAvoidanceMode(voTwoGameConfig);
-		break;
+		return voTwoGameConfig;
 	}
 	case GameModeType::VO_THREEAGENTS_MODE:
 	{
 		GameModeConfig voThreeGameConfig;
 		voThreeGameConfig.m_useVO = true;
 		voThreeGameConfig.m_numberOfAgents = 3;
-		m_currentGame = new ObstacleAvoidanceMode(voThreeGameConfig);
-		break;
+		return voThreeGameConfig;
 	}
 	case GameModeType::RVO_TWO_AGENTS_MODE:
 	{
 		GameModeConfig rvoTwoGameConfig;
 		rvoTwoGameConfig.m_useRVO = true;
 		rvoTwoGameConfig.m_numberOfAgents = 2;
-		m_currentGame = new ObstacleAvoidanceMode(rvoTwoGameConfig);
-		break;
+		return rvoTwoGameConfig;
 	}
 	case GameModeType::RVO_THREE_AGENTS_MODE:
 	{
 		GameModeConfig rvoThreeGameConfig;
 		rvoThreeGameConfig.m_useRVO = true;
 		rvoThreeGameConfig.m_numberOfAgents = 3;
-		m_currentGame = new ObstacleAvoidanceMode(rvoThreeGameConfig);
-		break;
+		return rvoThreeGameConfig;
 	}
 	case GameModeType::HRVO_TWO_AGENTS_MODE:
 	{
 		GameModeConfig hrvoTwoGameConfig;
 		hrvoTwoGameConfig.m_useHRVO = true;
 		hrvoTwoGameConfig.m_numberOfAgents = 2;
-		m_currentGame = new ObstacleAvoidanceMode(hrvoTwoGameConfig);
-		break;
+		return hrvoTwoGameConfig;
 	}
 	case GameModeType::HRVO_THREE_AGENTS_MODE:
 	{
 		GameModeConfig hrvoThreeGameConfig;
 		hrvoThreeGameConfig.m_useHRVO = true;
 		hrvoThreeGameConfig.m_numberOfAgents = 3;
-		m_currentGame = new ObstacleAvoidanceMode(hrvoThreeGameConfig);
-		break;
+		return hrvoThreeGameConfig;
 	}
 	case GameModeType::ORCA_TWO_AGENTS_MODE:
 	{
 		GameModeConfig orcaTwoGameConfig;
 		orcaTwoGameConfig.m_useORCA = true;
 		orcaTwoGameConfig.m_numberOfAgents = 2;
-		m_currentGame = new ObstacleAvoidanceMode(orcaTwoGameConfig);
-		break;
+		return orcaTwoGameConfig;
 	}
 	case GameModeType::ORCA_THREE_AGENTS_MODE:
 	{
 		GameModeConfig orcaThreeGameConfig;
 		orcaThreeGameConfig.m_useORCA = true;
 		orcaThreeGameConfig.m_numberOfAgents = 3;
-		m_currentGame = new ObstacleAvoidanceMode(orcaThreeGameConfig);
-		break;
+		return orcaThreeGameConfig;
 	}
 	case GameModeType::ORCA_LARGESCALE_MULTIAGENT_MODE:
 	{
 		GameModeConfig orcaLargeScaleGameConfig;
 		orcaLargeScaleGameConfig.m_useORCA = true;
 		orcaLargeScaleGameConfig.m_numberOfAgents = 10; 
-		m_currentGame = new ObstacleAvoidanceMode(orcaLargeScaleGameConfig);
-		break;
+		return orcaLargeScaleGameConfig;
 	}
 	case GameModeType::ORCA_BOTTLENECK_MODE:
 	{
 		GameModeConfig orcaBottleNeckGameConfig;
 		orcaBottleNeckGameConfig.m_useORCA = true;
 		orcaBottleNeckGameConfig.m_numberOfAgents = 20;
-		m_currentGame = new ObstacleAvoidanceMode(orcaBottleNeckGameConfig);
-		break;
+		return orcaBottleNeckGameConfig;
 	}
 	case GameModeType::ASTAR_ORCA_MINI_AGENT_MODE:
 	{
@@ -407,8 +409,7 @@ void App::SwitchToNewGameMode(GameModeType newGameModeType)
 		astarORCATwoGameConfig.m_hillHeight = 0.6f;
 		astarORCATwoGameConfig.m_mountainHeight = 1.f;
 		astarORCATwoGameConfig.m_numberOfAgents = 15;
-		m_currentGame = new NavigationMode(astarORCATwoGameConfig);
-		break;
+		return astarORCATwoGameConfig;
 	}
 	case GameModeType::ASTAR_ORCA_MULTIAGENT_MODE: 
 	{
@@ -420,11 +421,27 @@ void App::SwitchToNewGameMode(GameModeType newGameModeType)
 		astarORCAMultiGameConfig.m_hillHeight = 0.6f;
 		astarORCAMultiGameConfig.m_mountainHeight = 1.f;
 		astarORCAMultiGameConfig.m_numberOfAgents = 75;
-		m_currentGame = new NavigationMode(astarORCAMultiGameConfig);
-		break;
+		return astarORCAMultiGameConfig;
+	}
+	case GameModeType::FLOWFIELD_CROWD_MODE:
+	{
+		GameModeConfig flowFieldCrowdGameConfig;
+		flowFieldCrowdGameConfig.m_useAStar = true;
+		flowFieldCrowdGameConfig.m_useORCA = true;
+		flowFieldCrowdGameConfig.m_useFlowField = true;
+		flowFieldCrowdGameConfig.m_useParallelAgentUpdate = true;
+		flowFieldCrowdGameConfig.m_terrianDimensions = IntVec2(150, 150);
+		flowFieldCrowdGameConfig.m_groundHeight = 0.3f;
+		flowFieldCrowdGameConfig.m_hillHeight = 0.6f;
+		flowFieldCrowdGameConfig.m_mountainHeight = 1.f;
+		flowFieldCrowdGameConfig.m_numberOfAgents = 2000;
+		return flowFieldCrowdGameConfig;
+	}
+	default:
+	{
+		return GameModeConfig();
 	}
 	}
-	m_currentGame->Startup();
 }
 
 std::string App::GetGameModeNameByString(GameModeType mode)
@@ -445,6 +462,7 @@ std::string App::GetGameModeNameByString(GameModeType mode)
 	case GameModeType::ORCA_BOTTLENECK_MODE:            return "ORCA_BOTTLENECK_MODE";
 	case GameModeType::ASTAR_ORCA_MINI_AGENT_MODE:       return "ASTAR_ORCA_MINI_AGENT_MODE";
 	case GameModeType::ASTAR_ORCA_MULTIAGENT_MODE:      return "ASTAR_ORCA_MULTIAGENT_MODE";
+	case GameModeType::FLOWFIELD_CROWD_MODE:            return "FLOWFIELD_CROWD_MODE";
 	default:                                            return "Unknown Mode";
 	}
 }
@@ -461,6 +479,7 @@ void App::DisplayAllGameModes()
 
 void App::Render()
 {
+	PROFILE_ZONE("App::Render");
 	g_theRenderer->ClearScreen(Rgba8::LIGHT_GRAY);
 	m_currentGame->Render();
 	g_theConsole->Render(AABB2(Vec2(0.25f, 0.f), Vec2((float)g_theWindow->GetClientDimensions().x, (float)g_theWindow->GetClientDimensions().y)), g_theRenderer);
@@ -468,6 +487,7 @@ void App::Render()
 
 void App::EndFrame()
 {
+	PROFILE_ZONE("App::EndFrame");
 	DebugRenderEndFrame();
 	g_theJobSystem->EndFrame();
 	g_theEventSystem->EndFrame();
@@ -5,6 +5,7 @@
 
 class Game;
 class Clock;
+struct GameModeConfig;
 
 enum class GameModeType
 {
@@ -28,6 +29,8 @@ enum class GameModeType
 	ASTAR_ORCA_MINI_AGENT_MODE,
 	ASTAR_ORCA_MULTIAGENT_MODE,
 
+	FLOWFIELD_CROWD_MODE, // Thousands of agents sharing one goal
+
 	NUM_GAME_MODES
 };
 
@@ -59,6 +62,7 @@ public:
 	static bool Command_DisplayGameModes(EventArgs& args);
 
 	static std::string GetGameModeNameByString(GameModeType mode);
+	static GameModeConfig GetGameModeConfig(GameModeType mode);
 
 private:
 	void BeginFrame();
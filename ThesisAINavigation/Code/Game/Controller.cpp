@@ -4,6 +4,7 @@
 #include "Game/App.hpp"
 #include "Game/PlayerActor.hpp"
 #include "Game/Map.hpp"
+#include "Game/PlayGround.hpp"
 
 void Controller::Possess(Actor* newActor)
 {
@@ -30,6 +31,15 @@ Actor* Controller::GetActor() const
 		return nullptr;
 	}
 
-	Actor* currentPossessedActor = g_theApp->m_currentGame->m_map->GetActorByUID(m_actorUID);
-	return currentPossessedActor;
+	// Headless runs have no App, so prefer the game this controller was created for
+	Game* game = m_game ? m_game : g_theApp->m_currentGame;
+	if (game->m_map)
+	{
+		return game->m_map->GetActorByUID(m_actorUID);
+	}
+	else if (game->m_playGround)
+	{
+		return game->m_playGround->GetActorByUID(m_actorUID);
+	}
+	return nullptr;
 }
\ No newline at end of file
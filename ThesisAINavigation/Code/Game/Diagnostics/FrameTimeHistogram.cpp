@@ -0,0 +1,197 @@
+#include "Game/Diagnostics/FrameTimeHistogram.hpp"
+#include <cstdio>
+
+FrameTimeHistogram::FrameTimeHistogram()
+{
+	m_bucketCounts.assign(FRAME_TIME_NUM_BUCKETS, 0);
+}
+
+void FrameTimeHistogram::Record(double seconds)
+{
+	double microseconds = (seconds > 0.0) ? (seconds * 1000000.0) + 0.5 : 0.0;
+	m_bucketCounts[GetBucketIndex(static_cast<unsigned long long>(microseconds))]++;
+	m_count++;
+	m_totalSeconds += seconds;
+}
+
+void FrameTimeHistogram::RecordValue(unsigned long long value)
+{
+	m_bucketCounts[GetBucketIndex(value)]++;
+	m_count++;
+	m_totalSeconds += static_cast<double>(value) / 1000000.0;
+}
+
+void FrameTimeHistogram::Add(FrameTimeHistogram const& other)
+{
+	for (int bucketIndex = 0; bucketIndex < FRAME_TIME_NUM_BUCKETS; bucketIndex++)
+	{
+		m_bucketCounts[bucketIndex] += other.m_bucketCounts[bucketIndex];
+	}
+	m_count += other.m_count;
+	m_totalSeconds += other.m_totalSeconds;
+}
+
+void FrameTimeHistogram::Subtract(FrameTimeHistogram const& other)
+{
+	for (int bucketIndex = 0; bucketIndex < FRAME_TIME_NUM_BUCKETS; bucketIndex++)
+	{
+		m_bucketCounts[bucketIndex] -= other.m_bucketCounts[bucketIndex];
+	}
+	m_count -= other.m_count;
+	m_totalSeconds -= other.m_totalSeconds;
+}
+
+void FrameTimeHistogram::Clear()
+{
+	m_bucketCounts.assign(FRAME_TIME_NUM_BUCKETS, 0);
+	m_count = 0;
+	m_totalSeconds = 0.0;
+}
+
+double FrameTimeHistogram::GetPercentileSeconds(double percentile) const
+{
+	return static_cast<double>(GetPercentileValue(percentile)) / 1000000.0;
+}
+
+double FrameTimeHistogram::GetMaxSeconds() const
+{
+	return static_cast<double>(GetMaxValue()) / 1000000.0;
+}
+
+double FrameTimeHistogram::GetMeanSeconds() const
+{
+	return (m_count > 0) ? m_totalSeconds / static_cast<double>(m_count) : 0.0;
+}
+
+unsigned long long FrameTimeHistogram::GetPercentileValue(double percentile) const
+{
+	if (m_count == 0) return 0;
+
+	// Rank of the sample at this percentile, counting from 1, so p100 is the last sample and never past it
+	unsigned long long rank = static_cast<unsigned long long>((percentile / 100.0) * static_cast<double>(m_count) + 0.5);
+	if (rank < 1) rank = 1;
+	if (rank > m_count) rank = m_count;
+
+	unsigned long long numSeen = 0;
+	for (int bucketIndex = 0; bucketIndex < FRAME_TIME_NUM_BUCKETS; bucketIndex++)
+	{
+		numSeen += m_bucketCounts[bucketIndex];
+		if (numSeen >= rank)
+		{
+			return GetBucketUpperMicroseconds(bucketIndex);
+		}
+	}
+	return GetBucketUpperMicroseconds(FRAME_TIME_NUM_BUCKETS - 1);
+}
+
+unsigned long long FrameTimeHistogram::GetMaxValue() const
+{
+	for (int bucketIndex = FRAME_TIME_NUM_BUCKETS - 1; bucketIndex >= 0; bucketIndex--)
+	{
+		if (m_bucketCounts[bucketIndex] > 0)
+		{
+			return GetBucketUpperMicroseconds(bucketIndex);
+		}
+	}
+	return 0;
+}
+
+double FrameTimeHistogram::GetMeanValue() const
+{
+	return 1000000.0 * GetMeanSeconds();
+}
+
+int FrameTimeHistogram::GetBucketIndex(unsigned long long microseconds)
+{
+	if (microseconds < FRAME_TIME_LINEAR_BUCKETS) return static_cast<int>(microseconds);
+
+	// Shift the value down until it fits in [SUB_BUCKETS, 2 * SUB_BUCKETS), the shift picks the power of two
+	int shift = 1;
+	while ((microseconds >> shift) >= 2 * FRAME_TIME_SUB_BUCKETS)
+	{
+		shift++;
+	}
+	if (shift > FRAME_TIME_MAX_SHIFT) return FRAME_TIME_NUM_BUCKETS - 1;
+
+	int subBucket = static_cast<int>(microseconds >> shift) - FRAME_TIME_SUB_BUCKETS;
+	return FRAME_TIME_LINEAR_BUCKETS + ((shift - 1) * FRAME_TIME_SUB_BUCKETS) + subBucket;
+}
+
+unsigned long long FrameTimeHistogram::GetBucketUpperMicroseconds(int bucketIndex)
+{
+	if (bucketIndex < FRAME_TIME_LINEAR_BUCKETS) return static_cast<unsigned long long>(bucketIndex);
+
+	int shift = 1 + ((bucketIndex - FRAME_TIME_LINEAR_BUCKETS) / FRAME_TIME_SUB_BUCKETS);
+	int subBucket = (bucketIndex - FRAME_TIME_LINEAR_BUCKETS) % FRAME_TIME_SUB_BUCKETS;
+	unsigned long long lowerMicroseconds = static_cast<unsigned long long>(FRAME_TIME_SUB_BUCKETS + subBucket) << shift;
+	return lowerMicroseconds + (1ull << shift) - 1;
+}
+
+FrameTimeTracker::FrameTimeTracker()
+{
+	m_slices.resize(FRAME_TIME_NUM_SLICES);
+}
+
+void FrameTimeTracker::RecordFrame(double frameSeconds)
+{
+	if (m_currentSliceSeconds >= FRAME_TIME_SLICE_SECONDS)
+	{
+		// Every window drops the slice that just fell off its far end, then the ring slot is reused
+		int nextSlice = (m_currentSlice + 1) % FRAME_TIME_NUM_SLICES;
+		for (int windowIndex = 0; windowIndex < FRAME_TIME_NUM_WINDOWS; windowIndex++)
+		{
+			int expiredSlice = (nextSlice - FRAME_TIME_WINDOW_SLICES[windowIndex] - 1 + FRAME_TIME_NUM_SLICES) % FRAME_TIME_NUM_SLICES;
+			m_windows[windowIndex].Subtract(m_slices[expiredSlice]);
+		}
+		m_slices[nextSlice].Clear();
+		m_currentSlice = nextSlice;
+		m_currentSliceSeconds = 0.0;
+	}
+
+	m_slices[m_currentSlice].Record(frameSeconds);
+	for (FrameTimeHistogram& window : m_windows)
+	{
+		window.Record(frameSeconds);
+	}
+	m_run.Record(frameSeconds);
+	m_runMaxSeconds = (frameSeconds > m_runMaxSeconds) ? frameSeconds : m_runMaxSeconds;
+	m_currentSliceSeconds += frameSeconds;
+}
+
+void FrameTimeTracker::Reset()
+{
+	for (FrameTimeHistogram& slice : m_slices)
+	{
+		slice.Clear();
+	}
+	for (FrameTimeHistogram& window : m_windows)
+	{
+		window.Clear();
+	}
+	m_run.Clear();
+	m_currentSlice = 0;
+	m_currentSliceSeconds = 0.0;
+	m_runMaxSeconds = 0.0;
+}
+
+std::string FrameTimeTracker::GetReport() const
+{
+	std::string report = "=== Frame Time (ms) ===\n";
+	report += "window   frames     p50     p95     p99     max\n";
+
+	char line[128];
+	for (int windowIndex = 0; windowIndex < FRAME_TIME_NUM_WINDOWS; windowIndex++)
+	{
+		FrameTimeHistogram const& window = m_windows[windowIndex];
+		snprintf(line, sizeof(line), "%4is   %7u %7.2f %7.2f %7.2f %7.2f\n", FRAME_TIME_WINDOW_SLICES[windowIndex], window.GetCount(),
+			1000.0 * window.GetPercentileSeconds(50.0), 1000.0 * window.GetPercentileSeconds(95.0),
+			1000.0 * window.GetPercentileSeconds(99.0), 1000.0 * window.GetMaxSeconds());
+		report += line;
+	}
+
+	snprintf(line, sizeof(line), "run     %7u %7.2f %7.2f %7.2f %7.2f\n", m_run.GetCount(),
+		1000.0 * m_run.GetPercentileSeconds(50.0), 1000.0 * m_run.GetPercentileSeconds(95.0),
+		1000.0 * m_run.GetPercentileSeconds(99.0), 1000.0 * m_runMaxSeconds);
+	report += line;
+	return report;
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Values are whole microseconds. Below 64 us every microsecond has its own bucket, above that each
+// power of two is split into 32 linear sub-buckets, so any recorded value is off by at most ~3%.
+constexpr int FRAME_TIME_LINEAR_BUCKETS = 64;
+constexpr int FRAME_TIME_SUB_BUCKETS = 32;
+constexpr int FRAME_TIME_MAX_SHIFT = 21; // Tops out a little above two minutes
+constexpr int FRAME_TIME_NUM_BUCKETS = FRAME_TIME_LINEAR_BUCKETS + (FRAME_TIME_MAX_SHIFT * FRAME_TIME_SUB_BUCKETS);
+
+constexpr double FRAME_TIME_SLICE_SECONDS = 1.0;
+constexpr int FRAME_TIME_NUM_SLICES = 61; // The longest window's full slices plus the one being filled
+constexpr int FRAME_TIME_NUM_WINDOWS = 3;
+constexpr int FRAME_TIME_WINDOW_SLICES[FRAME_TIME_NUM_WINDOWS] = { 1, 10, 60 };
+
+constexpr double FRAME_TIME_BUDGET_SECONDS = 1.0 / 60.0;
+
+//------------------------------------------------------------------------------------------------
+// HDR-style log-bucketed histogram. Recording and percentile queries never sort or allocate, and two
+// histograms add or subtract bucket by bucket, which is what lets the tracker slide its windows.
+class FrameTimeHistogram
+{
+public:
+	FrameTimeHistogram();
+	~FrameTimeHistogram() = default;
+
+	void Record(double seconds);
+	void RecordValue(unsigned long long value); // Any other integer sample, one unit stands in for a microsecond
+	void Add(FrameTimeHistogram const& other);
+	void Subtract(FrameTimeHistogram const& other);
+	void Clear();
+
+	// Upper edge of the bucket that holds the given percentile (0-100), zero when empty
+	double GetPercentileSeconds(double percentile) const;
+	double GetMaxSeconds() const;
+	double GetMeanSeconds() const;
+	unsigned long long GetPercentileValue(double percentile) const;
+	unsigned long long GetMaxValue() const;
+	double GetMeanValue() const;
+	unsigned int GetCount() const { return m_count; }
+	double GetTotalSeconds() const { return m_totalSeconds; }
+
+	static int GetBucketIndex(unsigned long long microseconds);
+	static unsigned long long GetBucketUpperMicroseconds(int bucketIndex);
+
+public:
+	std::vector<unsigned int> m_bucketCounts;
+	unsigned int m_count = 0;
+	double m_totalSeconds = 0.0;
+};
+
+//------------------------------------------------------------------------------------------------
+// Frame times over sliding windows of the last 1, 10 and 60 seconds plus the whole run. Frames land
+// in one-second slices and a window covers its full slices plus the slice being filled, so the 1 s
+// window never drops to a handful of frames right after a rotation. Each window keeps a running
+// histogram that gains every new frame and loses a whole slice when it falls off the far end.
+class FrameTimeTracker
+{
+public:
+	FrameTimeTracker();
+	~FrameTimeTracker() = default;
+
+	void RecordFrame(double frameSeconds);
+	void Reset();
+
+	FrameTimeHistogram const& GetWindow(int windowIndex) const { return m_windows[windowIndex]; }
+	FrameTimeHistogram const& GetRun() const { return m_run; }
+	double GetRunMaxSeconds() const { return m_runMaxSeconds; }
+
+	// p50/p95/p99/max per window and for the run, one line each
+	std::string GetReport() const;
+
+public:
+	std::vector<FrameTimeHistogram> m_slices;
+	int m_currentSlice = 0;
+	double m_currentSliceSeconds = 0.0;
+
+	FrameTimeHistogram m_windows[FRAME_TIME_NUM_WINDOWS];
+	FrameTimeHistogram m_run;
+	double m_runMaxSeconds = 0.0; // Exact, the buckets only know the upper edge
+};
@@ -0,0 +1,192 @@
+#include "Game/Diagnostics/JobStats.hpp"
+#include "Engine/Core/Time.hpp"
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+static GameJobTypeStats s_typeStats[static_cast<int>(GameJobType::NUM_GAME_JOB_TYPES)];
+
+// Worker stats live until exit, like the telemetry rings
+static std::mutex s_workersMutex;
+static std::vector<std::unique_ptr<JobWorkerStats>> s_workers;
+
+// Main thread only
+static double s_windowStartSeconds = 0.0;
+static double s_resetSeconds = 0.0;
+
+static JobWorkerStats& GetWorkerStatsForCurrentThread()
+{
+	thread_local JobWorkerStats* t_workerStats = nullptr;
+	if (t_workerStats == nullptr)
+	{
+		std::lock_guard<std::mutex> lock(s_workersMutex);
+		s_workers.emplace_back(std::make_unique<JobWorkerStats>());
+		t_workerStats = s_workers.back().get();
+	}
+	return *t_workerStats;
+}
+
+int GameJobTypeStats::GetNumWaiting() const
+{
+	// Started is read first, it can only have grown by the time queued is read
+	unsigned int numStarted = m_numStarted.load(std::memory_order_acquire);
+	return static_cast<int>(m_numQueued.load(std::memory_order_acquire) - numStarted);
+}
+
+int GameJobTypeStats::GetNumRunning() const
+{
+	unsigned int numFinished = m_numFinished.load(std::memory_order_acquire);
+	return static_cast<int>(m_numStarted.load(std::memory_order_acquire) - numFinished);
+}
+
+int GameJobTypeStats::GetNumAwaitingRetrieval() const
+{
+	return static_cast<int>(m_numFinished.load(std::memory_order_acquire) - m_numRetrieved);
+}
+
+int GameJobTypeStats::GetNumOutstanding() const
+{
+	return static_cast<int>(m_numQueued.load(std::memory_order_acquire) - m_numRetrieved);
+}
+
+void JobStats::OnQueued(GameJob& job)
+{
+	job.m_queuedSeconds = GetCurrentTimeSeconds();
+	s_typeStats[static_cast<int>(job.m_gameJobType)].m_numQueued.fetch_add(1, std::memory_order_release);
+}
+
+void JobStats::OnStarted(GameJob& job)
+{
+	job.m_startedSeconds = GetCurrentTimeSeconds();
+	s_typeStats[static_cast<int>(job.m_gameJobType)].m_numStarted.fetch_add(1, std::memory_order_release);
+}
+
+void JobStats::OnFinished(GameJob& job)
+{
+	job.m_finishedSeconds = GetCurrentTimeSeconds();
+	s_typeStats[static_cast<int>(job.m_gameJobType)].m_numFinished.fetch_add(1, std::memory_order_release);
+
+	// Only this thread ever adds to its own stats, the main thread just reads them
+	JobWorkerStats& workerStats = GetWorkerStatsForCurrentThread();
+	unsigned long long busyMicroseconds = static_cast<unsigned long long>(1000000.0 * (job.m_finishedSeconds - job.m_startedSeconds));
+	workerStats.m_busyMicroseconds.fetch_add(busyMicroseconds, std::memory_order_relaxed);
+	workerStats.m_numJobs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void JobStats::OnRetrieved(GameJob const& job)
+{
+	GameJobTypeStats& typeStats = s_typeStats[static_cast<int>(job.m_gameJobType)];
+	typeStats.m_numRetrieved++;
+	typeStats.m_waitHistogram.Record(job.m_startedSeconds - job.m_queuedSeconds);
+	typeStats.m_runHistogram.Record(job.m_finishedSeconds - job.m_startedSeconds);
+	typeStats.m_retrievalLagHistogram.Record(GetCurrentTimeSeconds() - job.m_finishedSeconds);
+}
+
+void JobStats::Update()
+{
+	// The first frame only sets the baselines, busy time from before it is not credited to any window
+	if (s_windowStartSeconds <= 0.0)
+	{
+		Reset();
+		return;
+	}
+
+	double nowSeconds = GetCurrentTimeSeconds();
+
+	double windowSeconds = nowSeconds - s_windowStartSeconds;
+	if (windowSeconds < JOB_STATS_UTILIZATION_WINDOW_SECONDS) return;
+
+	std::lock_guard<std::mutex> lock(s_workersMutex);
+	for (std::unique_ptr<JobWorkerStats> const& workerStats : s_workers)
+	{
+		unsigned long long busyMicroseconds = workerStats->m_busyMicroseconds.load(std::memory_order_relaxed);
+		double busyRatio = static_cast<double>(busyMicroseconds - workerStats->m_busyMicrosecondsAtWindowStart) / (1000000.0 * windowSeconds);
+		workerStats->m_busyRatio = static_cast<float>((busyRatio < 1.0) ? busyRatio : 1.0);
+		workerStats->m_busyMicrosecondsAtWindowStart = busyMicroseconds;
+	}
+	s_windowStartSeconds = nowSeconds;
+}
+
+void JobStats::Reset()
+{
+	for (GameJobTypeStats& typeStats : s_typeStats)
+	{
+		typeStats.m_waitHistogram.Clear();
+		typeStats.m_runHistogram.Clear();
+		typeStats.m_retrievalLagHistogram.Clear();
+	}
+
+	std::lock_guard<std::mutex> lock(s_workersMutex);
+	for (std::unique_ptr<JobWorkerStats> const& workerStats : s_workers)
+	{
+		workerStats->m_busyMicrosecondsAtReset = workerStats->m_busyMicroseconds.load(std::memory_order_relaxed);
+		workerStats->m_busyMicrosecondsAtWindowStart = workerStats->m_busyMicrosecondsAtReset;
+		workerStats->m_busyRatio = 0.f;
+	}
+	s_resetSeconds = GetCurrentTimeSeconds();
+	s_windowStartSeconds = s_resetSeconds;
+}
+
+GameJobTypeStats const& JobStats::GetTypeStats(GameJobType gameJobType)
+{
+	return s_typeStats[static_cast<int>(gameJobType)];
+}
+
+char const* JobStats::GetGameJobTypeName(GameJobType gameJobType)
+{
+	switch (gameJobType)
+	{
+	case GameJobType::PATHFINDING:			return "Pathfinding";
+	case GameJobType::AGENT_STEERING:		return "AgentSteering";
+	case GameJobType::NAV_TILE_BUILD:		return "NavTileBuild";
+	case GameJobType::FLOW_FIELD_BUILD:		return "FlowFieldBuild";
+	case GameJobType::NAV_LANDMARK_BUILD:	return "NavLandmarkBuild";
+	default:								return "Unknown";
+	}
+}
+
+int JobStats::GetNumWorkers()
+{
+	std::lock_guard<std::mutex> lock(s_workersMutex);
+	return static_cast<int>(s_workers.size());
+}
+
+float JobStats::GetWorkerBusyRatio(int workerIndex)
+{
+	std::lock_guard<std::mutex> lock(s_workersMutex);
+	if (workerIndex < 0 || workerIndex >= static_cast<int>(s_workers.size())) return 0.f;
+	return s_workers[workerIndex]->m_busyRatio;
+}
+
+std::string JobStats::GetReport()
+{
+	std::string report = "=== Jobs (ms) ===\n";
+	report += "type               retrieved   wait p50   wait p99    run p50    run p99    lag p99\n";
+
+	char line[160];
+	for (int typeIndex = 0; typeIndex < static_cast<int>(GameJobType::NUM_GAME_JOB_TYPES); typeIndex++)
+	{
+		GameJobTypeStats const& typeStats = s_typeStats[typeIndex];
+		if (typeStats.m_runHistogram.GetCount() == 0) continue;
+
+		snprintf(line, sizeof(line), "%-18s %9u %10.3f %10.3f %10.3f %10.3f %10.3f\n", GetGameJobTypeName(static_cast<GameJobType>(typeIndex)),
+			typeStats.m_runHistogram.GetCount(),
+			1000.0 * typeStats.m_waitHistogram.GetPercentileSeconds(50.0), 1000.0 * typeStats.m_waitHistogram.GetPercentileSeconds(99.0),
+			1000.0 * typeStats.m_runHistogram.GetPercentileSeconds(50.0), 1000.0 * typeStats.m_runHistogram.GetPercentileSeconds(99.0),
+			1000.0 * typeStats.m_retrievalLagHistogram.GetPercentileSeconds(99.0));
+		report += line;
+	}
+
+	double elapsedSeconds = GetCurrentTimeSeconds() - s_resetSeconds;
+	std::lock_guard<std::mutex> lock(s_workersMutex);
+	for (int workerIndex = 0; workerIndex < static_cast<int>(s_workers.size()); workerIndex++)
+	{
+		JobWorkerStats const& workerStats = *s_workers[workerIndex];
+		unsigned long long busyMicroseconds = workerStats.m_busyMicroseconds.load(std::memory_order_relaxed) - workerStats.m_busyMicrosecondsAtReset;
+		double busyRatio = (elapsedSeconds > 0.0) ? static_cast<double>(busyMicroseconds) / (1000000.0 * elapsedSeconds) : 0.0;
+		snprintf(line, sizeof(line), "worker %2i: %5.1f%% busy, %u jobs\n", workerIndex, 100.0 * busyRatio, workerStats.m_numJobs.load(std::memory_order_relaxed));
+		report += line;
+	}
+	return report;
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "Game/JobCompletionDispatcher.hpp"
+#include "Game/Diagnostics/FrameTimeHistogram.hpp"
+#include <atomic>
+#include <string>
+
+constexpr double JOB_STATS_UTILIZATION_WINDOW_SECONDS = 1.0;
+
+//------------------------------------------------------------------------------------------------
+// Counters move on whichever thread the event happens on. The latency histograms are only touched by
+// the main thread: each job carries its own timestamps and they are recorded when the dispatcher
+// retrieves it, so workers never contend on a histogram.
+struct GameJobTypeStats
+{
+	std::atomic<unsigned int> m_numQueued{ 0 };
+	std::atomic<unsigned int> m_numStarted{ 0 };
+	std::atomic<unsigned int> m_numFinished{ 0 };
+	unsigned int m_numRetrieved = 0;
+
+	FrameTimeHistogram m_waitHistogram;			// Queued to started, time spent in the JobSystem queue
+	FrameTimeHistogram m_runHistogram;			// Started to finished, the job's own work
+	FrameTimeHistogram m_retrievalLagHistogram;	// Finished to retrieved, waiting for the next dispatch
+
+	int GetNumWaiting() const;
+	int GetNumRunning() const;
+	int GetNumAwaitingRetrieval() const;
+	int GetNumOutstanding() const; // Queued and not yet retrieved, whatever stage it is in
+};
+
+//------------------------------------------------------------------------------------------------
+// One per thread that has run a game job, in the order they first ran one
+struct JobWorkerStats
+{
+	std::atomic<unsigned long long> m_busyMicroseconds{ 0 };
+	std::atomic<unsigned int> m_numJobs{ 0 };
+
+	// Main thread only
+	unsigned long long m_busyMicrosecondsAtWindowStart = 0;
+	unsigned long long m_busyMicrosecondsAtReset = 0;
+	float m_busyRatio = 0.f;
+};
+
+//------------------------------------------------------------------------------------------------
+// Observability for the game's use of the JobSystem, which itself lives in the engine and exposes no
+// counters. Splits a path request's latency into queueing, running and waiting to be picked up.
+// Busy time is credited when a job finishes, so a job longer than the window shows up as a spike.
+class JobStats
+{
+public:
+	static void OnQueued(GameJob& job);
+	static void OnStarted(GameJob& job);		// Worker
+	static void OnFinished(GameJob& job);		// Worker
+	static void OnRetrieved(GameJob const& job);	// Main thread
+
+	// Main thread from here on
+	static void Update(); // Once per frame, refreshes the busy ratios once per window
+	static void Reset(); // Clears the histograms and restarts the busy ratios, the in-flight counters keep going
+
+	static GameJobTypeStats const& GetTypeStats(GameJobType gameJobType);
+	static char const* GetGameJobTypeName(GameJobType gameJobType);
+	static int GetNumWorkers();
+	static float GetWorkerBusyRatio(int workerIndex);
+	static std::string GetReport(); // Latency percentiles per type and run-wide busy ratio per worker
+};
@@ -0,0 +1,186 @@
+#include "Game/Diagnostics/PathQueryStats.hpp"
+#include <cstdio>
+#include <fstream>
+
+// Histogram units per display unit, so the integer buckets keep enough resolution
+static double const s_metricScales[NUM_PATH_QUERY_METRICS] = { 1000.0, 1.0, 1.0, 1.0, 1.0, 100.0 };
+
+// Whether a frame adds the metric up over its queries or keeps the largest one
+static bool const s_isMetricSummedPerFrame[NUM_PATH_QUERY_METRICS] = { true, true, true, false, false, false };
+
+static unsigned long long GetHistogramValue(PathQueryMetric metric, double value)
+{
+	double scaledValue = value * s_metricScales[static_cast<int>(metric)];
+	return (scaledValue > 0.0) ? static_cast<unsigned long long>(scaledValue + 0.5) : 0;
+}
+
+static double GetDisplayValue(PathQueryMetric metric, unsigned long long histogramValue)
+{
+	return static_cast<double>(histogramValue) / s_metricScales[static_cast<int>(metric)];
+}
+
+void PathQueryStats::RecordQuery(NavQueryStats const& queryStats)
+{
+	m_numQueriesBySource[static_cast<int>(queryStats.m_source)]++;
+	m_currentFrame.m_numQueries++;
+	if (!queryStats.m_isFound)
+	{
+		m_numNotFound++;
+		m_currentFrame.m_numNotFound++;
+	}
+
+	double values[NUM_PATH_QUERY_METRICS];
+	values[static_cast<int>(PathQueryMetric::MS_ELAPSED)] = queryStats.m_msElapsed;
+	values[static_cast<int>(PathQueryMetric::NODES_EXPANDED)] = queryStats.m_search.m_numExpanded;
+	values[static_cast<int>(PathQueryMetric::NODES_PUSHED)] = queryStats.m_search.m_numPushed;
+	values[static_cast<int>(PathQueryMetric::PEAK_OPEN_SIZE)] = queryStats.m_search.m_peakOpenSize;
+	values[static_cast<int>(PathQueryMetric::WAYPOINTS)] = queryStats.m_numWaypoints;
+	values[static_cast<int>(PathQueryMetric::PATH_LENGTH)] = queryStats.m_pathLength;
+
+	for (int metricIndex = 0; metricIndex < NUM_PATH_QUERY_METRICS; metricIndex++)
+	{
+		// A failed query has no path, its zero length would drag the length percentiles down
+		bool isPathMetric = metricIndex == static_cast<int>(PathQueryMetric::WAYPOINTS) || metricIndex == static_cast<int>(PathQueryMetric::PATH_LENGTH);
+		if (!isPathMetric || queryStats.m_isFound)
+		{
+			m_queryHistograms[metricIndex].RecordValue(GetHistogramValue(static_cast<PathQueryMetric>(metricIndex), values[metricIndex]));
+		}
+
+		double& frameValue = m_currentFrame.m_values[metricIndex];
+		frameValue = s_isMetricSummedPerFrame[metricIndex] ? frameValue + values[metricIndex] : ((values[metricIndex] > frameValue) ? values[metricIndex] : frameValue);
+	}
+}
+
+void PathQueryStats::EndFrame()
+{
+	// Idle frames are left out, otherwise the per frame percentiles mostly count frames without paths
+	if (m_currentFrame.m_numQueries == 0) return;
+
+	m_queriesPerFrame.RecordValue(static_cast<unsigned long long>(m_currentFrame.m_numQueries));
+	for (int metricIndex = 0; metricIndex < NUM_PATH_QUERY_METRICS; metricIndex++)
+	{
+		m_frameHistograms[metricIndex].RecordValue(GetHistogramValue(static_cast<PathQueryMetric>(metricIndex), m_currentFrame.m_values[metricIndex]));
+	}
+
+	m_lastFrame = m_currentFrame;
+	m_currentFrame = PathQueryFrameTotals();
+}
+
+void PathQueryStats::Reset()
+{
+	for (int metricIndex = 0; metricIndex < NUM_PATH_QUERY_METRICS; metricIndex++)
+	{
+		m_queryHistograms[metricIndex].Clear();
+		m_frameHistograms[metricIndex].Clear();
+	}
+	m_queriesPerFrame.Clear();
+	m_currentFrame = PathQueryFrameTotals();
+	m_lastFrame = PathQueryFrameTotals();
+	for (unsigned int& numQueries : m_numQueriesBySource)
+	{
+		numQueries = 0;
+	}
+	m_numNotFound = 0;
+}
+
+double PathQueryStats::GetQueryPercentile(PathQueryMetric metric, double percentile) const
+{
+	return GetDisplayValue(metric, m_queryHistograms[static_cast<int>(metric)].GetPercentileValue(percentile));
+}
+
+double PathQueryStats::GetQueryMax(PathQueryMetric metric) const
+{
+	return GetDisplayValue(metric, m_queryHistograms[static_cast<int>(metric)].GetMaxValue());
+}
+
+double PathQueryStats::GetFramePercentile(PathQueryMetric metric, double percentile) const
+{
+	return GetDisplayValue(metric, m_frameHistograms[static_cast<int>(metric)].GetPercentileValue(percentile));
+}
+
+char const* PathQueryStats::GetMetricName(PathQueryMetric metric)
+{
+	switch (metric)
+	{
+	case PathQueryMetric::MS_ELAPSED:		return "ms";
+	case PathQueryMetric::NODES_EXPANDED:	return "expanded";
+	case PathQueryMetric::NODES_PUSHED:		return "pushed";
+	case PathQueryMetric::PEAK_OPEN_SIZE:	return "peak_open";
+	case PathQueryMetric::WAYPOINTS:		return "waypoints";
+	case PathQueryMetric::PATH_LENGTH:		return "length_m";
+	default:								return "unknown";
+	}
+}
+
+char const* PathQueryStats::GetSourceName(NavQuerySource source)
+{
+	switch (source)
+	{
+	case NavQuerySource::NONE:			return "None";
+	case NavQuerySource::STREAMED:		return "Streamed";
+	case NavQuerySource::CACHED:		return "Cached";
+	case NavQuerySource::HIERARCHY:		return "Hierarchy";
+	case NavQuerySource::FLAT:			return "Flat";
+	case NavQuerySource::INCREMENTAL:	return "Incremental";
+	default:							return "Unknown";
+	}
+}
+
+std::string PathQueryStats::GetReport() const
+{
+	std::string report = "=== Path Queries ===\n";
+	char line[160];
+	snprintf(line, sizeof(line), "%u queries, %u without a path, %u frames with queries (p50 %llu, max %llu per frame)\n",
+		m_queryHistograms[0].GetCount(), m_numNotFound, m_queriesPerFrame.GetCount(), m_queriesPerFrame.GetPercentileValue(50.0), m_queriesPerFrame.GetMaxValue());
+	report += line;
+	report += "metric            p50         p95         p99         max   frame p99\n";
+
+	for (int metricIndex = 0; metricIndex < NUM_PATH_QUERY_METRICS; metricIndex++)
+	{
+		PathQueryMetric metric = static_cast<PathQueryMetric>(metricIndex);
+		snprintf(line, sizeof(line), "%-10s %11.2f %11.2f %11.2f %11.2f %11.2f\n", GetMetricName(metric),
+			GetQueryPercentile(metric, 50.0), GetQueryPercentile(metric, 95.0), GetQueryPercentile(metric, 99.0), GetQueryMax(metric),
+			GetFramePercentile(metric, 99.0));
+		report += line;
+	}
+
+	report += "source:";
+	for (int sourceIndex = 0; sourceIndex < NUM_NAV_QUERY_SOURCES; sourceIndex++)
+	{
+		if (m_numQueriesBySource[sourceIndex] == 0) continue;
+
+		snprintf(line, sizeof(line), " %s %u", GetSourceName(static_cast<NavQuerySource>(sourceIndex)), m_numQueriesBySource[sourceIndex]);
+		report += line;
+	}
+	report += "\n";
+	return report;
+}
+
+bool PathQueryStats::WriteHistograms(std::string const& filePath) const
+{
+	std::ofstream histogramFile(filePath, std::ios::trunc);
+	if (!histogramFile.is_open()) return false;
+
+	histogramFile << "scope,metric,bucket_upper,count\n";
+	char line[128];
+	auto writeHistogram = [&](char const* scope, char const* metricName, FrameTimeHistogram const& histogram, double scale)
+	{
+		for (int bucketIndex = 0; bucketIndex < FRAME_TIME_NUM_BUCKETS; bucketIndex++)
+		{
+			if (histogram.m_bucketCounts[bucketIndex] == 0) continue;
+
+			double bucketUpper = static_cast<double>(FrameTimeHistogram::GetBucketUpperMicroseconds(bucketIndex)) / scale;
+			snprintf(line, sizeof(line), "%s,%s,%.3f,%u\n", scope, metricName, bucketUpper, histogram.m_bucketCounts[bucketIndex]);
+			histogramFile << line;
+		}
+	};
+
+	for (int metricIndex = 0; metricIndex < NUM_PATH_QUERY_METRICS; metricIndex++)
+	{
+		char const* metricName = GetMetricName(static_cast<PathQueryMetric>(metricIndex));
+		writeHistogram("query", metricName, m_queryHistograms[metricIndex], s_metricScales[metricIndex]);
+		writeHistogram("frame", metricName, m_frameHistograms[metricIndex], s_metricScales[metricIndex]);
+	}
+	writeHistogram("frame", "queries", m_queriesPerFrame, 1.0);
+	return histogramFile.good();
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include "Game/Diagnostics/FrameTimeHistogram.hpp"
+#include "Game/Navigation/NavPathfinder.hpp"
+#include <string>
+
+enum class PathQueryMetric
+{
+	MS_ELAPSED,
+	NODES_EXPANDED,
+	NODES_PUSHED,
+	PEAK_OPEN_SIZE,
+	WAYPOINTS,
+	PATH_LENGTH,
+	NUM_PATH_QUERY_METRICS
+};
+
+constexpr int NUM_PATH_QUERY_METRICS = static_cast<int>(PathQueryMetric::NUM_PATH_QUERY_METRICS);
+constexpr int NUM_NAV_QUERY_SOURCES = static_cast<int>(NavQuerySource::NUM_NAV_QUERY_SOURCES);
+
+//------------------------------------------------------------------------------------------------
+// One frame's path queries. Time and node counts add up to what the frame spent on pathfinding, the
+// others keep the worst query, since a frame's total waypoints says nothing.
+struct PathQueryFrameTotals
+{
+	int m_numQueries = 0;
+	int m_numNotFound = 0;
+	double m_values[NUM_PATH_QUERY_METRICS] = {};
+};
+
+//------------------------------------------------------------------------------------------------
+// Aggregates the NavQueryStats the path jobs send through the telemetry rings, main thread only.
+// Every metric gets a histogram with one sample per query and one with one sample per frame that
+// ran any query, reusing the frame time buckets: time in microseconds, lengths in centimeters and
+// counts as they are, so every percentile is within ~3%. The histograms can be written out as CSV
+// to compare heuristics and cluster sizes between runs.
+class PathQueryStats
+{
+public:
+	PathQueryStats() = default;
+	~PathQueryStats() = default;
+
+	void RecordQuery(NavQueryStats const& queryStats);
+	void EndFrame(); // Once per frame after the telemetry is drained, even when nothing came in
+	void Reset();
+
+	// In display units: ms, meters or a plain count
+	double GetQueryPercentile(PathQueryMetric metric, double percentile) const;
+	double GetQueryMax(PathQueryMetric metric) const;
+	double GetFramePercentile(PathQueryMetric metric, double percentile) const;
+
+	static char const* GetMetricName(PathQueryMetric metric);
+	static char const* GetSourceName(NavQuerySource source);
+
+	// Per query percentiles for the run, then per frame p99, then queries by corridor source
+	std::string GetReport() const;
+
+	// One row per non-empty bucket: scope (query or frame), metric, bucket upper edge in display units, count
+	bool WriteHistograms(std::string const& filePath) const;
+
+public:
+	FrameTimeHistogram m_queryHistograms[NUM_PATH_QUERY_METRICS];
+	FrameTimeHistogram m_frameHistograms[NUM_PATH_QUERY_METRICS];
+	FrameTimeHistogram m_queriesPerFrame;
+
+	PathQueryFrameTotals m_currentFrame;
+	PathQueryFrameTotals m_lastFrame; // Last frame that ran any query
+
+	unsigned int m_numQueriesBySource[NUM_NAV_QUERY_SOURCES] = {};
+	unsigned int m_numNotFound = 0;
+};
@@ -0,0 +1,192 @@
+#include "Game/Diagnostics/Profiler.hpp"
+#include "Engine/Core/Time.hpp"
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+// Buffers live until exit, like the telemetry rings, so a zone never outlives the buffer it pushes to
+static std::mutex s_buffersMutex;
+static std::vector<std::unique_ptr<ProfilerThreadBuffer>> s_buffers;
+static std::atomic<bool> s_isEnabled{ false };
+
+// Main thread only
+static std::vector<ProfileZoneRecord> s_lastFrameZones;
+static double s_frameBeginSeconds = 0.0;
+static double s_lastFrameBeginSeconds = 0.0;
+static double s_lastFrameEndSeconds = 0.0;
+static bool s_isCapturing = false;
+static double s_captureBeginSeconds = 0.0;
+static std::vector<ProfileZoneRecord> s_capturedZones;
+static unsigned long long s_numCaptureDropped = 0;
+
+ProfileZone::ProfileZone(char const* name)
+{
+	if (!s_isEnabled.load(std::memory_order_relaxed)) return;
+
+	m_buffer = &Profiler::GetBufferForCurrentThread();
+	m_buffer->m_depth++;
+	m_name = name;
+	m_beginSeconds = GetCurrentTimeSeconds();
+}
+
+ProfileZone::~ProfileZone()
+{
+	if (m_buffer == nullptr) return;
+
+	ProfileZoneRecord record;
+	record.m_name = m_name;
+	record.m_beginSeconds = m_beginSeconds;
+	record.m_endSeconds = GetCurrentTimeSeconds();
+	record.m_depth = --m_buffer->m_depth;
+	record.m_threadIndex = m_buffer->m_threadIndex;
+	m_buffer->TryPush(record);
+}
+
+void Profiler::SetEnabled(bool isEnabled)
+{
+	s_isEnabled.store(isEnabled, std::memory_order_relaxed);
+}
+
+bool Profiler::IsEnabled()
+{
+	return s_isEnabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::SetCurrentThreadName(std::string const& threadName)
+{
+	ProfilerThreadBuffer& buffer = GetBufferForCurrentThread();
+	std::lock_guard<std::mutex> lock(s_buffersMutex);
+	buffer.m_threadName = threadName;
+}
+
+void Profiler::BeginFrame()
+{
+	double nowSeconds = GetCurrentTimeSeconds();
+	s_lastFrameBeginSeconds = s_frameBeginSeconds;
+	s_lastFrameEndSeconds = nowSeconds;
+	s_frameBeginSeconds = nowSeconds;
+
+	s_lastFrameZones.clear();
+	{
+		std::lock_guard<std::mutex> lock(s_buffersMutex);
+		for (std::unique_ptr<ProfilerThreadBuffer> const& buffer : s_buffers)
+		{
+			buffer->Drain(s_lastFrameZones);
+		}
+	}
+
+	if (!s_isCapturing) return;
+
+	size_t numFree = PROFILER_MAX_CAPTURE_ZONES - s_capturedZones.size();
+	size_t numKept = (s_lastFrameZones.size() < numFree) ? s_lastFrameZones.size() : numFree;
+	s_capturedZones.insert(s_capturedZones.end(), s_lastFrameZones.begin(), s_lastFrameZones.begin() + numKept);
+	s_numCaptureDropped += s_lastFrameZones.size() - numKept;
+}
+
+std::vector<ProfileZoneRecord> const& Profiler::GetLastFrameZones()
+{
+	return s_lastFrameZones;
+}
+
+double Profiler::GetLastFrameBeginSeconds()
+{
+	return s_lastFrameBeginSeconds;
+}
+
+double Profiler::GetLastFrameEndSeconds()
+{
+	return s_lastFrameEndSeconds;
+}
+
+int Profiler::GetNumThreads()
+{
+	std::lock_guard<std::mutex> lock(s_buffersMutex);
+	return static_cast<int>(s_buffers.size());
+}
+
+std::string Profiler::GetThreadName(int threadIndex)
+{
+	std::lock_guard<std::mutex> lock(s_buffersMutex);
+	if (threadIndex < 0 || threadIndex >= static_cast<int>(s_buffers.size())) return std::string();
+	return s_buffers[threadIndex]->m_threadName;
+}
+
+unsigned long long Profiler::GetNumDropped()
+{
+	std::lock_guard<std::mutex> lock(s_buffersMutex);
+	unsigned long long numDropped = s_numCaptureDropped;
+	for (std::unique_ptr<ProfilerThreadBuffer> const& buffer : s_buffers)
+	{
+		numDropped += buffer->m_numDropped.load(std::memory_order_relaxed);
+	}
+	return numDropped;
+}
+
+void Profiler::BeginCapture()
+{
+	s_capturedZones.clear();
+	s_numCaptureDropped = 0;
+	s_captureBeginSeconds = GetCurrentTimeSeconds();
+	s_isCapturing = true;
+}
+
+bool Profiler::IsCapturing()
+{
+	return s_isCapturing;
+}
+
+size_t Profiler::GetNumCapturedZones()
+{
+	return s_capturedZones.size();
+}
+
+bool Profiler::EndCapture(std::string const& filePath)
+{
+	if (!s_isCapturing) return false;
+	s_isCapturing = false;
+
+	std::ofstream traceFile(filePath, std::ios::trunc);
+	if (!traceFile.is_open()) return false;
+
+	// Complete ("X") events in microseconds since the capture began, one tid per profiler thread
+	traceFile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	char line[256];
+	char const* separator = ""; // Only goes between events, a trace with no threads is still valid JSON
+	int numThreads = GetNumThreads();
+	for (int threadIndex = 0; threadIndex < numThreads; threadIndex++)
+	{
+		snprintf(line, sizeof(line), "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%i,\"args\":{\"name\":\"%s\"}}",
+			separator, threadIndex, GetThreadName(threadIndex).c_str());
+		traceFile << line;
+		separator = ",";
+	}
+
+	for (ProfileZoneRecord const& zone : s_capturedZones)
+	{
+		double beginMicroseconds = 1000000.0 * (zone.m_beginSeconds - s_captureBeginSeconds);
+		double durationMicroseconds = 1000000.0 * (zone.m_endSeconds - zone.m_beginSeconds);
+		snprintf(line, sizeof(line), "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%i,\"ts\":%.3f,\"dur\":%.3f}",
+			separator, zone.m_name, zone.m_threadIndex, beginMicroseconds, durationMicroseconds);
+		traceFile << line;
+		separator = ",";
+	}
+	traceFile << "\n]}\n";
+
+	s_capturedZones.clear();
+	s_capturedZones.shrink_to_fit();
+	return traceFile.good();
+}
+
+ProfilerThreadBuffer& Profiler::GetBufferForCurrentThread()
+{
+	thread_local ProfilerThreadBuffer* t_buffer = nullptr;
+	if (t_buffer == nullptr)
+	{
+		std::lock_guard<std::mutex> lock(s_buffersMutex);
+		int threadIndex = static_cast<int>(s_buffers.size());
+		s_buffers.emplace_back(std::make_unique<ProfilerThreadBuffer>(threadIndex, "Worker " + std::to_string(threadIndex)));
+		t_buffer = s_buffers.back().get();
+	}
+	return *t_buffer;
+}
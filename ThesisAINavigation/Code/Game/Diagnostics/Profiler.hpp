@@ -0,0 +1,90 @@
+#pragma once
+#include "Game/Diagnostics/SPSCRing.hpp"
+#include <atomic>
+#include <string>
+#include <vector>
+
+//#define GAME_DISABLE_PROFILER	// (If uncommented) Compiles every PROFILE_ZONE away, the flame view just stays empty
+
+constexpr unsigned int PROFILER_RING_CAPACITY = 16384;	// Power of two, zones one thread can close between two drains
+constexpr size_t PROFILER_MAX_CAPTURE_ZONES = 1 << 21;	// ~64 MB of zones, later ones are counted as dropped
+constexpr char const* PROFILER_TRACE_FOLDER = "Data/Profiles";
+
+//------------------------------------------------------------------------------------------------
+// One closed zone. Names are string literals, so a record is a plain copy and nothing is allocated.
+struct ProfileZoneRecord
+{
+	char const* m_name = nullptr;
+	double m_beginSeconds = 0.0;
+	double m_endSeconds = 0.0;
+	int m_depth = 0;
+	int m_threadIndex = 0;
+};
+
+//------------------------------------------------------------------------------------------------
+// Per-thread zone buffer, pushed by the owning thread and drained by the main thread
+class ProfilerThreadBuffer : public SPSCRing<ProfileZoneRecord, PROFILER_RING_CAPACITY>
+{
+public:
+	ProfilerThreadBuffer(int threadIndex, std::string const& threadName) : m_threadIndex(threadIndex), m_threadName(threadName) {}
+
+public:
+	int const m_threadIndex = 0;
+	std::string m_threadName;
+	int m_depth = 0; // Owning thread only
+};
+
+//------------------------------------------------------------------------------------------------
+// Opens on construction and pushes the closed zone on destruction. Use PROFILE_ZONE rather than
+// declaring one directly so it compiles away with GAME_DISABLE_PROFILER.
+class ProfileZone
+{
+public:
+	explicit ProfileZone(char const* name);
+	~ProfileZone();
+
+	ProfileZone(ProfileZone const&) = delete;
+	ProfileZone& operator=(ProfileZone const&) = delete;
+
+private:
+	ProfilerThreadBuffer* m_buffer = nullptr; // Null when recording was off as the zone opened
+	char const* m_name = nullptr;
+	double m_beginSeconds = 0.0;
+};
+
+//------------------------------------------------------------------------------------------------
+// Recording is off until something wants the zones (the flame view or a capture), then every open
+// zone costs two timer reads and a ring push. The main thread calls BeginFrame once per frame: it
+// drains every thread's buffer into the last-frame list for the flame view and, while capturing,
+// into the capture that EndCapture writes out as Chrome trace JSON (chrome://tracing, Perfetto).
+class Profiler
+{
+public:
+	static void SetEnabled(bool isEnabled);
+	static bool IsEnabled();
+	static void SetCurrentThreadName(std::string const& threadName);
+
+	// Main thread only from here on
+	static void BeginFrame();
+	static std::vector<ProfileZoneRecord> const& GetLastFrameZones();
+	static double GetLastFrameBeginSeconds();
+	static double GetLastFrameEndSeconds();
+	static int GetNumThreads();
+	static std::string GetThreadName(int threadIndex);
+	static unsigned long long GetNumDropped();
+
+	static void BeginCapture();
+	static bool IsCapturing();
+	static size_t GetNumCapturedZones();
+	static bool EndCapture(std::string const& filePath); // Writes the trace, false if the file could not be opened
+
+	static ProfilerThreadBuffer& GetBufferForCurrentThread();
+};
+
+#if defined(GAME_DISABLE_PROFILER)
+#define PROFILE_ZONE(name)
+#else
+#define PROFILE_ZONE_JOIN_INNER(a, b) a##b
+#define PROFILE_ZONE_JOIN(a, b) PROFILE_ZONE_JOIN_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_ZONE_JOIN(profileZone_, __LINE__)(name)
+#endif
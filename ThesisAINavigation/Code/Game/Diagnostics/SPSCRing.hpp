@@ -0,0 +1,63 @@
+#pragma once
+#include <atomic>
+#include <vector>
+
+//------------------------------------------------------------------------------------------------
+// Single producer, single consumer ring of plain records. The owning thread pushes and the main
+// thread drains; the two indexes sit on separate cache lines so neither side invalidates the other's
+// line every push. A full ring drops the new record and counts it rather than blocking the producer.
+template<typename RecordType, unsigned int CAPACITY>
+class SPSCRing
+{
+	static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "SPSCRing capacity must be a power of two");
+
+public:
+	SPSCRing() { m_records.resize(CAPACITY); }
+	~SPSCRing() = default;
+
+	SPSCRing(SPSCRing const&) = delete;
+	SPSCRing& operator=(SPSCRing const&) = delete;
+
+	bool TryPush(RecordType const& record);
+	int Drain(std::vector<RecordType>& out_records);
+
+public:
+	std::atomic<unsigned long long> m_numDropped{ 0 };
+
+private:
+	std::vector<RecordType> m_records;
+	alignas(64) std::atomic<unsigned int> m_writeIndex{ 0 };
+	alignas(64) std::atomic<unsigned int> m_readIndex{ 0 };
+};
+
+template<typename RecordType, unsigned int CAPACITY>
+bool SPSCRing<RecordType, CAPACITY>::TryPush(RecordType const& record)
+{
+	unsigned int writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+	unsigned int readIndex = m_readIndex.load(std::memory_order_acquire);
+	if (writeIndex - readIndex >= CAPACITY)
+	{
+		m_numDropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	m_records[writeIndex & (CAPACITY - 1)] = record;
+	m_writeIndex.store(writeIndex + 1, std::memory_order_release);
+	return true;
+}
+
+template<typename RecordType, unsigned int CAPACITY>
+int SPSCRing<RecordType, CAPACITY>::Drain(std::vector<RecordType>& out_records)
+{
+	unsigned int readIndex = m_readIndex.load(std::memory_order_relaxed);
+	unsigned int writeIndex = m_writeIndex.load(std::memory_order_acquire);
+	int numDrained = static_cast<int>(writeIndex - readIndex);
+	for (; readIndex != writeIndex; readIndex++)
+	{
+		out_records.emplace_back(m_records[readIndex & (CAPACITY - 1)]);
+	}
+
+	// Hands the slots back to the producer only after they have been copied out
+	m_readIndex.store(readIndex, std::memory_order_release);
+	return numDrained;
+}
@@ -0,0 +1,47 @@
+#include "Game/Diagnostics/Telemetry.hpp"
+#include <memory>
+#include <mutex>
+
+// Rings live until exit, the pool threads that own them never go away before the game does
+static std::mutex s_ringsMutex;
+static std::vector<std::unique_ptr<TelemetryRing>> s_rings;
+
+void Telemetry::Record(TelemetryRecord& record)
+{
+	TelemetryRing& ring = GetRingForCurrentThread();
+	record.m_threadIndex = ring.m_threadIndex;
+	ring.TryPush(record);
+}
+
+void Telemetry::DrainAll(std::vector<TelemetryRecord>& out_records)
+{
+	// Only contends with a thread registering its ring, which happens once per thread
+	std::lock_guard<std::mutex> lock(s_ringsMutex);
+	for (std::unique_ptr<TelemetryRing> const& ring : s_rings)
+	{
+		ring->Drain(out_records);
+	}
+}
+
+unsigned long long Telemetry::GetNumDropped()
+{
+	std::lock_guard<std::mutex> lock(s_ringsMutex);
+	unsigned long long numDropped = 0;
+	for (std::unique_ptr<TelemetryRing> const& ring : s_rings)
+	{
+		numDropped += ring->m_numDropped.load(std::memory_order_relaxed);
+	}
+	return numDropped;
+}
+
+TelemetryRing& Telemetry::GetRingForCurrentThread()
+{
+	thread_local TelemetryRing* t_ring = nullptr;
+	if (t_ring == nullptr)
+	{
+		std::lock_guard<std::mutex> lock(s_ringsMutex);
+		s_rings.emplace_back(std::make_unique<TelemetryRing>(static_cast<int>(s_rings.size())));
+		t_ring = s_rings.back().get();
+	}
+	return *t_ring;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "Game/Diagnostics/SPSCRing.hpp"
+#include "Game/Navigation/NavPathfinder.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <vector>
+
+constexpr unsigned int TELEMETRY_RING_CAPACITY = 4096; // Power of two
+
+enum class TelemetryRecordType
+{
+	PATH_QUERY,
+	NUM_TELEMETRY_RECORD_TYPES
+};
+
+//------------------------------------------------------------------------------------------------
+// Plain fixed size record, so pushing one is a copy and nothing gets formatted off the main thread
+struct TelemetryRecord
+{
+	TelemetryRecordType m_type = TelemetryRecordType::PATH_QUERY;
+	int m_threadIndex = 0;
+	double m_timeSeconds = 0.0;
+	NavQueryStats m_queryStats;
+	Vec3 m_startPoint = Vec3::ZERO;
+	Vec3 m_goalPoint = Vec3::ZERO;
+};
+
+//------------------------------------------------------------------------------------------------
+// One thread's records, tagged with the index its records carry
+class TelemetryRing : public SPSCRing<TelemetryRecord, TELEMETRY_RING_CAPACITY>
+{
+public:
+	explicit TelemetryRing(int threadIndex) : m_threadIndex(threadIndex) {}
+
+public:
+	int const m_threadIndex = 0;
+};
+
+//------------------------------------------------------------------------------------------------
+// Every thread that records gets its own ring on first use. Recording never takes a lock after that,
+// so path jobs on the workers stop contending on the console and debug renderer. The main thread
+// drains all rings once per frame and hands the records to the sinks (console, file).
+class Telemetry
+{
+public:
+	static void Record(TelemetryRecord& record); // Any thread, fills in the thread index
+	static void DrainAll(std::vector<TelemetryRecord>& out_records); // Main thread
+	static unsigned long long GetNumDropped();
+
+private:
+	static TelemetryRing& GetRingForCurrentThread();
+};
@@ -1,5 +1,7 @@
 ﻿#include "Game/Game.hpp"
 #include "Game/App.hpp"
+#include "Game/Diagnostics/JobStats.hpp"
+#include "Game/Navigation/NavPathCache.hpp"
 
 #include "Engine/Renderer/DebugRenderer.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
@@ -12,11 +14,14 @@
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/Time.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Math/EulerAngles.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Input/InputSystem.hpp"
 
+#include <algorithm>
+#include <filesystem>
 #include <vector>
 
 extern DevConsole* g_theConsole;
@@ -45,20 +50,23 @@ void Game::CreateSkyBuffers()
 
 void Game::FPSCalculation()
 {
-	float deltaTime = m_clock->GetDeltaSeconds();
-	m_frameTimes.push_back(deltaTime);
-	if (m_frameTimes.size() > m_maxFrameSamples)
+	double nowSeconds = GetCurrentTimeSeconds();
+	if (m_lastFrameTimeSeconds <= 0.0)
 	{
-		m_frameTimes.pop_front();
+		m_lastFrameTimeSeconds = nowSeconds;
+		return;
 	}
+	double frameSeconds = nowSeconds - m_lastFrameTimeSeconds;
+	m_lastFrameTimeSeconds = nowSeconds;
+	m_frameTimeTracker.RecordFrame(frameSeconds);
 
 	// FPS Update Timer
-	m_fpsUpdateTimer += deltaTime;
+	m_fpsUpdateTimer += static_cast<float>(frameSeconds);
 	if (m_fpsUpdateTimer >= 0.7f) // Update every 0.7 seconds
 	{
 		m_displayedFps = GetGameFPS();
 		m_displayedFpsHistory.emplace_back(m_displayedFps);
-		if (m_displayedFpsHistory.size() > m_maxFrameSamples)
+		if (m_displayedFpsHistory.size() > static_cast<size_t>(kMaxDisplayedFpsSamples))
 		{
 			m_displayedFpsHistory.pop_front();
 		}
@@ -66,24 +74,65 @@ void Game::FPSCalculation()
 	}
 }
 
-void Game::PrintAverageFPS() const
+void Game::PrintFrameTimeReport() const
 {
-	if (m_displayedFpsHistory.empty())
-	{
-		DebuggerPrintf("No FPS data to average.\n");
-		return;
-	}
+	DebuggerPrintf("%s", m_frameTimeTracker.GetReport().c_str());
+}
+
+void Game::PrintPathQueryReport() const
+{
+	DebuggerPrintf("%s", m_pathQueryStats.GetReport().c_str());
+}
+
+void Game::DrainTelemetry()
+{
+	m_drainedTelemetry.clear();
+	Telemetry::DrainAll(m_drainedTelemetry);
 
-	float totalFPS = 0.0f;
-	for (float fps : m_displayedFpsHistory)
+	for (TelemetryRecord const& record : m_drainedTelemetry)
 	{
-		totalFPS += fps;
+		if (record.m_type != TelemetryRecordType::PATH_QUERY) continue;
+
+		NavQueryStats const& queryStats = record.m_queryStats;
+		m_pathQueryStats.RecordQuery(queryStats);
+		int numPathBytes = queryStats.m_numWaypoints * static_cast<int>(sizeof(Vec3));
+
+		if (m_enableTelemetryConsole && g_theConsole) // No dev console in headless runs
+		{
+			g_theConsole->AddLine(Rgba8::RED, Stringf("Generated a path of %i steps (%.1f m) from (%.1f, %.1f, %.1f) to (%.1f, %.1f, %.1f) in %.02f ms on thread %i",
+				queryStats.m_numWaypoints, queryStats.m_pathLength, record.m_startPoint.x, record.m_startPoint.y, record.m_startPoint.z,
+				record.m_goalPoint.x, record.m_goalPoint.y, record.m_goalPoint.z, queryStats.m_msElapsed, record.m_threadIndex));
+			g_theConsole->AddLine(Rgba8::DARK_ORANGE, Stringf("%s search: %i expanded, %i pushed, %i peak open, the path is %i bytes", PathQueryStats::GetSourceName(queryStats.m_source),
+				queryStats.m_search.m_numExpanded, queryStats.m_search.m_numPushed, queryStats.m_search.m_peakOpenSize, numPathBytes));
+		}
+
+		if (m_telemetryFile.is_open())
+		{
+			m_telemetryFile << Stringf("path,%i,%.6f,%.4f,%i,%i,%s,%i,%i,%i,%i,%.3f\n", record.m_threadIndex, record.m_timeSeconds, queryStats.m_msElapsed,
+				queryStats.m_numWaypoints, numPathBytes, PathQueryStats::GetSourceName(queryStats.m_source), queryStats.m_isFound ? 1 : 0,
+				queryStats.m_search.m_numExpanded, queryStats.m_search.m_numPushed, queryStats.m_search.m_peakOpenSize, queryStats.m_pathLength);
+		}
 	}
 
-	float averageFPS = totalFPS / static_cast<float>(m_displayedFpsHistory.size());
+	m_pathQueryStats.EndFrame();
+}
 
-	DebuggerPrintf("=== FPS Test Result ===\n");
-	DebuggerPrintf("Average FPS: %.2f\n", averageFPS);
+bool Game::OpenTelemetryFile(std::string const& filePath)
+{
+	CloseTelemetryFile();
+	m_telemetryFile.open(filePath, std::ios::trunc);
+	if (!m_telemetryFile.is_open()) return false;
+
+	m_telemetryFile << "type,thread,time_seconds,ms_elapsed,path_steps,path_bytes,source,found,nodes_expanded,nodes_pushed,peak_open,path_length_m\n";
+	return true;
+}
+
+void Game::CloseTelemetryFile()
+{
+	if (m_telemetryFile.is_open())
+	{
+		m_telemetryFile.close();
+	}
 }
 
 void Game::RunFrame()
@@ -251,6 +300,26 @@ void Game::RenderFpsAndPlayerPos()
 		}
 	}
 
+	// Tail latency per sliding window, p99 and max turn red once they blow the frame budget
+	if (ImGui::CollapsingHeader("Frame Time (ms)", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		ImGui::Text("        p50     p95     p99     max");
+		for (int windowIndex = 0; windowIndex < FRAME_TIME_NUM_WINDOWS; windowIndex++)
+		{
+			FrameTimeHistogram const& window = m_frameTimeTracker.GetWindow(windowIndex);
+			double p99Seconds = window.GetPercentileSeconds(99.0);
+			double maxSeconds = window.GetMaxSeconds();
+			ImVec4 tailColor = (p99Seconds > FRAME_TIME_BUDGET_SECONDS) ? ImVec4(1.f, 0.2f, 0.2f, 1.f) : ImVec4(0.2f, 1.f, 0.2f, 1.f);
+			ImVec4 maxColor = (maxSeconds > FRAME_TIME_BUDGET_SECONDS) ? ImVec4(1.f, 0.2f, 0.2f, 1.f) : ImVec4(0.2f, 1.f, 0.2f, 1.f);
+
+			ImGui::Text("%3is %7.2f %7.2f", FRAME_TIME_WINDOW_SLICES[windowIndex], 1000.0 * window.GetPercentileSeconds(50.0), 1000.0 * window.GetPercentileSeconds(95.0));
+			ImGui::SameLine(0.f, 0.f);
+			ImGui::TextColored(tailColor, " %7.2f", 1000.0 * p99Seconds);
+			ImGui::SameLine(0.f, 0.f);
+			ImGui::TextColored(maxColor, " %7.2f", 1000.0 * maxSeconds);
+		}
+	}
+
 	// Player Position
 	if (m_player)
 	{
@@ -263,6 +332,247 @@ void Game::RenderFpsAndPlayerPos()
 		ImGui::TextColored(ImVec4(1.f, 0.2f, 0.2f, 1.f), "Player Pos: N/A");
 	}
 
+	// Path Cache
+	if (m_map && m_map->m_navPathCache)
+	{
+		NavPathCache const* pathCache = m_map->m_navPathCache;
+		ImGui::TextColored(ImVec4(1.f, 0.85f, 0.3f, 1.f), "Path Cache:");
+		ImGui::SameLine();
+		ImGui::Text("%llu hits / %llu misses (%i entries)", pathCache->GetNumHits(), pathCache->GetNumMisses(), pathCache->GetNumEntries());
+	}
+
+	unsigned long long numDroppedTelemetry = Telemetry::GetNumDropped();
+	if (numDroppedTelemetry > 0)
+	{
+		ImGui::TextColored(ImVec4(1.f, 0.2f, 0.2f, 1.f), "Telemetry Dropped:");
+		ImGui::SameLine();
+		ImGui::Text("%llu records", numDroppedTelemetry);
+	}
+
+	// Where job latency goes: waiting in the queue, running, or finished but not yet picked up
+	if (ImGui::CollapsingHeader("Jobs"))
+	{
+		ImGui::Text("type           wait   run  ready  wait p99   run p99   lag p99");
+		for (int typeIndex = 0; typeIndex < static_cast<int>(GameJobType::NUM_GAME_JOB_TYPES); typeIndex++)
+		{
+			GameJobType gameJobType = static_cast<GameJobType>(typeIndex);
+			GameJobTypeStats const& typeStats = JobStats::GetTypeStats(gameJobType);
+			if (typeStats.m_numQueued.load(std::memory_order_relaxed) == 0) continue;
+
+			ImGui::Text("%-14s %4i %5i %6i %9.2f %9.2f %9.2f", JobStats::GetGameJobTypeName(gameJobType),
+				typeStats.GetNumWaiting(), typeStats.GetNumRunning(), typeStats.GetNumAwaitingRetrieval(),
+				1000.0 * typeStats.m_waitHistogram.GetPercentileSeconds(99.0), 1000.0 * typeStats.m_runHistogram.GetPercentileSeconds(99.0),
+				1000.0 * typeStats.m_retrievalLagHistogram.GetPercentileSeconds(99.0));
+		}
+
+		int numWorkers = JobStats::GetNumWorkers();
+		for (int workerIndex = 0; workerIndex < numWorkers; workerIndex++)
+		{
+			float busyRatio = JobStats::GetWorkerBusyRatio(workerIndex);
+			ImGui::ProgressBar(busyRatio, ImVec2(300.f, 0.f), Stringf("Worker %i: %.0f%% busy", workerIndex, 100.f * busyRatio).c_str());
+		}
+
+		if (ImGui::Button("Reset Job Stats"))
+		{
+			JobStats::Reset();
+		}
+	}
+
+	// What each A* query cost, per query over the whole run and summed over the last frame that ran any
+	if (ImGui::CollapsingHeader("Path Queries"))
+	{
+		PathQueryFrameTotals const& lastFrame = m_pathQueryStats.m_lastFrame;
+		ImGui::Text("Last frame: %i queries (%i no path), %.2f ms, %.0f expanded, %.0f pushed", lastFrame.m_numQueries, lastFrame.m_numNotFound,
+			lastFrame.m_values[static_cast<int>(PathQueryMetric::MS_ELAPSED)], lastFrame.m_values[static_cast<int>(PathQueryMetric::NODES_EXPANDED)],
+			lastFrame.m_values[static_cast<int>(PathQueryMetric::NODES_PUSHED)]);
+
+		ImGui::Text("metric           p50        p99        max");
+		for (int metricIndex = 0; metricIndex < NUM_PATH_QUERY_METRICS; metricIndex++)
+		{
+			PathQueryMetric metric = static_cast<PathQueryMetric>(metricIndex);
+			ImGui::Text("%-10s %10.2f %10.2f %10.2f", PathQueryStats::GetMetricName(metric), m_pathQueryStats.GetQueryPercentile(metric, 50.0),
+				m_pathQueryStats.GetQueryPercentile(metric, 99.0), m_pathQueryStats.GetQueryMax(metric));
+		}
+
+		for (int sourceIndex = 0; sourceIndex < NUM_NAV_QUERY_SOURCES; sourceIndex++)
+		{
+			if (m_pathQueryStats.m_numQueriesBySource[sourceIndex] == 0) continue;
+
+			ImGui::Text("%-12s %u", PathQueryStats::GetSourceName(static_cast<NavQuerySource>(sourceIndex)), m_pathQueryStats.m_numQueriesBySource[sourceIndex]);
+		}
+
+		if (ImGui::Button("Reset Path Stats"))
+		{
+			m_pathQueryStats.Reset();
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Save Histograms"))
+		{
+			std::error_code errorCode;
+			std::filesystem::create_directories(PROFILER_TRACE_FOLDER, errorCode);
+			std::string histogramPath = std::string(PROFILER_TRACE_FOLDER) + "/PathQueryStats.csv";
+			m_pathQueryStatsStatus = m_pathQueryStats.WriteHistograms(histogramPath) ? "Saved " + histogramPath : "Could not write " + histogramPath;
+		}
+		if (!m_pathQueryStatsStatus.empty())
+		{
+			ImGui::Text("%s", m_pathQueryStatsStatus.c_str());
+		}
+	}
+
+	ImGui::Checkbox("Frame Profiler", &m_enableProfilerView);
+
+	m_profilerViewAnchor = ImVec2(ImGui::GetWindowPos().x + ImGui::GetWindowSize().x + padding.x, ImGui::GetWindowPos().y);
+	ImGui::End();
+
+	ImGui::PopStyleColor(2);
+	ImGui::PopStyleVar(2);
+}
+
+// Same name always gets the same color, hashed from the characters since literals can be duplicated per file
+static ImU32 GetProfileZoneColor(char const* zoneName)
+{
+	unsigned int hash = 2166136261u;
+	for (char const* c = zoneName; *c != '\0'; c++)
+	{
+		hash = (hash ^ static_cast<unsigned char>(*c)) * 16777619u;
+	}
+	return IM_COL32(90 + (hash & 0x7F), 90 + ((hash >> 8) & 0x7F), 90 + ((hash >> 16) & 0x7F), 255);
+}
+
+void Game::RenderProfilerView()
+{
+	if (!m_enableProfilerView) return;
+
+	if (!m_freezeProfilerView)
+	{
+		m_profilerViewZones = Profiler::GetLastFrameZones();
+		m_profilerViewBeginSeconds = Profiler::GetLastFrameBeginSeconds();
+		m_profilerViewEndSeconds = Profiler::GetLastFrameEndSeconds();
+		std::sort(m_profilerViewZones.begin(), m_profilerViewZones.end(), [](ProfileZoneRecord const& a, ProfileZoneRecord const& b)
+			{
+				return (a.m_threadIndex != b.m_threadIndex) ? a.m_threadIndex < b.m_threadIndex : a.m_beginSeconds < b.m_beginSeconds;
+			});
+	}
+
+	ImGui::SetNextWindowPos(m_profilerViewAnchor, ImGuiCond_Always);
+	ImGui::SetNextWindowBgAlpha(0.7f);
+
+	ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.1f, 0.1f, 0.1f, 0.85f));
+	ImGui::PushStyleColor(ImGuiCol_Border, ImVec4(1.f, 1.f, 1.f, 0.5f));
+	ImGui::PushStyleVar(ImGuiStyleVar_WindowBorderSize, 8.f);
+	ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 10.f);
+
+	ImGui::Begin("Frame Profiler", nullptr,
+		ImGuiWindowFlags_NoTitleBar |
+		ImGuiWindowFlags_AlwaysAutoResize |
+		ImGuiWindowFlags_NoMove |
+		ImGuiWindowFlags_NoSavedSettings);
+
+	ImGui::SetWindowFontScale(1.5f);
+
+	double frameSeconds = m_profilerViewEndSeconds - m_profilerViewBeginSeconds;
+	ImGui::TextColored(ImVec4(1.f, 0.85f, 0.3f, 1.f), "Frame:");
+	ImGui::SameLine();
+	ImGui::Text("%.2f ms, %i zones", 1000.0 * frameSeconds, static_cast<int>(m_profilerViewZones.size()));
+
+	ImGui::Checkbox("Freeze", &m_freezeProfilerView);
+	ImGui::SameLine();
+	if (!Profiler::IsCapturing())
+	{
+		if (ImGui::Button("Capture Trace"))
+		{
+			Profiler::BeginCapture();
+			m_profilerStatus.clear();
+		}
+	}
+	else if (ImGui::Button("Save Trace"))
+	{
+		std::error_code errorCode;
+		std::filesystem::create_directories(PROFILER_TRACE_FOLDER, errorCode);
+		std::string tracePath = std::string(PROFILER_TRACE_FOLDER) + "/FrameTrace.json";
+		size_t numZones = Profiler::GetNumCapturedZones();
+		m_profilerStatus = Profiler::EndCapture(tracePath) ? Stringf("Saved %zu zones to %s", numZones, tracePath.c_str()) : "Could not write " + tracePath;
+	}
+
+	if (Profiler::IsCapturing())
+	{
+		ImGui::Text("Capturing: %zu zones", Profiler::GetNumCapturedZones());
+	}
+	else if (!m_profilerStatus.empty())
+	{
+		ImGui::Text("%s", m_profilerStatus.c_str());
+	}
+
+	if (frameSeconds <= 0.0 || m_profilerViewBeginSeconds <= 0.0)
+	{
+		ImGui::Text("No frame recorded yet.");
+	}
+	else
+	{
+		// One strip per thread, one lane per nesting depth. Worker zones that straddle the frame get clipped.
+		float const canvasWidth = 700.f;
+		float const laneHeight = 18.f;
+		float pixelsPerSecond = canvasWidth / static_cast<float>(frameSeconds);
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+		size_t firstZone = 0;
+		while (firstZone < m_profilerViewZones.size())
+		{
+			int threadIndex = m_profilerViewZones[firstZone].m_threadIndex;
+			size_t endZone = firstZone;
+			int maxDepth = 0;
+			while (endZone < m_profilerViewZones.size() && m_profilerViewZones[endZone].m_threadIndex == threadIndex)
+			{
+				maxDepth = std::max(maxDepth, m_profilerViewZones[endZone].m_depth);
+				endZone++;
+			}
+
+			ImGui::Text("%s", Profiler::GetThreadName(threadIndex).c_str());
+			ImVec2 canvasSize = ImVec2(canvasWidth, laneHeight * static_cast<float>(maxDepth + 1));
+			ImVec2 canvasPos = ImGui::GetCursorScreenPos();
+			ImVec2 canvasEnd = canvasPos + canvasSize;
+			drawList->AddRectFilled(canvasPos, canvasEnd, IM_COL32(25, 25, 25, 200), 4.f);
+
+			for (size_t zoneIndex = firstZone; zoneIndex < endZone; zoneIndex++)
+			{
+				ProfileZoneRecord const& zone = m_profilerViewZones[zoneIndex];
+				float x0 = canvasPos.x + pixelsPerSecond * static_cast<float>(zone.m_beginSeconds - m_profilerViewBeginSeconds);
+				float x1 = canvasPos.x + pixelsPerSecond * static_cast<float>(zone.m_endSeconds - m_profilerViewBeginSeconds);
+				x0 = GetClamped(x0, canvasPos.x, canvasEnd.x);
+				x1 = GetClamped(std::max(x1, x0 + 1.f), canvasPos.x, canvasEnd.x);
+				if (x1 <= x0) continue;
+
+				ImVec2 zoneMins = ImVec2(x0, canvasPos.y + laneHeight * static_cast<float>(zone.m_depth));
+				ImVec2 zoneMaxs = ImVec2(x1, zoneMins.y + laneHeight - 1.f);
+				drawList->AddRectFilled(zoneMins, zoneMaxs, GetProfileZoneColor(zone.m_name));
+
+				ImVec2 textSize = ImGui::CalcTextSize(zone.m_name);
+				if (textSize.x + 4.f < x1 - x0)
+				{
+					drawList->PushClipRect(zoneMins, zoneMaxs, true);
+					drawList->AddText(ImVec2(x0 + 2.f, zoneMins.y), IM_COL32(0, 0, 0, 255), zone.m_name);
+					drawList->PopClipRect();
+				}
+
+				if (ImGui::IsMouseHoveringRect(zoneMins, zoneMaxs))
+				{
+					ImGui::SetTooltip("%s\n%.3f ms", zone.m_name, 1000.0 * (zone.m_endSeconds - zone.m_beginSeconds));
+				}
+			}
+
+			ImGui::Dummy(canvasSize); // Reserve space
+			firstZone = endZone;
+		}
+	}
+
+	unsigned long long numDroppedZones = Profiler::GetNumDropped();
+	if (numDroppedZones > 0)
+	{
+		ImGui::TextColored(ImVec4(1.f, 0.2f, 0.2f, 1.f), "Dropped:");
+		ImGui::SameLine();
+		ImGui::Text("%llu zones", numDroppedZones);
+	}
+
 	ImGui::End();
 
 	ImGui::PopStyleColor(2);
@@ -273,6 +583,10 @@ void Game::RenderGameUI()
 {
  	RenderGameTitle();
 	RenderFpsAndPlayerPos();
+
+	// Zones only cost anything while someone looks at them or a trace is being captured
+	Profiler::SetEnabled(m_enableProfilerView || Profiler::IsCapturing());
+	RenderProfilerView();
 }
 
 void Game::RenderDebugKeyWindow()
@@ -309,6 +623,7 @@ void Game::RenderDebugKeyWindow()
 	ImGui::BulletText("Arrow Left/Right - Switch game modes");
 	ImGui::BulletText("O - Step One Frame");
 	ImGui::BulletText("R - Restart current game mode");
+	ImGui::BulletText("B - Toggle nav obstacle under the player");
 	ImGui::BulletText("F11 - Show of Mouse Cursor", m_player->m_debugMouseEnabled ? u8"Enabled" : u8"Disabled");
 
 	if (ImGui::CollapsingHeader("Game Mode Keys", ImGuiTreeNodeFlags_DefaultOpen))
@@ -322,6 +637,7 @@ void Game::RenderDebugKeyWindow()
 		{
 			ImGui::Checkbox("NavMesh (F1)", &m_enableNavMeshVisual);
 			ImGui::Checkbox("Agent Path (F2)", &m_enablePathVisual);
+			ImGui::Checkbox("Incremental Replanning (D* Lite)", &m_gameModeConfig.m_useIncrementalReplanning);
 			
 			if (m_gameModeConfig.m_useORCA)
 			{
@@ -340,6 +656,8 @@ void Game::RenderDebugKeyWindow()
 			ImGui::Checkbox("Show Current Velocity-based Algorithm (F5)", &m_enableCurrentVOAlgorithmVisual);
 		}
 
+		ImGui::Checkbox("Parallel Agent Update", &m_gameModeConfig.m_useParallelAgentUpdate);
+
 		ImGui::PopStyleColor(4);
 	}
 
@@ -352,18 +670,17 @@ void Game::RenderDebugKeyWindow()
 
 float Game::GetGameFPS() const
 {
-	if (m_frameTimes.empty()) return 0.f;
+	// Frames over wall time in the shortest window, which already spans a second or more
+	FrameTimeHistogram const& window = m_frameTimeTracker.GetWindow(0);
+	if (window.GetTotalSeconds() <= 0.0) return 0.f;
+	return static_cast<float>(static_cast<double>(window.GetCount()) / window.GetTotalSeconds());
+}
 
-	float totalTime = 0.f;
-	for (float dt : m_frameTimes)
+float Game::GetDeltaSeconds() const
+{
+	if (m_gameModeConfig.m_fixedDeltaSeconds > 0.f)
 	{
-		totalTime += dt;
+		return m_gameModeConfig.m_fixedDeltaSeconds;
 	}
-
-	float instantFPS = 1.f / (totalTime / m_frameTimes.size());
-
-	static float smoothedFPS = instantFPS;
-	smoothedFPS = smoothedFPS * 0.9f + instantFPS * 0.1f;
-
-	return smoothedFPS;
+	return m_clock->GetDeltaSeconds();
 }
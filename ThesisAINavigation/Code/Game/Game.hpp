@@ -5,11 +5,16 @@
 #include "Game/PlayGround.hpp"
 #include "Game/PlayerActor.hpp"
 #include "Game/ActorDefinitions.hpp"
+#include "Game/Diagnostics/FrameTimeHistogram.hpp"
+#include "Game/Diagnostics/PathQueryStats.hpp"
+#include "Game/Diagnostics/Profiler.hpp"
+#include "Game/Diagnostics/Telemetry.hpp"
 
 #include "Engine/Core/Vertex_PCU.hpp"
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Renderer/Camera.hpp"
 #include "ThirdParty/ImGui/imgui.h"
+#include <fstream>
 #include <string>
 #include <deque>
 
@@ -31,6 +36,23 @@ struct GameModeConfig
 	float m_mountainHeight = 0.f;
 
 	int m_numberOfAgents = 0;
+
+	// All agents follow one shared flow field to a common rally point instead of their own A* paths
+	bool m_useFlowField = false;
+
+	// Agents keep a D* Lite search and repair it when nav triangle costs change instead of replanning
+	bool m_useIncrementalReplanning = false;
+
+	// Navigation modes only keep the nav tiles around agents and the player, see MapConfig
+	bool m_useNavTileStreaming = false;
+	int m_numNavLandmarks = 0; // ALT landmarks, above 0 guides the flat A* fallback and HPA* refinement
+
+	// Steer every agent from the same start-of-frame snapshot on the JobSystem, then integrate
+	bool m_useParallelAgentUpdate = false;
+
+	// Headless runs skip every renderer, window and ImGui call and step the sim at a fixed dt
+	bool m_isHeadless = false;
+	float m_fixedDeltaSeconds = 0.f;
 };
 
 class Game
@@ -43,18 +65,26 @@ public:
 	virtual void CreateSky();
 	virtual void CreateSkyBuffers();
 	virtual void FPSCalculation();
-	virtual void PrintAverageFPS() const;
+	virtual void PrintFrameTimeReport() const;
+	void PrintPathQueryReport() const;
 
 	virtual void Shutdown() = 0;
 	void RunFrame();
 	virtual void RenderSkyBox() const;
 	void RenderGameTitle() const;
 	void RenderFpsAndPlayerPos();
+	void RenderProfilerView();
 	virtual void RenderGameUI();
 	virtual void RenderDebugKeyWindow();
 	virtual void Render() = 0;
 	virtual void UpdateGameMode() = 0;
 	float GetGameFPS() const;
+	float GetDeltaSeconds() const;
+
+	// Main thread, once per frame: empties every thread's telemetry ring into the enabled sinks
+	void DrainTelemetry();
+	bool OpenTelemetryFile(std::string const& filePath);
+	void CloseTelemetryFile();
 
 public:
 	GameModeConfig m_gameModeConfig;
@@ -76,8 +106,9 @@ public:
 	std::vector<Vertex_PCU> m_skyVertices;
 
 public:
-	std::deque<float> m_frameTimes; // Store last N frame times
-	size_t m_maxFrameSamples = 60; // Limit to 60 samples
+	// Wall time between FPSCalculation calls, so paused or scaled game clocks do not hide stalls
+	FrameTimeTracker m_frameTimeTracker;
+	double m_lastFrameTimeSeconds = 0.0;
 
 	float m_fpsUpdateTimer = 0.f;
 	float m_smoothedFps = 60.f;
@@ -95,6 +126,22 @@ public:
 	
 	// Randomly selects an agent and shows their path 
 	bool m_enablePathVisual = false;
+
+	// -------------------------Telemetry---------------------------
+	bool m_enableTelemetryConsole = true;
+	std::ofstream m_telemetryFile; // CSV, one row per record
+	std::vector<TelemetryRecord> m_drainedTelemetry;
+	PathQueryStats m_pathQueryStats;
+	std::string m_pathQueryStatsStatus;
+
+	// ----------------------Frame Profiler-------------------------
+	bool m_enableProfilerView = false;
+	bool m_freezeProfilerView = false;
+	ImVec2 m_profilerViewAnchor = ImVec2(0.f, 0.f); // Right of the Game Info panel, set every frame it renders
+	std::vector<ProfileZoneRecord> m_profilerViewZones; // Sorted by thread, then begin time
+	double m_profilerViewBeginSeconds = 0.0;
+	double m_profilerViewEndSeconds = 0.0;
+	std::string m_profilerStatus;
 	
 	// ------------Obstacle Avoidance Mode only---------------------
 	bool m_enableFOVZoneVisual = false;
@@ -14,21 +14,24 @@ NavigationMode::NavigationMode(GameModeConfig const& config)
 
 void NavigationMode::Startup()
 {
-	m_uiScreenView = new Camera();
-	m_uiScreenView->SetOrthoView(Vec2(0.f, 0.f), Vec2((float)g_theWindow->GetClientDimensions().x, (float)g_theWindow->GetClientDimensions().y));
+	ActorDefinition::InitializeActorDef();
 
-	g_bitmapFont = g_theRenderer->CreateOrGetBitmapFont("Data/Fonts/SquirrelFixedFont.png");
+	if (!m_gameModeConfig.m_isHeadless)
+	{
+		m_uiScreenView = new Camera();
+		m_uiScreenView->SetOrthoView(Vec2(0.f, 0.f), Vec2((float)g_theWindow->GetClientDimensions().x, (float)g_theWindow->GetClientDimensions().y));
 
-	g_theRenderer->SetDepthMode(DepthMode::ENABLED);
-	g_theRenderer->SetRasterizerState(RasterizerMode::SOLID_CULL_NONE);
-	g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
+		g_bitmapFont = g_theRenderer->CreateOrGetBitmapFont("Data/Fonts/SquirrelFixedFont.png");
 
-	ActorDefinition::InitializeActorDef();
+		g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+		g_theRenderer->SetRasterizerState(RasterizerMode::SOLID_CULL_NONE);
+		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
 
-	CreateSky();
-	CreateSkyBuffers();
+		CreateSky();
+		CreateSkyBuffers();
 
-	m_player = new PlayerActor(this, Vec3(0.f, 0.f, 10.f), EulerAngles(0.f, 90.f, 0.f));
+		m_player = new PlayerActor(this, Vec3(0.f, 0.f, 10.f), EulerAngles(0.f, 90.f, 0.f));
+	}
 
 	MapConfig astarModeConfig;
 	astarModeConfig.m_groundHeightThreshold = m_gameModeConfig.m_groundHeight;
@@ -36,14 +39,20 @@ void NavigationMode::Startup()
 	astarModeConfig.m_mountainHeightThreshold = m_gameModeConfig.m_mountainHeight;
 	astarModeConfig.m_terrainWidthDimension = m_gameModeConfig.m_terrianDimensions.x;
 	astarModeConfig.m_terrainHeightDimension = m_gameModeConfig.m_terrianDimensions.y;
+	astarModeConfig.m_useNavTileStreaming = m_gameModeConfig.m_useNavTileStreaming;
+	astarModeConfig.m_numNavLandmarks = m_gameModeConfig.m_numNavLandmarks;
 	m_map = new Map(this, astarModeConfig, m_gameModeConfig.m_numberOfAgents);
 }
 
 void NavigationMode::UpdateGameMode()
 {
 	FPSCalculation();
-	m_player->Update();
+	if (m_player)
+	{
+		m_player->Update();
+	}
 	m_map->MapUpdate();
+	DrainTelemetry();
 }
 
 void NavigationMode::Render()
@@ -67,7 +76,11 @@ void NavigationMode::Render()
 
 void NavigationMode::Shutdown()
 {
+	PrintFrameTimeReport();
 	SafeDelete(m_map);
+	DrainTelemetry();
+	PrintPathQueryReport();
+	CloseTelemetryFile();
 	m_skyIndexes.clear();
 	m_skyVertices.clear();
 	SafeDelete(m_skyIndexBuffer);
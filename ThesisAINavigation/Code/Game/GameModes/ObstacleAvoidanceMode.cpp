@@ -101,21 +101,24 @@ void ObstacleAvoidanceMode::GenerateSpawnInfosForCurrentMode(std::vector<PlayGro
 
 void ObstacleAvoidanceMode::Startup()
 {
-	m_uiScreenView = new Camera();
-	m_uiScreenView->SetOrthoView(Vec2(0.f, 0.f), Vec2((float)g_theWindow->GetClientDimensions().x, (float)g_theWindow->GetClientDimensions().y));
+	if (!m_gameModeConfig.m_isHeadless)
+	{
+		m_uiScreenView = new Camera();
+		m_uiScreenView->SetOrthoView(Vec2(0.f, 0.f), Vec2((float)g_theWindow->GetClientDimensions().x, (float)g_theWindow->GetClientDimensions().y));
 
-	g_bitmapFont = g_theRenderer->CreateOrGetBitmapFont("Data/Fonts/SquirrelFixedFont.png");
+		g_bitmapFont = g_theRenderer->CreateOrGetBitmapFont("Data/Fonts/SquirrelFixedFont.png");
 
-	g_theRenderer->SetDepthMode(DepthMode::ENABLED);
-	g_theRenderer->SetRasterizerState(RasterizerMode::SOLID_CULL_NONE);
-	g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
+		g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+		g_theRenderer->SetRasterizerState(RasterizerMode::SOLID_CULL_NONE);
+		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
 
-	CreateSky();
-	CreateSkyBuffers();
+		CreateSky();
+		CreateSkyBuffers();
 
-	ActorDefinition::InitializeActorDef();
+		m_player = new PlayerActor(this, Vec3(0.f, 0.f, 10.f), EulerAngles(0.f, 90.f, 0.f));
+	}
 
-	m_player = new PlayerActor(this, Vec3(0.f, 0.f, 10.f), EulerAngles(0.f, 90.f, 0.f));
+	ActorDefinition::InitializeActorDef();
 
 	ActorDefinition* agentDef = ActorDefinition::GetActorDefByName("Agent");
 	if (!agentDef)
@@ -131,7 +134,10 @@ void ObstacleAvoidanceMode::Startup()
 void ObstacleAvoidanceMode::UpdateGameMode()
 {
 	FPSCalculation();
-	m_player->Update();
+	if (m_player)
+	{
+		m_player->Update();
+	}
 	m_playGround->PlayGroundUpdate();
 }
 
@@ -156,6 +162,7 @@ void ObstacleAvoidanceMode::Render()
 
 void ObstacleAvoidanceMode::Shutdown()
 {
+	PrintFrameTimeReport();
 	SafeDelete(m_playGround);
 	m_skyIndexes.clear();
 	m_skyVertices.clear();
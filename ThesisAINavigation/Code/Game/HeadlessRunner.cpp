@@ -0,0 +1,528 @@
+#include "Game/HeadlessRunner.hpp"
+#include "Game/Game.hpp"
+#include "Game/Map.hpp"
+#include "Game/PlayGround.hpp"
+#include "Game/Diagnostics/JobStats.hpp"
+#include "Game/Diagnostics/Profiler.hpp"
+#include "Game/GameModes/NavigationMode.hpp"
+#include "Game/GameModes/ObstacleAvoidanceMode.hpp"
+#include "Game/Navigation/NavBenchmark.hpp"
+#include "Game/Tests/SelfTests.hpp"
+
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+constexpr int HEADLESS_OBSTACLE_MOVE_TICKS = 60;
+
+static IntVec2 ParseDimensions(std::string const& value)
+{
+	size_t xPos = value.find('x');
+	int width = std::stoi(value.substr(0, xPos));
+	int height = (xPos == std::string::npos) ? width : std::stoi(value.substr(xPos + 1));
+	return IntVec2(width, height);
+}
+
+HeadlessRunner::HeadlessRunner(HeadlessRunConfig const& config)
+	: m_config(config)
+{
+}
+
+bool HeadlessRunner::ParseCommandLine(int argc, char** argv, HeadlessRunConfig& out_config)
+{
+	for (int argIndex = 1; argIndex < argc; argIndex++)
+	{
+		std::string arg = argv[argIndex];
+		if (arg == "quiet")
+		{
+			out_config.m_printEveryTick = false;
+			continue;
+		}
+
+		if (arg == "parallel")
+		{
+			out_config.m_useParallelAgentUpdate = true;
+			continue;
+		}
+
+		if (arg == "streaming")
+		{
+			out_config.m_useNavTileStreaming = true;
+			continue;
+		}
+
+		if (arg == "replanning")
+		{
+			out_config.m_useIncrementalReplanning = true;
+			continue;
+		}
+
+		if (arg == "selftest")
+		{
+			out_config.m_runSelfTests = true;
+			continue;
+		}
+
+		size_t equalsPos = arg.find('=');
+		if (equalsPos == std::string::npos)
+		{
+			printf("Unknown argument '%s'\n", arg.c_str());
+			return false;
+		}
+
+		std::string key = arg.substr(0, equalsPos);
+		std::string value = arg.substr(equalsPos + 1);
+
+		try
+		{
+			if (key == "mode")
+			{
+				int mode = -1;
+				for (int i = 0; i < static_cast<int>(GameModeType::NUM_GAME_MODES); i++)
+				{
+					if (App::GetGameModeNameByString(static_cast<GameModeType>(i)) == value)
+					{
+						mode = i;
+						break;
+					}
+				}
+
+				if (mode == -1)
+				{
+					mode = std::stoi(value);
+				}
+
+				if (mode < 0 || mode >= static_cast<int>(GameModeType::NUM_GAME_MODES))
+				{
+					printf("Mode out of valid range: %d\n", mode);
+					return false;
+				}
+				out_config.m_gameModeType = static_cast<GameModeType>(mode);
+			}
+			else if (key == "ticks")
+			{
+				out_config.m_numTicks = std::stoi(value);
+			}
+			else if (key == "dt")
+			{
+				out_config.m_fixedDeltaSeconds = std::stof(value);
+			}
+			else if (key == "agents")
+			{
+				out_config.m_numberOfAgents = std::stoi(value);
+			}
+			else if (key == "size")
+			{
+				out_config.m_terrainDimensions = ParseDimensions(value);
+			}
+			else if (key == "workers")
+			{
+				out_config.m_numWorkers = std::stoi(value);
+			}
+			else if (key == "telemetry")
+			{
+				out_config.m_telemetryFilePath = value;
+			}
+			else if (key == "trace")
+			{
+				out_config.m_traceFilePath = value;
+			}
+			else if (key == "pathstats")
+			{
+				out_config.m_pathStatsFilePath = value;
+			}
+			else if (key == "landmarks")
+			{
+				out_config.m_numNavLandmarks = std::stoi(value);
+			}
+			else if (key == "obstacles")
+			{
+				out_config.m_numNavObstacles = std::stoi(value);
+			}
+			else if (key == "navbench")
+			{
+				out_config.m_navBenchmarkDimensions = ParseDimensions(value);
+			}
+			else if (key == "queries")
+			{
+				out_config.m_numBenchmarkQueries = std::stoi(value);
+			}
+			else if (key == "scenario")
+			{
+				out_config.m_scenarioFilePath = value;
+			}
+			else
+			{
+				printf("Unknown argument '%s'\n", arg.c_str());
+				return false;
+			}
+		}
+		catch (...)
+		{
+			printf("Invalid value in argument '%s'\n", arg.c_str());
+			return false;
+		}
+	}
+
+	return out_config.m_numTicks > 0 && out_config.m_fixedDeltaSeconds > 0.f && out_config.m_numBenchmarkQueries > 0;
+}
+
+void HeadlessRunner::PrintUsage()
+{
+	printf("Usage: ThesisAINavigation_Headless [mode=<index|name>] [ticks=<count>] [dt=<seconds>] [agents=<count>] [size=<w>x<h>] [workers=<count>] [telemetry=<csv path>] [trace=<json path>] [pathstats=<csv path>] [landmarks=<count>] [obstacles=<count>] [parallel] [streaming] [replanning] [quiet]\n");
+	printf("       ThesisAINavigation_Headless navbench=<w>x<h> [queries=<count>]\n");
+	printf("       ThesisAINavigation_Headless selftest\n");
+	printf("       ThesisAINavigation_Headless scenario=<file>\n");
+	printf("Game Modes:\n");
+	for (int i = 0; i < static_cast<int>(GameModeType::NUM_GAME_MODES); i++)
+	{
+		printf("  %d: %s\n", i, App::GetGameModeNameByString(static_cast<GameModeType>(i)).c_str());
+	}
+}
+
+bool HeadlessRunner::LoadScenario(std::string const& filePath, HeadlessRunConfig& out_config, std::vector<std::string>& out_expectedLines)
+{
+	std::ifstream scenarioFile(filePath);
+	if (!scenarioFile.is_open())
+	{
+		printf("Could not open scenario file '%s'\n", filePath.c_str());
+		return false;
+	}
+
+	std::string const argsPrefix = "args:";
+	std::string const expectPrefix = "expect: ";
+	bool hasArgs = false;
+
+	std::string line;
+	while (std::getline(scenarioFile, line))
+	{
+		if (!line.empty() && line.back() == '\r')
+		{
+			line.pop_back();
+		}
+
+		if (line.compare(0, argsPrefix.size(), argsPrefix) == 0)
+		{
+			// Parsed exactly like a command line, argv[0] included
+			std::vector<std::string> args = { filePath };
+			std::istringstream argStream(line.substr(argsPrefix.size()));
+			std::string arg;
+			while (argStream >> arg)
+			{
+				args.emplace_back(arg);
+			}
+
+			std::vector<char*> argv;
+			for (std::string& scenarioArg : args)
+			{
+				argv.emplace_back(&scenarioArg[0]);
+			}
+
+			HeadlessRunConfig scenarioConfig;
+			if (!ParseCommandLine(static_cast<int>(argv.size()), argv.data(), scenarioConfig) || scenarioConfig.m_runSelfTests || !scenarioConfig.m_scenarioFilePath.empty())
+			{
+				printf("Invalid args line in scenario file '%s'\n", filePath.c_str());
+				return false;
+			}
+			out_config = scenarioConfig;
+			hasArgs = true;
+		}
+		else if (line.compare(0, expectPrefix.size(), expectPrefix) == 0)
+		{
+			out_expectedLines.emplace_back(line.substr(expectPrefix.size()));
+		}
+	}
+
+	if (!hasArgs)
+	{
+		printf("Scenario file '%s' has no args line\n", filePath.c_str());
+	}
+	return hasArgs;
+}
+
+bool HeadlessRunner::CheckExpectedLines(std::string const& output, std::vector<std::string> const& expectedLines)
+{
+	int numMissing = 0;
+	for (std::string const& expectedLine : expectedLines)
+	{
+		if (output.find(expectedLine) == std::string::npos)
+		{
+			printf("MISSING: %s\n", expectedLine.c_str());
+			numMissing++;
+		}
+	}
+
+	if (!expectedLines.empty())
+	{
+		printf("=== Scenario ===\n%d of %d expected lines found\n", static_cast<int>(expectedLines.size()) - numMissing, static_cast<int>(expectedLines.size()));
+	}
+	return numMissing == 0;
+}
+
+int HeadlessRunner::RunSelfTests(HeadlessRunConfig const& config)
+{
+	// The landmark builds queue their Dijkstras as game jobs
+	JobSystemConfig jobSystemConfig;
+	jobSystemConfig.m_numWorkers = config.m_numWorkers;
+	g_theJobSystem = new JobSystem(jobSystemConfig);
+	g_theJobSystem->Startup();
+
+	int numFailures = SelfTests::RunAll();
+
+	g_theJobSystem->ShutDown();
+	SafeDelete(g_theJobSystem);
+	return numFailures;
+}
+
+std::string HeadlessRunner::RunNavBenchmark(HeadlessRunConfig const& config)
+{
+	NavBenchmarkConfig benchmarkConfig;
+	benchmarkConfig.m_gridDimensions = config.m_navBenchmarkDimensions;
+	benchmarkConfig.m_numQueries = config.m_numBenchmarkQueries;
+
+	printf("Nav benchmark: %dx%d grid, %d queries\n", benchmarkConfig.m_gridDimensions.x, benchmarkConfig.m_gridDimensions.y, benchmarkConfig.m_numQueries);
+	NavBenchmarkResult result = NavBenchmark::Run(benchmarkConfig);
+	std::string report = NavBenchmark::GetReport(benchmarkConfig, result);
+	printf("%s", report.c_str());
+	return report;
+}
+
+void HeadlessRunner::Startup()
+{
+	Profiler::SetCurrentThreadName("Main");
+
+	JobSystemConfig jobSystemConfig;
+	jobSystemConfig.m_numWorkers = m_config.m_numWorkers;
+	g_theJobSystem = new JobSystem(jobSystemConfig);
+	g_theJobSystem->Startup();
+
+	GameModeConfig gameModeConfig = App::GetGameModeConfig(m_config.m_gameModeType);
+	gameModeConfig.m_isHeadless = true;
+	gameModeConfig.m_fixedDeltaSeconds = m_config.m_fixedDeltaSeconds;
+	gameModeConfig.m_useParallelAgentUpdate = m_config.m_useParallelAgentUpdate;
+
+	// Agent, terrain and nav graph overrides only apply to the navmesh modes, playground modes use fixed formations
+	if (gameModeConfig.m_useAStar)
+	{
+		gameModeConfig.m_useNavTileStreaming = m_config.m_useNavTileStreaming;
+		gameModeConfig.m_numNavLandmarks = std::max(m_config.m_numNavLandmarks, 0);
+		gameModeConfig.m_useIncrementalReplanning = m_config.m_useIncrementalReplanning;
+
+		if (m_config.m_numberOfAgents > 0)
+		{
+			gameModeConfig.m_numberOfAgents = m_config.m_numberOfAgents;
+		}
+
+		if (m_config.m_terrainDimensions.x > 0 && m_config.m_terrainDimensions.y > 0)
+		{
+			gameModeConfig.m_terrianDimensions = m_config.m_terrainDimensions;
+		}
+	}
+
+	char description[320];
+	snprintf(description, sizeof(description), "Headless run: %s, %d agents, %dx%d terrain, %d ticks at dt %.4f, %s agent update, %s nav graph, %d landmarks, %s replanning, %d obstacles\n",
+		App::GetGameModeNameByString(m_config.m_gameModeType).c_str(), gameModeConfig.m_numberOfAgents,
+		gameModeConfig.m_terrianDimensions.x, gameModeConfig.m_terrianDimensions.y, m_config.m_numTicks, m_config.m_fixedDeltaSeconds,
+		m_config.m_useParallelAgentUpdate ? "parallel" : "serial", gameModeConfig.m_useNavTileStreaming ? "streamed" : "full", gameModeConfig.m_numNavLandmarks,
+		gameModeConfig.m_useIncrementalReplanning ? "D* Lite" : "no", std::max(m_config.m_numNavObstacles, 0));
+	printf("%s", description);
+	m_report = description;
+
+	double timeBefore = GetCurrentTimeSeconds();
+
+	if (gameModeConfig.m_useAStar)
+	{
+		m_game = new NavigationMode(gameModeConfig);
+	}
+	else
+	{
+		m_game = new ObstacleAvoidanceMode(gameModeConfig);
+	}
+	m_game->Startup();
+
+	if (!m_config.m_telemetryFilePath.empty() && !m_game->OpenTelemetryFile(m_config.m_telemetryFilePath))
+	{
+		printf("Could not open telemetry file '%s'\n", m_config.m_telemetryFilePath.c_str());
+	}
+
+	m_startupSeconds = GetCurrentTimeSeconds() - timeBefore;
+	printf("Startup (terrain, navmesh, agents): %.2f ms\n", 1000.0 * m_startupSeconds);
+
+	m_tickMilliseconds.reserve(m_config.m_numTicks);
+}
+
+void HeadlessRunner::Run()
+{
+	// Startup's tile and landmark builds would swamp the per-tick job latencies
+	JobStats::Reset();
+	m_game->m_pathQueryStats.Reset();
+
+	bool isTracing = !m_config.m_traceFilePath.empty();
+	if (isTracing)
+	{
+		Profiler::SetEnabled(true);
+		Profiler::BeginCapture();
+	}
+
+	for (int tick = 0; tick < m_config.m_numTicks; tick++)
+	{
+		Profiler::BeginFrame();
+		g_theJobSystem->BeginFrame();
+
+		double timeBefore = GetCurrentTimeSeconds();
+		{
+			PROFILE_ZONE("HeadlessRunner::Tick");
+			UpdateNavObstacles(tick);
+			m_game->UpdateGameMode();
+		}
+		double timeAfter = GetCurrentTimeSeconds();
+
+		g_theJobSystem->EndFrame();
+
+		double msElapsed = 1000.0 * (timeAfter - timeBefore);
+		m_tickMilliseconds.emplace_back(msElapsed);
+
+		if (m_config.m_printEveryTick)
+		{
+			printf("tick %6d: %8.3f ms\n", tick, msElapsed);
+		}
+	}
+
+	if (isTracing)
+	{
+		// One more drain picks up the last tick's zones
+		Profiler::BeginFrame();
+		size_t numZones = Profiler::GetNumCapturedZones();
+		if (Profiler::EndCapture(m_config.m_traceFilePath))
+		{
+			printf("Trace: %zu zones written to %s (%llu dropped)\n", numZones, m_config.m_traceFilePath.c_str(), Profiler::GetNumDropped());
+		}
+		else
+		{
+			printf("Could not write trace file '%s'\n", m_config.m_traceFilePath.c_str());
+		}
+		Profiler::SetEnabled(false);
+	}
+
+	if (!m_config.m_pathStatsFilePath.empty())
+	{
+		if (m_game->m_pathQueryStats.WriteHistograms(m_config.m_pathStatsFilePath))
+		{
+			printf("Path stats: histograms written to %s\n", m_config.m_pathStatsFilePath.c_str());
+		}
+		else
+		{
+			printf("Could not write path stats file '%s'\n", m_config.m_pathStatsFilePath.c_str());
+		}
+	}
+
+	std::string summary = GetSummary();
+	printf("%s", summary.c_str());
+	m_report += summary;
+}
+
+void HeadlessRunner::Shutdown()
+{
+	// Same order as App::Shutdown. The map waits for its in-flight nav jobs and hands out their
+	// completions, which needs running workers, then the game drains the telemetry rings and closes the file
+	if (m_game)
+	{
+		m_game->Shutdown();
+		SafeDelete(m_game);
+	}
+
+	g_theJobSystem->ShutDown();
+	SafeDelete(g_theJobSystem);
+}
+
+void HeadlessRunner::UpdateNavObstacles(int tick)
+{
+	// Stands in for the player's B key. Moving one obstacle at a time raises and lowers costs all run long.
+	Map* map = m_game->m_map;
+	if (map == nullptr || m_config.m_numNavObstacles <= 0 || (tick % HEADLESS_OBSTACLE_MOVE_TICKS) != 0) return;
+
+	if (static_cast<int>(m_navObstaclePositions.size()) >= m_config.m_numNavObstacles)
+	{
+		map->ToggleNavObstacle(m_navObstaclePositions.front());
+		m_navObstaclePositions.erase(m_navObstaclePositions.begin());
+		m_numNavObstacleToggles++;
+	}
+
+	// A toggle inside another obstacle would pick that one up instead of placing a new one
+	float const minSpacingSq = 4.f * NAV_OBSTACLE_RADIUS * NAV_OBSTACLE_RADIUS;
+	for (int attempt = 0; attempt < 10; attempt++)
+	{
+		Vec3 position = map->GetRandomNavPoint();
+		bool isOverlapping = std::any_of(m_navObstaclePositions.begin(), m_navObstaclePositions.end(),
+			[&](Vec3 const& other)
+			{
+				float dx = other.x - position.x;
+				float dy = other.y - position.y;
+				return (dx * dx) + (dy * dy) < minSpacingSq;
+			});
+		if (isOverlapping) continue;
+
+		map->ToggleNavObstacle(position);
+		m_navObstaclePositions.emplace_back(position);
+		m_numNavObstacleToggles++;
+		return;
+	}
+}
+
+std::string HeadlessRunner::GetSummary() const
+{
+	if (m_tickMilliseconds.empty()) return std::string();
+
+	std::vector<double> sortedMilliseconds = m_tickMilliseconds;
+	std::sort(sortedMilliseconds.begin(), sortedMilliseconds.end());
+
+	double totalMilliseconds = 0.0;
+	for (double ms : sortedMilliseconds)
+	{
+		totalMilliseconds += ms;
+	}
+
+	size_t numAgents = 0;
+	if (m_game->m_map)
+	{
+		numAgents = m_game->m_map->GetAllAgents().size();
+	}
+	else if (m_game->m_playGround)
+	{
+		numAgents = m_game->m_playGround->GetAllAgents().size();
+	}
+
+	double averageMilliseconds = totalMilliseconds / static_cast<double>(sortedMilliseconds.size());
+
+	std::string summary = "=== Headless Run Result ===\n";
+	char line[160];
+	snprintf(line, sizeof(line), "Agents:       %zu\n", numAgents);
+	summary += line;
+	snprintf(line, sizeof(line), "Ticks:        %zu\n", sortedMilliseconds.size());
+	summary += line;
+	snprintf(line, sizeof(line), "Total:        %.2f ms\n", totalMilliseconds);
+	summary += line;
+	snprintf(line, sizeof(line), "Min / Median: %.3f / %.3f ms\n", sortedMilliseconds.front(), sortedMilliseconds[sortedMilliseconds.size() / 2]);
+	summary += line;
+	snprintf(line, sizeof(line), "Avg / Max:    %.3f / %.3f ms\n", averageMilliseconds, sortedMilliseconds.back());
+	summary += line;
+	snprintf(line, sizeof(line), "Ticks/sec:    %.1f\n", averageMilliseconds > 0.0 ? 1000.0 / averageMilliseconds : 0.0);
+	summary += line;
+	if (m_config.m_numNavObstacles > 0 && m_game->m_map)
+	{
+		// Toggles land once no nav job is in flight, so the count on the map shows they were all applied
+		snprintf(line, sizeof(line), "Obstacles:    %zu on the map after %d toggles, %s\n", m_game->m_map->m_navObstacles.size(), m_numNavObstacleToggles,
+			m_game->m_map->IsNavChangePending() ? "some still pending" : "none pending");
+		summary += line;
+	}
+	summary += m_game->m_frameTimeTracker.GetReport();
+	summary += JobStats::GetReport();
+	summary += m_game->m_pathQueryStats.GetReport();
+	return summary;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "Game/App.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <string>
+#include <vector>
+
+class Game;
+
+//------------------------------------------------------------------------------------------------
+// Command line: mode=<index|name> ticks=<count> dt=<seconds> agents=<count> size=<w>x<h> workers=<count> telemetry=<csv path> trace=<json path> pathstats=<csv path> landmarks=<count> obstacles=<count> parallel streaming replanning quiet
+// or: navbench=<w>x<h> queries=<count>, which times flat and HPA* corridor queries on a synthetic grid instead
+// or: selftest, which runs the unit checks in Game/Tests
+// or: scenario=<file>, which takes the arguments from the file's "args:" line and fails unless every
+//     "expect:" line shows up in the run's description and summary
+struct HeadlessRunConfig
+{
+	GameModeType m_gameModeType = GameModeType::ASTAR_ORCA_MULTIAGENT_MODE;
+	int m_numTicks = 1000;
+	float m_fixedDeltaSeconds = 1.f / 60.f;
+
+	// Zero keeps whatever the game mode config uses
+	int m_numberOfAgents = 0;
+	IntVec2 m_terrainDimensions = IntVec2::ZERO;
+
+	int m_numWorkers = -1;
+	bool m_useParallelAgentUpdate = false;
+	bool m_useNavTileStreaming = false;
+	int m_numNavLandmarks = 0;
+	bool m_useIncrementalReplanning = false;
+	int m_numNavObstacles = 0; // Nav obstacles kept on random walkable points, one of them moves every HEADLESS_OBSTACLE_MOVE_TICKS
+	bool m_printEveryTick = true;
+
+	std::string m_telemetryFilePath; // Empty writes no telemetry file
+	std::string m_traceFilePath; // Empty records no profiler zones
+	std::string m_pathStatsFilePath; // Empty writes no path query histograms
+
+	IntVec2 m_navBenchmarkDimensions = IntVec2::ZERO; // Nonzero runs NavBenchmark instead of a game mode
+	int m_numBenchmarkQueries = 100;
+
+	bool m_runSelfTests = false;
+	std::string m_scenarioFilePath;
+};
+
+//------------------------------------------------------------------------------------------------
+// Builds a game mode with no window, renderer, input or ImGui and steps it a fixed number of ticks
+class HeadlessRunner
+{
+public:
+	HeadlessRunner(HeadlessRunConfig const& config);
+	~HeadlessRunner() = default;
+
+	static bool ParseCommandLine(int argc, char** argv, HeadlessRunConfig& out_config);
+	static void PrintUsage();
+	static bool LoadScenario(std::string const& filePath, HeadlessRunConfig& out_config, std::vector<std::string>& out_expectedLines);
+	static bool CheckExpectedLines(std::string const& output, std::vector<std::string> const& expectedLines);
+	static int RunSelfTests(HeadlessRunConfig const& config);
+	static std::string RunNavBenchmark(HeadlessRunConfig const& config);
+
+	void Startup();
+	void Run();
+	void Shutdown();
+
+	void UpdateNavObstacles(int tick);
+	std::string GetSummary() const;
+
+public:
+	HeadlessRunConfig m_config;
+	Game* m_game = nullptr;
+
+	double m_startupSeconds = 0.0;
+	std::vector<double> m_tickMilliseconds;
+	std::vector<Vec3> m_navObstaclePositions; // Oldest first, the next one to be picked up and moved
+	int m_numNavObstacleToggles = 0;
+	std::string m_report; // The description line and the summary, what scenario checks look at
+};
@@ -0,0 +1,106 @@
+#include "Game/JobCompletionDispatcher.hpp"
+#include "Game/ActorSlotMap.hpp"
+#include "Game/Diagnostics/JobStats.hpp"
+#include "Game/Diagnostics/Profiler.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <mutex>
+#include <unordered_set>
+
+constexpr int MAX_JOBS_PER_RETRIEVE = 20;
+
+// Every GameJob between QueueGameJob and its dispatch. Jobs are queued from workers too, so the set
+// is locked; it is only touched once on queue and once on dispatch.
+static std::mutex s_queuedGameJobsMutex;
+static std::unordered_set<Job const*> s_queuedGameJobs;
+
+// Removes the job from the record, false when it was not a queued game job (or was dispatched already)
+static bool TakeQueuedGameJob(Job const* job)
+{
+	std::lock_guard<std::mutex> lock(s_queuedGameJobsMutex);
+	return s_queuedGameJobs.erase(job) > 0;
+}
+
+void GameJob::Execute()
+{
+	JobStats::OnStarted(*this);
+	ExecuteGameJob();
+	JobStats::OnFinished(*this);
+	m_state = JobStatus::COMPLETED;
+}
+
+void QueueGameJob(GameJob* job)
+{
+	{
+		std::lock_guard<std::mutex> lock(s_queuedGameJobsMutex);
+		s_queuedGameJobs.insert(job);
+	}
+	JobStats::OnQueued(*job);
+	g_theJobSystem->QueueJob(job);
+}
+
+void JobCompletionDispatcher::SetCallback(GameJobType gameJobType, JobCompletionCallback callback)
+{
+	GUARANTEE_OR_DIE(gameJobType < GameJobType::NUM_GAME_JOB_TYPES, "Invalid game job type");
+	m_callbacks[static_cast<int>(gameJobType)] = callback;
+}
+
+void JobCompletionDispatcher::DispatchCompletedJobs(ActorSlotMap const& actors)
+{
+	PROFILE_ZONE("JobCompletionDispatcher::DispatchCompletedJobs");
+	JobStats::Update();
+	m_completedJobs.clear();
+
+	// Drain everything that finished since last frame in one go
+	for (;;)
+	{
+		m_retrievedJobs.clear();
+		g_theJobSystem->RetrieveCompletedJobs(m_retrievedJobs, MAX_JOBS_PER_RETRIEVE);
+		if (m_retrievedJobs.empty()) break;
+
+		m_completedJobs.insert(m_completedJobs.end(), m_retrievedJobs.begin(), m_retrievedJobs.end());
+	}
+
+	for (Job* completedJob : m_completedJobs)
+	{
+		if (!TakeQueuedGameJob(completedJob))
+		{
+			m_numForeignJobs++;
+			if (m_foreignJobCallback)
+			{
+				m_foreignJobCallback(completedJob);
+			}
+			else
+			{
+				GUARANTEE_RECOVERABLE(false, "Completed job was not queued through QueueGameJob and has no owner, deleting it");
+				delete completedJob;
+			}
+			continue;
+		}
+
+		GameJob* gameJob = static_cast<GameJob*>(completedJob);
+		JobStats::OnRetrieved(*gameJob);
+
+		Actor* requester = nullptr;
+		bool isStale = false;
+		if (gameJob->m_requesterUID.IsValid())
+		{
+			requester = actors.GetActor(gameJob->m_requesterUID);
+			isStale = (requester == nullptr);
+		}
+
+		JobCompletionCallback callback = m_callbacks[static_cast<int>(gameJob->m_gameJobType)];
+		if (isStale)
+		{
+			m_numDroppedJobs++;
+		}
+		else if (callback)
+		{
+			callback(gameJob, requester);
+			m_numDispatchedJobs++;
+		}
+
+		delete gameJob;
+	}
+
+	m_completedJobs.clear();
+}
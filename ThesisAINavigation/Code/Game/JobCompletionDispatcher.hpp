@@ -0,0 +1,85 @@
+#pragma once
+#include "Game/ActorUID.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include <vector>
+
+class Actor;
+class ActorSlotMap;
+
+//------------------------------------------------------------------------------------------------
+enum class GameJobType
+{
+	PATHFINDING,
+	AGENT_STEERING,
+	NAV_TILE_BUILD,
+	FLOW_FIELD_BUILD,
+	NAV_LANDMARK_BUILD,
+	NUM_GAME_JOB_TYPES
+};
+
+//------------------------------------------------------------------------------------------------
+// Every job the game queues derives from GameJob, so completions are routed on the tag instead of
+// a dynamic_cast. The requester is kept as an ActorUID rather than a pointer so a job can outlive
+// the agent that asked for it. Subclasses put their work in ExecuteGameJob; Execute stamps the start
+// and finish times around it for JobStats and marks the job completed last. The JobSystem hands back
+// plain Jobs, so QueueGameJob records every game job it queues and the dispatcher only casts a
+// completed Job that it finds in that record.
+class GameJob : public Job
+{
+public:
+	GameJob(GameJobType gameJobType, ActorUID requesterUID = ActorUID::INVALID)
+		: Job(JobType::AI), m_gameJobType(gameJobType), m_requesterUID(requesterUID) { m_state = JobStatus::NEW; }
+	virtual ~GameJob() = default;
+
+	virtual void Execute() override final;
+	virtual void ExecuteGameJob() = 0;
+
+public:
+	GameJobType m_gameJobType = GameJobType::NUM_GAME_JOB_TYPES;
+	ActorUID m_requesterUID = ActorUID::INVALID;
+
+	double m_queuedSeconds = 0.0;
+	double m_startedSeconds = 0.0;
+	double m_finishedSeconds = 0.0;
+};
+
+// Hands a game job to the JobSystem, stamping its queue time and recording it as a game job first.
+// Queue every GameJob through here. Safe to call from any thread.
+void QueueGameJob(GameJob* job);
+
+// Requester is nullptr for jobs that were not queued on behalf of an actor
+typedef void (*JobCompletionCallback)(GameJob* job, Actor* requester);
+
+// Takes ownership of a completed job that was queued straight through the JobSystem
+typedef void (*ForeignJobCallback)(Job* job);
+
+//------------------------------------------------------------------------------------------------
+// Drains the JobSystem's completed queue once per frame and hands each job to the callback for its
+// type. Results whose requester has despawned since the job was queued are dropped. The dispatcher
+// owns completed jobs and deletes them after the callback returns. Draining the JobSystem also pulls
+// out jobs that were never queued through QueueGameJob; those go to the foreign job callback, which
+// owns them from then on, or are deleted here when nobody registered one.
+class JobCompletionDispatcher
+{
+public:
+	JobCompletionDispatcher() = default;
+	~JobCompletionDispatcher() = default;
+
+	void SetCallback(GameJobType gameJobType, JobCompletionCallback callback);
+	void SetForeignJobCallback(ForeignJobCallback callback) { m_foreignJobCallback = callback; }
+	void DispatchCompletedJobs(ActorSlotMap const& actors);
+
+	int GetNumDispatchedJobs() const { return m_numDispatchedJobs; }
+	int GetNumDroppedJobs() const { return m_numDroppedJobs; }
+	int GetNumForeignJobs() const { return m_numForeignJobs; }
+
+private:
+	JobCompletionCallback m_callbacks[static_cast<int>(GameJobType::NUM_GAME_JOB_TYPES)] = {};
+	ForeignJobCallback m_foreignJobCallback = nullptr;
+	std::vector<Job*> m_retrievedJobs;
+	std::vector<Job*> m_completedJobs;
+
+	int m_numDispatchedJobs = 0;
+	int m_numDroppedJobs = 0;
+	int m_numForeignJobs = 0;
+};
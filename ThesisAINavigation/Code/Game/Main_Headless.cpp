@@ -0,0 +1,49 @@
+#if defined(GAME_HEADLESS)
+#include "Game/HeadlessRunner.hpp"
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+	HeadlessRunConfig config;
+	if (!HeadlessRunner::ParseCommandLine(argc, argv, config))
+	{
+		HeadlessRunner::PrintUsage();
+		return 1;
+	}
+
+	if (config.m_runSelfTests)
+	{
+		return (HeadlessRunner::RunSelfTests(config) == 0) ? 0 : 1;
+	}
+
+	// A scenario replaces the command line and lists lines its output has to contain
+	std::vector<std::string> expectedLines;
+	if (!config.m_scenarioFilePath.empty() && !HeadlessRunner::LoadScenario(config.m_scenarioFilePath, config, expectedLines))
+	{
+		return 1;
+	}
+
+	std::string report;
+	if (config.m_navBenchmarkDimensions.x > 0 && config.m_navBenchmarkDimensions.y > 0)
+	{
+		report = HeadlessRunner::RunNavBenchmark(config);
+	}
+	else
+	{
+		HeadlessRunner runner(config);
+		runner.Startup();
+		runner.Run();
+		report = runner.m_report;
+		runner.Shutdown();
+	}
+
+	if (!HeadlessRunner::CheckExpectedLines(report, expectedLines))
+	{
+		return 1;
+	}
+
+	return 0;
+}
+#endif
@@ -1,3 +1,4 @@
+#if !defined(GAME_HEADLESS) // Main_Headless.cpp provides main() for the headless configuration
 #define WIN32_LEAN_AND_MEAN		// Always #define this before #including <windows.h>
 #include <windows.h>			// #include this (massive, platform-specific) header in VERY few places (and .CPPs only)
 #include "Game/App.hpp"
@@ -25,4 +26,5 @@ extern App* g_theApp;
  	g_theApp = nullptr;
  
  	return 0;
- }
\ No newline at end of file
+ }
+#endif
@@ -1,4 +1,6 @@
 #include "Map.hpp"
+#include "Game/Diagnostics/JobStats.hpp"
+#include "Game/Diagnostics/Profiler.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/DebugRenderer.hpp"
 #include "Engine/Renderer/Shader.hpp"
@@ -16,11 +18,22 @@
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Game/Controller.hpp"
 #include "Game/Actor.hpp"
+#include "Game/AIActor.hpp"
 #include "Game/ActorDefinitions.hpp"
 #include "Game/Game.hpp"
 #include "Game/PlayerActor.hpp"
 #include "Game/GameCommon.hpp"
+#include "Game/Navigation/NavFlowField.hpp"
+#include "Game/Navigation/NavGraph.hpp"
+#include "Game/Navigation/NavGraphCache.hpp"
+#include "Game/Navigation/NavHierarchy.hpp"
+#include "Game/Navigation/NavLandmarks.hpp"
+#include "Game/Navigation/NavPathCache.hpp"
+#include "Game/Navigation/NavPathfinder.hpp"
+#include "Game/Navigation/NavTileBuilder.hpp"
+#include "Game/Navigation/NavTileStreamer.hpp"
 #include <algorithm>
+#include <thread>
 
 extern Renderer* g_theRenderer;
 
@@ -32,16 +45,35 @@ Map::Map(Game* owner, MapConfig const& config, int numAgentsToSpawn)
 	std::vector<float> regionHeights = { m_mapConfig.m_groundHeightThreshold, m_mapConfig.m_hillHeightTheshold, m_mapConfig.m_mountainHeightThreshold };
 	m_terrain = new Terrain(m_mapConfig.m_terrainWidthDimension, m_mapConfig.m_terrainHeightDimension, NUM_REGIONS, TILING_FACTOR, regionNames, regionColors, regionHeights);
 	
-	std::string shaderName = "Data/Shaders/Terrain";
-	m_terrainShader = g_theRenderer->CreateOrGetShader(shaderName.c_str(), VertexType::Vertex_PCUTBN);
-	
-	LoadTerrainMaterial();
-	CreateTerrainBuffers();
+	if (!m_game->m_gameModeConfig.m_isHeadless)
+	{
+		std::string shaderName = "Data/Shaders/Terrain";
+		m_terrainShader = g_theRenderer->CreateOrGetShader(shaderName.c_str(), VertexType::Vertex_PCUTBN);
+
+		LoadTerrainMaterial();
+		CreateTerrainBuffers();
+	}
 
 	m_navMesh = new NavMesh();
+	m_navGraph = new NavGraph();
+	m_navHierarchy = new NavHierarchy();
+	m_navLandmarks = new NavLandmarks();
 	GenerateNavMesh();
 
 	m_aiPath = new NavMeshPathfinding(m_navMesh);
+	m_navPathfinder = new NavPathfinder(m_navGraph, m_navHierarchy);
+	m_navPathfinder->m_tileStreamer = m_navTileStreamer;
+	if (m_navLandmarks->IsBuiltFor(m_navGraph))
+	{
+		m_navPathfinder->m_landmarks = m_navLandmarks;
+	}
+	if (m_navTileStreamer == nullptr && m_mapConfig.m_navPathCacheCapacity > 0)
+	{
+		m_navPathCache = new NavPathCache(m_mapConfig.m_navPathCacheCapacity);
+		m_navPathfinder->m_pathCache = m_navPathCache;
+	}
+	m_jobCompletionDispatcher.SetCallback(GameJobType::PATHFINDING, &AIActor::OnPathfindingJobCompleted);
+	m_jobCompletionDispatcher.SetCallback(GameJobType::FLOW_FIELD_BUILD, &Map::OnFlowFieldJobCompleted);
 	PopulateMapWithAgentActors();
 }
 
@@ -85,65 +117,75 @@ void Map::CreateTerrainBuffers()
 
 void Map::GenerateNavMesh()
 {
-	std::vector<Vec3> vertices;
-	std::vector<int> vertexMapping;
-	
 	int mapWidth = static_cast<int>(m_terrain->m_terrainWidth);
 	int mapHeight = static_cast<int>(m_terrain->m_terrainHeight);
 
-	float xOffset = static_cast<float>(mapWidth) / 2.f;
-	float yOffset = static_cast<float>(mapHeight) / 2.f;
-	float rowOffset = 0.25f; // Offset for alternating rows
-	float maxDisplacement = 0.3f; // Maximum displacement
-
 	float maxAgentRadius = 2.f;
-	int borderSkip = static_cast<int>(ceil(maxAgentRadius));
 
-	// Generate vertices based on the height map
-	for (int y = 0; y < mapHeight; y++)
+	NavVertexSettings vertexSettings;
+	vertexSettings.m_gridWidth = mapWidth;
+	vertexSettings.m_gridHeight = mapHeight;
+	vertexSettings.m_borderSkip = static_cast<int>(ceil(maxAgentRadius));
+	vertexSettings.m_rowOffset = 0.25f; // Offset for alternating rows
+	vertexSettings.m_maxDisplacement = 0.3f; // Maximum displacement
+	vertexSettings.m_heightScale = TERRAIN_HEIGHT;
+	vertexSettings.m_heightBias = -TERRAIN_HEIGHT * 0.5f + NAVMESH_ZBIAS;
+	vertexSettings.m_seed = m_mapConfig.m_navMeshSeed;
+
+	NavGraphCacheKey cacheKey;
+	cacheKey.m_gridWidth = mapWidth;
+	cacheKey.m_gridHeight = mapHeight;
+	cacheKey.m_groundHeightThreshold = m_mapConfig.m_groundHeightThreshold;
+	cacheKey.m_hillHeightThreshold = m_mapConfig.m_hillHeightTheshold;
+	cacheKey.m_mountainHeightThreshold = m_mapConfig.m_mountainHeightThreshold;
+	cacheKey.m_seed = m_mapConfig.m_navMeshSeed;
+	cacheKey.m_heightMapHash = NavGraphCache::HashHeightMap(m_terrain->m_terrainHeightMap);
+
+	// Vertices, triangles and adjacency are generated tile by tile on the job system, or come
+	// straight from the cache
+	NavTileBuilder tileBuilder(vertexSettings, m_terrain->m_terrainHeightMap);
+	if (m_mapConfig.m_useNavTileStreaming)
 	{
-		for (int x = 0; x < mapWidth; x++)
+		// No full graph, tiles are built around agents as they need them
+		size_t budgetBytes = static_cast<size_t>(m_mapConfig.m_navStreamingBudgetMB) * 1024 * 1024;
+		m_navTileStreamer = new NavTileStreamer(vertexSettings, m_terrain->m_terrainHeightMap, budgetBytes);
+	}
+	else
+	{
+		bool isLoadedFromCache = m_mapConfig.m_useNavGraphCache && NavGraphCache::Load(cacheKey, *m_navGraph, *m_navHierarchy, *m_navLandmarks);
+		bool isCacheStale = !isLoadedFromCache;
+		if (!isLoadedFromCache)
 		{
-			float height = m_terrain->m_terrainHeightMap[Get1DIndex(x, y, mapWidth)];
-
-			bool isCushionArea = (x < borderSkip || x >= mapWidth - borderSkip ||
-				y < borderSkip || y >= mapHeight - borderSkip);
+			tileBuilder.BuildGraph(*m_navGraph);
+			m_navHierarchy->Build(m_navGraph);
+		}
 
-			bool isBorderArea = (x == borderSkip || x == mapWidth - 1 - borderSkip ||
-				y == borderSkip || y == mapHeight - 1 - borderSkip);
+		// A cached file built with a different landmark count only needs its tables redone
+		if (m_navLandmarks->GetNumLandmarks() != m_mapConfig.m_numNavLandmarks)
+		{
+			m_navLandmarks->Build(m_navGraph, m_mapConfig.m_numNavLandmarks);
+			isCacheStale = true;
+		}
 
-			if (isCushionArea)
-			{
-				vertexMapping.emplace_back(-1);
-			}
-			else if (isBorderArea) 
-			{ 
-				float adjustedX = static_cast<float>(x) - xOffset;
-				float adjustedY = static_cast<float>(y) - yOffset;
-				vertices.emplace_back(Vec3(adjustedX, adjustedY, height * TERRAIN_HEIGHT - TERRAIN_HEIGHT * 0.5f + NAVMESH_ZBIAS));
-				vertexMapping.emplace_back(static_cast<int>(vertices.size()) - 1);
-				continue; 
-			}
-			else
-			{
-				// Altering row offset for odd rows
-				float adjustedX = static_cast<float>(x) - xOffset + ((y % 2 != 0) ? rowOffset : 0.f);
-				float adjustedY = static_cast<float>(y) - yOffset;
+		if (isCacheStale && m_mapConfig.m_useNavGraphCache)
+		{
+			NavGraphCache::Save(cacheKey, *m_navGraph, *m_navHierarchy, *m_navLandmarks);
+		}
+	}
 
-				// Random displacement
-				float randomXOffset = g_rng.SRollRandomFloatInRange(-maxDisplacement, maxDisplacement);
-				float randomYOffset = g_rng.SRollRandomFloatInRange(-maxDisplacement, maxDisplacement);
+	// The engine mesh is what limits map size. A streamed map never builds it, its spawns, goals and
+	// agent heights come from the heightmap and the resident tiles instead.
+	if (m_navTileStreamer != nullptr) return;
 
-				adjustedX += randomXOffset;
-				adjustedY += randomYOffset;
+	// The engine mesh is built from the same vertices
+	std::vector<int> vertexMapping;
+	tileBuilder.BuildVertexMapping(vertexMapping);
+	m_navMesh->CreateNavMesh(m_navGraph->m_vertices, mapWidth, mapHeight, vertexMapping);
 
-				vertices.emplace_back(Vec3(adjustedX, adjustedY, height * TERRAIN_HEIGHT - TERRAIN_HEIGHT * 0.5f + NAVMESH_ZBIAS));
-				vertexMapping.emplace_back(static_cast<int>(vertices.size()) - 1);
-			}
-		}
+	if (!m_game->m_gameModeConfig.m_isHeadless)
+	{
+		m_navMesh->CreateBuffers();
 	}
-	m_navMesh->CreateNavMesh(vertices, mapWidth, mapHeight, vertexMapping);
-	m_navMesh->CreateBuffers();
 
 	// Validate Nav Mesh
 	[[maybe_unused]] bool isNavMeshValid = m_navMesh->ValidateNavMesh();
@@ -157,6 +199,7 @@ void Map::GenerateNavMesh()
 
 void Map::Render() const
 {
+	PROFILE_ZONE("Map::Render");
 	RenderTerrain();
 	RenderNavMesh();
 	RenderProps();
@@ -194,7 +237,8 @@ void Map::RenderTerrain() const
 
 void Map::RenderNavMesh() const
 {
-	if (m_navMesh)
+	// Streamed maps leave the engine mesh empty
+	if (m_navMesh && m_navTileStreamer == nullptr)
 	{
 		if (m_game->m_enableNavMeshVisual)
 		{
@@ -227,13 +271,10 @@ void Map::RenderProps() const
 
 void Map::RenderActors() const
 {
-	if (!m_agentActors.empty())
+	for (Actor* agent : m_agentActors.GetSlots())
 	{
-		for (int index = 0; index < m_agentActors.size(); index++)
-		{
-			if (m_agentActors[index] == nullptr) continue;
-			m_agentActors[index]->Render();
-		}
+		if (agent == nullptr) continue;
+		agent->Render();
 	}
 }
 
@@ -311,7 +352,17 @@ Vec3 Map::GetRandomPositionOnMap()
 {
 	Vec3 randomPosition = Vec3::ZERO;
 
-	if (m_navMesh)
+	if (m_navGraph && m_navGraph->HasUpToDateComponents())
+	{
+		// Get centroid of an area weighted random triangle to place the prop
+		int randomTriangleIndex = m_navGraph->GetRandomTriangle(g_rng.SRollRandomFloatInRange(0.f, 1.f), g_rng.SRollRandomFloatInRange(0.f, 1.f));
+		randomPosition = m_navGraph->m_triangles[randomTriangleIndex].m_centroid;
+	}
+	else if (m_navTileStreamer)
+	{
+		randomPosition = m_navTileStreamer->GetRandomPoint(g_rng.SRollRandomFloatInRange(0.f, 1.f), g_rng.SRollRandomFloatInRange(0.f, 1.f), 0.5f, 0.f);
+	}
+	else if (m_navMesh)
 	{
 		// Get a random triangle from the navmesh
 		int randomTriangleIndex = m_navMesh->GetRandomNavMeshTriangleIndex();
@@ -326,6 +377,25 @@ Vec3 Map::GetRandomPositionOnMap()
 	return randomPosition;
 }
 
+Vec3 Map::GetRandomNavPoint() const
+{
+	if (m_navGraph->HasUpToDateComponents())
+	{
+		int randomTriangleIndex = m_navGraph->GetRandomTriangle(g_rng.SRollRandomFloatInRange(0.f, 1.f), g_rng.SRollRandomFloatInRange(0.f, 1.f));
+		return m_navGraph->GetPointInTriangle(randomTriangleIndex, g_rng.SRollRandomFloatInRange(0.f, 1.f), g_rng.SRollRandomFloatInRange(0.f, 1.f));
+	}
+
+	// Streamed maps have no full graph to sample
+	if (m_navTileStreamer != nullptr)
+	{
+		return m_navTileStreamer->GetRandomPoint(g_rng.SRollRandomFloatInRange(0.f, 1.f), g_rng.SRollRandomFloatInRange(0.f, 1.f),
+			g_rng.SRollRandomFloatInRange(0.f, 1.f), g_rng.SRollRandomFloatInRange(0.f, 1.f));
+	}
+
+	int randomTriangleIndex = m_navMesh->GetRandomNavMeshTriangleIndex();
+	return m_navMesh->GetRandomPointInsideTriangle(randomTriangleIndex);
+}
+
 void Map::PopulateMapWithAgentActors()
 {
 	std::vector<TempActorInfo> tempAgents; // Store temporary agents with pos and radius
@@ -344,8 +414,7 @@ void Map::PopulateMapWithAgentActors()
 
 		while (!validSpawnFound)
 		{
-			int randomTriangleIndex = m_navMesh->GetRandomNavMeshTriangleIndex();
-			spawnPosition = m_navMesh->GetRandomPointInsideTriangle(randomTriangleIndex);
+			spawnPosition = GetRandomNavPoint();
 
 			validSpawnFound = true;
 			for (TempActorInfo const& existingAgent : tempAgents)
@@ -379,86 +448,221 @@ void Map::PopulateMapWithAgentActors()
 
 void Map::MapUpdate()
 {
-	[[maybe_unused]] float deltaSeconds = m_game->m_clock->GetDeltaSeconds();
+	PROFILE_ZONE("Map::MapUpdate");
+	[[maybe_unused]] float deltaSeconds = m_game->GetDeltaSeconds();
+
+	// Every job that finished since last frame is routed to its requester before anyone updates
+	m_jobCompletionDispatcher.DispatchCompletedJobs(m_agentActors);
+	ApplyPendingNavObstacles();
 	
+	UpdateNavTileStreaming();
+	UpdateFlowField();
 	UpdateActors();
 }
 
-void Map::UpdateActors()
+void Map::UpdateFlowField()
+{
+	if (!m_game->m_gameModeConfig.m_useFlowField || m_navGraph->IsEmpty()) return;
+
+	// A new rally point every so often, agents keep following the old field until the new one lands
+	m_rallyPointTimeRemaining -= m_game->GetDeltaSeconds();
+	bool isFlowFieldStale = (m_flowField != nullptr && !m_flowField->IsBuiltFor(m_navGraph));
+	if ((m_rallyPointTimeRemaining > 0.f && !isFlowFieldStale) || m_isFlowFieldPending || IsNavChangePending()) return;
+
+	// Obstacles changed the graph under the current field, rebuild it toward the same rally point
+	Vec3 rallyPoint;
+	if (isFlowFieldStale && m_rallyPointTimeRemaining > 0.f)
+	{
+		rallyPoint = m_flowField->m_goalPoint;
+	}
+	else
+	{
+		rallyPoint = GetRandomNavPoint();
+		m_rallyPointTimeRemaining = FLOW_FIELD_RALLY_PERIOD_SECONDS;
+	}
+	m_numNavJobsInFlight++;
+	QueueGameJob(new NavFlowFieldJob(this, m_navGraph, rallyPoint, m_numNavJobsInFlight));
+	m_isFlowFieldPending = true;
+}
+
+void Map::ToggleNavObstacle(Vec3 const& position)
+{
+	if (m_navGraph->IsEmpty()) return;
+
+	m_pendingNavObstacleToggles.emplace_back(position.x, position.y, 0.f);
+	ApplyPendingNavObstacles();
+}
+
+void Map::ApplyPendingNavObstacles()
 {
-	if (!m_agentActors.empty())
+	// Path and flow field jobs read triangle costs without a lock. Nothing new is queued while a change
+	// is pending, so the jobs already in flight drain within a few frames and the main thread never waits.
+	if (m_pendingNavObstacleToggles.empty() || m_numNavJobsInFlight > 0) return;
+
+	auto isUnderObstacle = [](Vec3 const& center, Vec3 const& point)
+	{
+		float dx = point.x - center.x;
+		float dy = point.y - center.y;
+		return (dx * dx) + (dy * dy) <= NAV_OBSTACLE_RADIUS * NAV_OBSTACLE_RADIUS;
+	};
+
+	for (Vec3 obstacleCenter : m_pendingNavObstacleToggles)
 	{
-		for (int index = 0; index < m_agentActors.size(); index++)
+		auto existingObstacle = std::find_if(m_navObstacles.begin(), m_navObstacles.end(),
+			[&](Vec3 const& center) { return isUnderObstacle(center, obstacleCenter); });
+		bool isRemoving = (existingObstacle != m_navObstacles.end());
+		if (isRemoving)
 		{
-			if (m_agentActors[index] == nullptr) continue;
-			m_agentActors[index]->Update();
+			obstacleCenter = *existingObstacle;
+			m_navObstacles.erase(existingObstacle);
+		}
+		else
+		{
+			m_navObstacles.emplace_back(obstacleCenter);
+		}
+
+		for (int triangleIndex = 0; triangleIndex < m_navGraph->GetNumTriangles(); triangleIndex++)
+		{
+			Vec3 const& centroid = m_navGraph->m_triangles[triangleIndex].m_centroid;
+			if (!isUnderObstacle(obstacleCenter, centroid)) continue;
+
+			// Overlapping obstacles keep a triangle blocked until the last one covering it is gone
+			bool isBlocked = !isRemoving || std::any_of(m_navObstacles.begin(), m_navObstacles.end(),
+				[&](Vec3 const& center) { return isUnderObstacle(center, centroid); });
+			if (isBlocked != m_navGraph->IsTriangleBlocked(triangleIndex))
+			{
+				m_navGraph->SetTriangleCostScale(triangleIndex, isBlocked ? NAV_BLOCKED_COST_SCALE : 1.f);
+			}
 		}
 	}
+	m_pendingNavObstacleToggles.clear();
+
+	// An obstacle can wall off a pocket of the map, or open one back up
+	m_navGraph->LabelComponents();
+
+	// HPA* only refloods the clusters under the obstacle, so it stays on for the next queries
+	m_navHierarchy->ApplyCostChanges();
 }
 
-std::vector<Prop*> Map::GetAllProps() const
+void Map::WaitForNavJobs()
 {
-	return m_props;
+	while (m_numNavJobsInFlight > 0)
+	{
+		std::this_thread::yield();
+	}
 }
 
-std::vector<Actor*> Map::GetAllAgents() const
+void Map::OnFlowFieldJobCompleted(GameJob* job, Actor* requester)
 {
-	return m_agentActors;
+	UNUSED(requester);
+
+	NavFlowFieldJob* flowFieldJob = static_cast<NavFlowFieldJob*>(job);
+	Map* map = flowFieldJob->m_map;
+	delete map->m_flowField;
+	map->m_flowField = flowFieldJob->m_flowField;
+	flowFieldJob->m_flowField = nullptr;
+	map->m_isFlowFieldPending = false;
 }
 
-ActorUID Map::GenerateActorUID(int actorIndex)
+void Map::UpdateNavTileStreaming()
 {
-	ActorUID uid = ActorUID(m_actorSalt++, actorIndex);
-	return uid;
+	if (m_navTileStreamer == nullptr) return;
+
+	std::vector<Vec3> interestPoints;
+	for (int slotIndex = 0; slotIndex < m_agentStates.GetNumSlots(); slotIndex++)
+	{
+		if (!m_agentStates.IsActive(slotIndex)) continue;
+		interestPoints.emplace_back(m_agentStates.m_positions[slotIndex]);
+	}
+	if (m_game->m_player != nullptr)
+	{
+		interestPoints.emplace_back(m_game->m_player->m_position);
+	}
+
+	m_navTileStreamer->Update(interestPoints);
 }
 
-Actor* Map::SpawnActor(const MapSpawnInfo& spawnInfo)
+void Map::UpdateActors()
 {
-	static int actorCounter = 0;
-
-	for (int i = 0; i < m_agentActors.size(); i++)
+	PROFILE_ZONE("Map::UpdateActors");
+	if (!m_agentActors.IsEmpty())
 	{
-		if (m_agentActors[i] == nullptr)
+		std::vector<Actor*> const& agentSlots = m_agentActors.GetSlots();
+
+		// Neighbor queries read from the hash and the state store snapshot, so both are rebuilt once before anyone moves this frame
+		for (Actor* agent : agentSlots)
 		{
-			ActorUID uid = GenerateActorUID(i);
+			if (agent == nullptr) continue;
+			agent->UpdateSearchRadius();
+		}
+		m_agentStates.TakeSnapshot();
+		m_agentSpatialHash.Rebuild(m_agentStates);
 
-			Actor* newActor = new Actor(this, m_game, spawnInfo, uid);
+		if (m_game->m_gameModeConfig.m_useParallelAgentUpdate)
+		{
+			m_agentParallelUpdater.UpdateAgents(agentSlots);
+			return;
+		}
 
-			newActor->m_uniqueName = Stringf("%s%i", newActor->m_actorDef->m_name.c_str(), actorCounter++);
-		
-			m_agentActors[i] = newActor;
-			return newActor;
+		for (int index = 0; index < static_cast<int>(agentSlots.size()); index++)
+		{
+			if (agentSlots[index] == nullptr) continue;
+			agentSlots[index]->Update();
 		}
 	}
-	
-	int index = static_cast<int>(m_agentActors.size());
-	ActorUID uid = GenerateActorUID(index);
+}
+
+std::vector<Prop*> Map::GetAllProps() const
+{
+	return m_props;
+}
+
+std::vector<Actor*> const& Map::GetAllAgents() const
+{
+	return m_agentActors.GetSlots();
+}
+
+Actor* Map::SpawnActor(const MapSpawnInfo& spawnInfo)
+{
+	static int actorCounter = 0;
+
+	ActorUID uid = m_agentActors.AllocateUID();
 
 	Actor* newActor = new Actor(this, m_game, spawnInfo, uid);
 
 	newActor->m_uniqueName = Stringf("%s%i", newActor->m_actorDef->m_name.c_str(), actorCounter++);
 
-	m_agentActors.emplace_back(newActor);
+	m_agentActors.AssignActor(uid, newActor);
 
 	return newActor;
 }
 
 Actor* Map::GetActorByUID(const ActorUID uid) const
 {
-	for (Actor* actor : m_agentActors)
-	{
-		if (actor && actor->GetUID() == uid)
-		{
-			return actor;
-		}
-	}
-	return nullptr;
+	return m_agentActors.GetActor(uid);
 }
 
 void Map::MapShutDown()
 {
+	// Running path and flow field jobs hold the pathfinder, the nav graph and this map's in-flight
+	// counter. Once they are done, their completions are handed out while the actors and nav data
+	// still exist, so none is left in the JobSystem for the next map's dispatcher to pick up.
+	WaitForNavJobs();
+	while (JobStats::GetTypeStats(GameJobType::PATHFINDING).GetNumOutstanding() > 0 || JobStats::GetTypeStats(GameJobType::FLOW_FIELD_BUILD).GetNumOutstanding() > 0)
+	{
+		m_jobCompletionDispatcher.DispatchCompletedJobs(m_agentActors);
+		std::this_thread::yield();
+	}
+
 	SafeDelete(m_props);
 	SafeDelete(m_aiPath);
+	SafeDelete(m_navPathfinder);
+	SafeDelete(m_navPathCache);
+	SafeDelete(m_flowField);
+	SafeDelete(m_navTileStreamer);
+	SafeDelete(m_navLandmarks);
+	SafeDelete(m_navHierarchy);
+	SafeDelete(m_navGraph);
 	SafeDelete(m_navMesh);
 	SafeDelete(m_terrain);
 	SafeDelete(m_terrainShader);
@@ -467,5 +671,6 @@ void Map::MapShutDown()
 	SafeDelete(m_snowRockMat);
 	SafeDelete(m_terrainVertexBuffer);
 	SafeDelete(m_terrainIndexBuffer);
-	SafeDelete(m_agentActors);
+	m_agentActors.DeleteAllActors();
+	m_agentStates.Clear();
 }
@@ -8,6 +8,12 @@
 #include "Engine/Renderer/Material.hpp"
 #include "Engine/Renderer/NavMesh.hpp"
 #include "Engine/Utilities/Prop.hpp"
+#include "Game/ActorSlotMap.hpp"
+#include "Game/AgentSpatialHash.hpp"
+#include "Game/AgentStateStore.hpp"
+#include "Game/AgentParallelUpdater.hpp"
+#include "Game/JobCompletionDispatcher.hpp"
+#include <atomic>
 #include <vector>
 #include <string>
 
@@ -15,16 +21,24 @@ class Controller;
 class Game;
 class PlayerActor;
 class Actor;
-struct ActorUID;
 class Shader;
 class Texture;
 class Image;
 class VertexBuffer;
 class IndexBuffer;
 class NavMeshPathfinding;
+class NavGraph;
+class NavHierarchy;
+class NavLandmarks;
+class NavFlowField;
+class NavPathCache;
+class NavPathfinder;
+class NavTileStreamer;
 
 constexpr float TILING_FACTOR = 5.f;
 constexpr int NUM_REGIONS = 3;
+constexpr float FLOW_FIELD_RALLY_PERIOD_SECONDS = 30.f;
+constexpr float NAV_OBSTACLE_RADIUS = 5.f;
 
 struct MapConfig
 {
@@ -34,6 +48,22 @@ struct MapConfig
 
 	int m_terrainWidthDimension = 20; // 300 is max size I can do before it crashes and its too slow to compute neighbors for nav mesh generation
 	int m_terrainHeightDimension = 20; // 300 is max size I can do before it crashes and its too slow to compute neighbors for nav mesh generation 
+
+	// Seeds the navmesh vertex jitter. Part of the nav graph cache key together with the size, the
+	// height thresholds and the heightmap itself
+	unsigned int m_navMeshSeed = 0;
+	bool m_useNavGraphCache = true;
+
+	// Keeps only the nav tiles around agents and the player resident instead of the full graph
+	bool m_useNavTileStreaming = false;
+	int m_navStreamingBudgetMB = 256;
+
+	// Corridors remembered per (start triangle, goal triangle) pair, 0 turns the path cache off
+	int m_navPathCacheCapacity = 1024;
+
+	// ALT heuristic landmarks built with the graph and saved in its cache file, 0 turns them off.
+	// While they are built NavPathfinder runs flat A* on them and skips the HPA* layer.
+	int m_numNavLandmarks = 0;
 };
 
 struct TempActorInfo
@@ -69,17 +99,28 @@ public:
 
 	void PopulateMapWithProps();
 	Vec3 GetRandomPositionOnMap();
+	Vec3 GetRandomNavPoint() const; // Uniform over the walkable area
 
 	inline int Get1DIndex(int x, int y, int width) const { return (y * width) + x; }
 
 	void PopulateMapWithAgentActors();
 
 	void MapUpdate();
+	void UpdateNavTileStreaming();
+	void UpdateFlowField();
+	static void OnFlowFieldJobCompleted(GameJob* job, Actor* requester);
+
+	// Drops a dynamic obstacle at the point, or removes the one already there. Blocks the game nav
+	// graph triangles under it, agents with incremental replanning repair their paths around it.
+	// The change is queued and lands at the start of a MapUpdate once no nav job is reading the graph.
+	void ToggleNavObstacle(Vec3 const& position);
+	void ApplyPendingNavObstacles();
+	bool IsNavChangePending() const { return !m_pendingNavObstacleToggles.empty(); }
+	void WaitForNavJobs();
 	void UpdateActors();
 
 	std::vector<Prop*> GetAllProps() const;
-	std::vector<Actor*> GetAllAgents() const;
-	ActorUID GenerateActorUID(int actorIndex);
+	std::vector<Actor*> const& GetAllAgents() const;
 	Actor* SpawnActor(const MapSpawnInfo& spawnInfo);
 	Actor* GetActorByUID(const ActorUID uid) const;
 
@@ -95,6 +136,21 @@ public:
 	Terrain*  m_terrain = nullptr;
 	NavMesh*  m_navMesh = nullptr;
 	NavMeshPathfinding* m_aiPath = nullptr;
+	NavGraph* m_navGraph = nullptr;
+	NavHierarchy* m_navHierarchy = nullptr;
+	NavLandmarks* m_navLandmarks = nullptr;
+	NavPathCache* m_navPathCache = nullptr;
+	NavPathfinder* m_navPathfinder = nullptr;
+	NavTileStreamer* m_navTileStreamer = nullptr;
+	NavFlowField* m_flowField = nullptr;
+	bool m_isFlowFieldPending = false;
+	float m_rallyPointTimeRemaining = 0.f;
+	std::vector<Vec3> m_navObstacles;
+	std::vector<Vec3> m_pendingNavObstacleToggles;
+
+	// Jobs reading the nav graph. Obstacle changes are held until none is in flight, and no new one
+	// is queued while a change is pending.
+	std::atomic<int> m_numNavJobsInFlight{ 0 };
 	Material* m_rockMat = nullptr;
 	Material* m_snowRockMat = nullptr;
 	Material* m_grassDirtMat = nullptr;
@@ -109,11 +165,13 @@ public:
 	IndexBuffer* m_terrainIndexBuffer = nullptr;
 
 public:
-	std::vector<Actor*> m_agentActors;
+	ActorSlotMap m_agentActors;
+	AgentSpatialHash m_agentSpatialHash;
+	AgentStateStore m_agentStates;
+	AgentParallelUpdater m_agentParallelUpdater;
+	JobCompletionDispatcher m_jobCompletionDispatcher;
 	int m_maxNumAgents = 0;
 	int m_agentID = 0;
-	static const unsigned int MAX_ACTOR_SALT = 0x0000fffeu;
-	unsigned int m_actorSalt = MAX_ACTOR_SALT;
 
 public:
 	bool m_canSeePlaneBounds = false;
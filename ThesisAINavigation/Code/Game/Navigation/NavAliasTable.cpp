@@ -0,0 +1,84 @@
+#include "Game/Navigation/NavAliasTable.hpp"
+#include <cstddef>
+
+void NavAliasTable::Resize(int numSlots)
+{
+	m_probabilities.assign(static_cast<size_t>(numSlots), 1.f);
+	m_aliases.resize(static_cast<size_t>(numSlots));
+	for (int slot = 0; slot < numSlots; slot++)
+	{
+		m_aliases[slot] = slot;
+	}
+}
+
+void NavAliasTable::Clear()
+{
+	m_probabilities.clear();
+	m_aliases.clear();
+}
+
+void NavAliasTable::BuildRange(std::vector<float> const& weights, int firstSlot, int numSlots)
+{
+	if (numSlots <= 0) return;
+
+	double totalWeight = 0.0;
+	for (int slot = firstSlot; slot < firstSlot + numSlots; slot++)
+	{
+		totalWeight += weights[slot];
+	}
+
+	// Scale so the average slot weighs exactly 1, then pair every light slot with a heavy one
+	m_scaledWeights.resize(static_cast<size_t>(numSlots));
+	m_smallSlots.clear();
+	m_largeSlots.clear();
+	for (int offset = 0; offset < numSlots; offset++)
+	{
+		float scaledWeight = (totalWeight > 0.0) ? static_cast<float>((weights[firstSlot + offset] * numSlots) / totalWeight) : 1.f;
+		m_scaledWeights[offset] = scaledWeight;
+		if (scaledWeight < 1.f)
+		{
+			m_smallSlots.emplace_back(offset);
+		}
+		else
+		{
+			m_largeSlots.emplace_back(offset);
+		}
+	}
+
+	while (!m_smallSlots.empty() && !m_largeSlots.empty())
+	{
+		int smallOffset = m_smallSlots.back();
+		int largeOffset = m_largeSlots.back();
+		m_smallSlots.pop_back();
+
+		m_probabilities[firstSlot + smallOffset] = m_scaledWeights[smallOffset];
+		m_aliases[firstSlot + smallOffset] = firstSlot + largeOffset;
+
+		// The heavy slot gives away what the light one was missing and may turn light itself
+		m_scaledWeights[largeOffset] -= 1.f - m_scaledWeights[smallOffset];
+		if (m_scaledWeights[largeOffset] < 1.f)
+		{
+			m_largeSlots.pop_back();
+			m_smallSlots.emplace_back(largeOffset);
+		}
+	}
+
+	// Whatever is left over is 1 up to rounding error
+	for (int offset : m_largeSlots)
+	{
+		m_probabilities[firstSlot + offset] = 1.f;
+		m_aliases[firstSlot + offset] = firstSlot + offset;
+	}
+	for (int offset : m_smallSlots)
+	{
+		m_probabilities[firstSlot + offset] = 1.f;
+		m_aliases[firstSlot + offset] = firstSlot + offset;
+	}
+}
+
+int NavAliasTable::Sample(int firstSlot, int numSlots, float slotZeroToOne, float aliasZeroToOne) const
+{
+	int offset = static_cast<int>(slotZeroToOne * static_cast<float>(numSlots));
+	int slot = firstSlot + ((offset < numSlots) ? offset : numSlots - 1);
+	return (aliasZeroToOne < m_probabilities[slot]) ? slot : m_aliases[slot];
+}
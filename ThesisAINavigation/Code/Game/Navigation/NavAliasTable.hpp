@@ -0,0 +1,35 @@
+#pragma once
+#include <vector>
+
+//------------------------------------------------------------------------------------------------
+// Walker/Vose alias table for O(1) weighted picks. One table can hold several independent ranges
+// side by side: every slot's alias stays inside the range it was built with, so a pick that starts
+// in a range never leaves it. Slots are indexes into whatever array the weights came from.
+class NavAliasTable
+{
+public:
+	NavAliasTable() = default;
+	~NavAliasTable() = default;
+
+	void Resize(int numSlots);
+	void Clear();
+
+	// Fills slots [firstSlot, firstSlot + numSlots) from weights at the same indexes. A range whose
+	// weights are all zero is picked uniformly.
+	void BuildRange(std::vector<float> const& weights, int firstSlot, int numSlots);
+
+	// Both random numbers in [0, 1], the first picks the slot and the second decides slot or alias
+	int Sample(int firstSlot, int numSlots, float slotZeroToOne, float aliasZeroToOne) const;
+
+	bool IsEmpty() const { return m_probabilities.empty(); }
+
+public:
+	std::vector<float> m_probabilities;
+	std::vector<int> m_aliases;
+
+private:
+	// Build scratch, kept so rebuilding after every obstacle toggle does not allocate
+	std::vector<float> m_scaledWeights;
+	std::vector<int> m_smallSlots;
+	std::vector<int> m_largeSlots;
+};
@@ -0,0 +1,149 @@
+#include "Game/Navigation/NavBenchmark.hpp"
+#include "Game/Navigation/NavGraph.hpp"
+#include "Game/Navigation/NavHierarchy.hpp"
+#include "Game/Navigation/NavPathfinder.hpp"
+#include "Game/Navigation/NavSearchContext.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include <vector>
+
+constexpr float NAV_BENCHMARK_JITTER = 0.6f;
+constexpr float NAV_BENCHMARK_HILL_HEIGHT = 3.f;
+
+// Deterministic across platforms, unlike the standard distributions
+static unsigned int GetBenchmarkHash(unsigned int a, unsigned int b, unsigned int seed)
+{
+	unsigned int hash = (a * 0x8DA6B343u) ^ (b * 0xD8163841u) ^ (seed * 0xCB1AB31Fu);
+	hash ^= hash >> 13;
+	hash *= 0x5BD1E995u;
+	hash ^= hash >> 15;
+	return hash;
+}
+
+static float GetBenchmarkJitter(int x, int y, unsigned int channel, unsigned int seed)
+{
+	unsigned int hash = GetBenchmarkHash(static_cast<unsigned int>(x), static_cast<unsigned int>(y) ^ (channel << 24), seed);
+	return NAV_BENCHMARK_JITTER * ((static_cast<float>(hash & 0xFFFF) / 65535.f) - 0.5f);
+}
+
+static float GetCorridorCost(NavGraph const& navGraph, std::vector<int> const& corridor)
+{
+	float cost = 0.f;
+	for (int corridorIndex = 1; corridorIndex < static_cast<int>(corridor.size()); corridorIndex++)
+	{
+		cost += navGraph.GetEdgeCost(corridor[corridorIndex - 1], corridor[corridorIndex]);
+	}
+	return cost;
+}
+
+NavBenchmarkResult NavBenchmark::Run(NavBenchmarkConfig const& config)
+{
+	NavBenchmarkResult result;
+	if (config.m_gridDimensions.x < 2 || config.m_gridDimensions.y < 2) return result;
+
+	double timeBefore = GetCurrentTimeSeconds();
+	NavGraph navGraph;
+	BuildGridGraph(config.m_gridDimensions, config.m_seed, navGraph);
+	double timeAfterGraph = GetCurrentTimeSeconds();
+	NavHierarchy navHierarchy;
+	navHierarchy.Build(&navGraph);
+	double timeAfterHierarchy = GetCurrentTimeSeconds();
+
+	result.m_numTriangles = navGraph.GetNumTriangles();
+	result.m_numClusters = navHierarchy.GetNumClusters();
+	result.m_numAbstractNodes = navHierarchy.GetNumNodes();
+	result.m_graphBuildSeconds = timeAfterGraph - timeBefore;
+	result.m_hierarchyBuildSeconds = timeAfterHierarchy - timeAfterGraph;
+	if (result.m_numTriangles == 0) return result;
+
+	NavPathfinder flatPathfinder(&navGraph);
+	NavSearchContext& context = NavSearchContext::GetForCurrentThread();
+	std::vector<int> flatCorridor;
+	double totalCostRatio = 0.0;
+	int numCompared = 0;
+
+	for (int queryIndex = 0; queryIndex < config.m_numQueries; queryIndex++)
+	{
+		unsigned int numTriangles = static_cast<unsigned int>(result.m_numTriangles);
+		int startTriangle = static_cast<int>(GetBenchmarkHash(static_cast<unsigned int>(queryIndex), 0, config.m_seed) % numTriangles);
+		int goalTriangle = static_cast<int>(GetBenchmarkHash(static_cast<unsigned int>(queryIndex), 1, config.m_seed) % numTriangles);
+
+		timeBefore = GetCurrentTimeSeconds();
+		bool isFlatFound = flatPathfinder.FindCorridor(startTriangle, goalTriangle, context);
+		result.m_flatQueryTimes.Record(GetCurrentTimeSeconds() - timeBefore);
+		flatCorridor.swap(context.m_corridor);
+
+		timeBefore = GetCurrentTimeSeconds();
+		bool isHierarchyFound = navHierarchy.FindCorridor(startTriangle, goalTriangle, context);
+		result.m_hierarchyQueryTimes.Record(GetCurrentTimeSeconds() - timeBefore);
+
+		if (!isHierarchyFound)
+		{
+			result.m_numHierarchyFailures++;
+			continue;
+		}
+
+		float flatCost = GetCorridorCost(navGraph, flatCorridor);
+		if (isFlatFound && flatCost > 0.f)
+		{
+			totalCostRatio += GetCorridorCost(navGraph, context.m_corridor) / flatCost;
+			numCompared++;
+		}
+	}
+
+	result.m_averageCostRatio = (numCompared > 0) ? totalCostRatio / static_cast<double>(numCompared) : 0.0;
+	return result;
+}
+
+void NavBenchmark::BuildGridGraph(IntVec2 const& gridDimensions, unsigned int seed, NavGraph& out_navGraph)
+{
+	int gridWidth = gridDimensions.x;
+	int gridHeight = gridDimensions.y;
+
+	// Same vertex layout Map::GenerateNavMesh hands the graph
+	std::vector<Vec3> vertices;
+	std::vector<int> vertexMapping;
+	vertices.reserve(static_cast<size_t>(gridWidth) * gridHeight);
+	vertexMapping.reserve(static_cast<size_t>(gridWidth) * gridHeight);
+	for (int y = 0; y < gridHeight; y++)
+	{
+		for (int x = 0; x < gridWidth; x++)
+		{
+			float positionX = static_cast<float>(x) + GetBenchmarkJitter(x, y, 0, seed);
+			float positionY = static_cast<float>(y) + GetBenchmarkJitter(x, y, 1, seed);
+			float height = NAV_BENCHMARK_HILL_HEIGHT * SinDegrees(positionX * 3.f) * CosDegrees(positionY * 4.f);
+			vertexMapping.emplace_back(static_cast<int>(vertices.size()));
+			vertices.emplace_back(positionX, positionY, height);
+		}
+	}
+
+	out_navGraph.Build(vertices, gridWidth, gridHeight, vertexMapping);
+}
+
+std::string NavBenchmark::GetReport(NavBenchmarkConfig const& config, NavBenchmarkResult const& result)
+{
+	std::string report = "=== Nav Benchmark ===\n";
+
+	char line[160];
+	snprintf(line, sizeof(line), "Grid:         %dx%d, %d triangles, %d clusters, %d abstract nodes\n",
+		config.m_gridDimensions.x, config.m_gridDimensions.y, result.m_numTriangles, result.m_numClusters, result.m_numAbstractNodes);
+	report += line;
+	snprintf(line, sizeof(line), "Build:        graph %.1f ms, hierarchy %.1f ms\n", 1000.0 * result.m_graphBuildSeconds, 1000.0 * result.m_hierarchyBuildSeconds);
+	report += line;
+
+	report += "search       queries   mean (ms)   p50 (ms)   p99 (ms)   max (ms)\n";
+	FrameTimeHistogram const* histograms[2] = { &result.m_flatQueryTimes, &result.m_hierarchyQueryTimes };
+	char const* names[2] = { "flat A*", "HPA*" };
+	for (int index = 0; index < 2; index++)
+	{
+		FrameTimeHistogram const& histogram = *histograms[index];
+		snprintf(line, sizeof(line), "%-12s %7u %11.3f %10.3f %10.3f %10.3f\n", names[index], histogram.GetCount(),
+			1000.0 * histogram.GetMeanSeconds(), 1000.0 * histogram.GetPercentileSeconds(50.0),
+			1000.0 * histogram.GetPercentileSeconds(99.0), 1000.0 * histogram.GetMaxSeconds());
+		report += line;
+	}
+
+	snprintf(line, sizeof(line), "HPA* cost:    %.3fx flat, %d failed\n", result.m_averageCostRatio, result.m_numHierarchyFailures);
+	report += line;
+	return report;
+}
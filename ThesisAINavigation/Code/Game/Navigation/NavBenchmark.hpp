@@ -0,0 +1,42 @@
+#pragma once
+#include "Game/Diagnostics/FrameTimeHistogram.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include <string>
+
+class NavGraph;
+
+//------------------------------------------------------------------------------------------------
+// Times random long range corridor queries through the flat search and through HPA* on the same
+// start and goal pairs. The NavGraph is built straight from a jittered, gently rolling vertex grid
+// instead of the Terrain and engine NavMesh, so it reaches sizes a game mode cannot (MapConfig
+// tops out around 300x300). Pairs come from a fixed seed, so runs compare across changes.
+struct NavBenchmarkConfig
+{
+	IntVec2 m_gridDimensions = IntVec2(1000, 1000);
+	int m_numQueries = 100;
+	unsigned int m_seed = 1;
+};
+
+struct NavBenchmarkResult
+{
+	int m_numTriangles = 0;
+	int m_numClusters = 0;
+	int m_numAbstractNodes = 0;
+	double m_graphBuildSeconds = 0.0;
+	double m_hierarchyBuildSeconds = 0.0;
+
+	FrameTimeHistogram m_flatQueryTimes;
+	FrameTimeHistogram m_hierarchyQueryTimes;
+	double m_averageCostRatio = 0.0; // HPA* corridor cost over the flat one, for pairs both found
+	int m_numHierarchyFailures = 0;
+};
+
+class NavBenchmark
+{
+public:
+	static NavBenchmarkResult Run(NavBenchmarkConfig const& config);
+	static std::string GetReport(NavBenchmarkConfig const& config, NavBenchmarkResult const& result);
+
+	// Every vertex walkable, so the triangle count is always 2 * (w - 1) * (h - 1)
+	static void BuildGridGraph(IntVec2 const& gridDimensions, unsigned int seed, NavGraph& out_navGraph);
+};
@@ -0,0 +1,275 @@
+#include "Game/Navigation/NavDStarLite.hpp"
+#include "Game/Navigation/NavGraph.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+#include <cfloat>
+
+// Min heap on the lexicographic key
+static bool IsDStarEntryWorse(NavDStarLite::OpenEntry const& a, NavDStarLite::OpenEntry const& b)
+{
+	return b.m_key < a.m_key;
+}
+
+// Costs are either finite or FLT_MAX, the sum must not wrap a blocked edge into a usable one
+static float AddCosts(float a, float b)
+{
+	return (a == FLT_MAX || b == FLT_MAX) ? FLT_MAX : a + b;
+}
+
+bool NavDStarLite::Plan(NavGraph const* navGraph, int startTriangle, int goalTriangle)
+{
+	m_lastPlanStats = NavSearchStats();
+	if (navGraph == nullptr || startTriangle == NAV_INVALID_INDEX || goalTriangle == NAV_INVALID_INDEX) return false;
+
+	// Each cost change bumps the version once and adds one log entry, anything else was a rebuild
+	int numCostChanges = static_cast<int>(navGraph->m_costChangeLog.size());
+	bool isRebuilt = (numCostChanges < m_syncedCostChanges) || (navGraph->m_version - m_syncedGraphVersion != static_cast<unsigned int>(numCostChanges - m_syncedCostChanges));
+	if (!IsPlannedFor(navGraph, goalTriangle) || isRebuilt)
+	{
+		Initialize(navGraph, startTriangle, goalTriangle);
+	}
+	else
+	{
+		// The agent moved, keys already queued stay valid lower bounds with the modifier added
+		m_keyModifier += GetHeuristic(m_lastStartTriangle, startTriangle);
+		m_lastStartTriangle = startTriangle;
+		m_startTriangle = startTriangle;
+		ApplyCostChanges();
+	}
+
+	return ComputeShortestPath();
+}
+
+bool NavDStarLite::ExtractCorridor(std::vector<int>& out_corridor) const
+{
+	out_corridor.clear();
+	if (m_navGraph == nullptr || GetG(m_startTriangle) == FLT_MAX) return false;
+
+	// Greedy descent on g, bounded in case the caller reads between a cost change and the repair
+	int currentTriangle = m_startTriangle;
+	out_corridor.emplace_back(currentTriangle);
+	while (currentTriangle != m_goalTriangle)
+	{
+		int bestTriangle = NAV_INVALID_INDEX;
+		float bestCost = FLT_MAX;
+		NavTriangle const& triangle = m_navGraph->m_triangles[currentTriangle];
+		for (int edge = 0; edge < 3; edge++)
+		{
+			int neighborTriangle = triangle.m_neighborIndexes[edge];
+			if (neighborTriangle == NAV_INVALID_INDEX) continue;
+
+			float cost = AddCosts(m_navGraph->GetEdgeCost(currentTriangle, neighborTriangle), GetG(neighborTriangle));
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestTriangle = neighborTriangle;
+			}
+		}
+
+		if (bestTriangle == NAV_INVALID_INDEX || static_cast<int>(out_corridor.size()) > m_navGraph->GetNumTriangles()) return false;
+
+		currentTriangle = bestTriangle;
+		out_corridor.emplace_back(currentTriangle);
+	}
+	return true;
+}
+
+bool NavDStarLite::IsPlannedFor(NavGraph const* navGraph, int goalTriangle) const
+{
+	return m_navGraph != nullptr && m_navGraph == navGraph && m_goalTriangle == goalTriangle;
+}
+
+bool NavDStarLite::HasPendingChanges(NavGraph const* navGraph) const
+{
+	return m_navGraph == navGraph && m_navGraph != nullptr && m_syncedGraphVersion != navGraph->m_version;
+}
+
+void NavDStarLite::Reset()
+{
+	m_navGraph = nullptr;
+	m_nodes.clear();
+	m_openHeap.clear();
+	m_startTriangle = NAV_INVALID_INDEX;
+	m_goalTriangle = NAV_INVALID_INDEX;
+	m_lastStartTriangle = NAV_INVALID_INDEX;
+	m_keyModifier = 0.f;
+}
+
+void NavDStarLite::Initialize(NavGraph const* navGraph, int startTriangle, int goalTriangle)
+{
+	Reset();
+	m_navGraph = navGraph;
+	m_startTriangle = startTriangle;
+	m_lastStartTriangle = startTriangle;
+	m_goalTriangle = goalTriangle;
+	m_syncedGraphVersion = navGraph->m_version;
+	m_syncedCostChanges = static_cast<int>(navGraph->m_costChangeLog.size());
+
+	GetNode(goalTriangle).m_rhs = 0.f;
+	PushOpen(goalTriangle, CalculateKey(goalTriangle));
+}
+
+void NavDStarLite::ApplyCostChanges()
+{
+	// A triangle's scale is the cost of entering it, so only the edges from its neighbors changed
+	std::vector<int> const& costChangeLog = m_navGraph->m_costChangeLog;
+	for (int changeIndex = m_syncedCostChanges; changeIndex < static_cast<int>(costChangeLog.size()); changeIndex++)
+	{
+		NavTriangle const& triangle = m_navGraph->m_triangles[costChangeLog[changeIndex]];
+		for (int edge = 0; edge < 3; edge++)
+		{
+			int neighborTriangle = triangle.m_neighborIndexes[edge];
+			if (neighborTriangle == NAV_INVALID_INDEX) continue;
+
+			UpdateVertex(neighborTriangle);
+		}
+	}
+
+	m_syncedGraphVersion = m_navGraph->m_version;
+	m_syncedCostChanges = static_cast<int>(costChangeLog.size());
+}
+
+bool NavDStarLite::ComputeShortestPath()
+{
+	OpenEntry top;
+	while (PeekOpen(top) && m_lastPlanStats.m_numExpanded < NAV_DSTAR_MAX_EXPANSIONS)
+	{
+		if (!(top.m_key < CalculateKey(m_startTriangle)) && GetRhs(m_startTriangle) == GetG(m_startTriangle)) break;
+
+		std::pop_heap(m_openHeap.begin(), m_openHeap.end(), IsDStarEntryWorse);
+		m_openHeap.pop_back();
+		m_lastPlanStats.m_numExpanded++;
+
+		int currentTriangle = top.m_triangleIndex;
+		Node& node = GetNode(currentTriangle);
+		Key newKey = CalculateKey(currentTriangle);
+		if (top.m_key < newKey)
+		{
+			PushOpen(currentTriangle, newKey);
+			continue;
+		}
+
+		node.m_isOpen = false;
+		if (node.m_g > node.m_rhs)
+		{
+			node.m_g = node.m_rhs;
+		}
+		else
+		{
+			node.m_g = FLT_MAX;
+			UpdateVertex(currentTriangle);
+		}
+
+		NavTriangle const& triangle = m_navGraph->m_triangles[currentTriangle];
+		for (int edge = 0; edge < 3; edge++)
+		{
+			int neighborTriangle = triangle.m_neighborIndexes[edge];
+			if (neighborTriangle == NAV_INVALID_INDEX) continue;
+
+			UpdateVertex(neighborTriangle);
+		}
+	}
+
+	return GetG(m_startTriangle) != FLT_MAX;
+}
+
+NavDStarLite::Node& NavDStarLite::GetNode(int triangleIndex)
+{
+	auto found = m_nodes.find(triangleIndex);
+	if (found != m_nodes.end()) return found->second;
+
+	Node& node = m_nodes[triangleIndex];
+	node.m_g = FLT_MAX;
+	node.m_rhs = FLT_MAX;
+	return node;
+}
+
+float NavDStarLite::GetG(int triangleIndex) const
+{
+	auto found = m_nodes.find(triangleIndex);
+	return (found != m_nodes.end()) ? found->second.m_g : FLT_MAX;
+}
+
+float NavDStarLite::GetRhs(int triangleIndex) const
+{
+	auto found = m_nodes.find(triangleIndex);
+	return (found != m_nodes.end()) ? found->second.m_rhs : FLT_MAX;
+}
+
+float NavDStarLite::GetHeuristic(int fromTriangle, int toTriangle) const
+{
+	return GetDistance3D(m_navGraph->m_triangles[fromTriangle].m_centroid, m_navGraph->m_triangles[toTriangle].m_centroid);
+}
+
+NavDStarLite::Key NavDStarLite::CalculateKey(int triangleIndex) const
+{
+	float minCost = std::min(GetG(triangleIndex), GetRhs(triangleIndex));
+
+	Key key;
+	key.m_primary = AddCosts(AddCosts(minCost, GetHeuristic(m_startTriangle, triangleIndex)), m_keyModifier);
+	key.m_secondary = minCost;
+	return key;
+}
+
+void NavDStarLite::UpdateVertex(int triangleIndex)
+{
+	Node& node = GetNode(triangleIndex);
+	if (triangleIndex != m_goalTriangle)
+	{
+		float bestRhs = FLT_MAX;
+		NavTriangle const& triangle = m_navGraph->m_triangles[triangleIndex];
+		for (int edge = 0; edge < 3; edge++)
+		{
+			int neighborTriangle = triangle.m_neighborIndexes[edge];
+			if (neighborTriangle == NAV_INVALID_INDEX) continue;
+
+			bestRhs = std::min(bestRhs, AddCosts(m_navGraph->GetEdgeCost(triangleIndex, neighborTriangle), GetG(neighborTriangle)));
+		}
+		node.m_rhs = bestRhs;
+	}
+
+	// Inconsistent nodes go (back) on the open list, older heap entries for them turn stale
+	if (node.m_g != node.m_rhs)
+	{
+		PushOpen(triangleIndex, CalculateKey(triangleIndex));
+	}
+	else
+	{
+		node.m_isOpen = false;
+	}
+}
+
+void NavDStarLite::PushOpen(int triangleIndex, Key const& key)
+{
+	Node& node = GetNode(triangleIndex);
+	node.m_openKey = key;
+	node.m_isOpen = true;
+
+	OpenEntry entry;
+	entry.m_key = key;
+	entry.m_triangleIndex = triangleIndex;
+	m_openHeap.emplace_back(entry);
+	std::push_heap(m_openHeap.begin(), m_openHeap.end(), IsDStarEntryWorse);
+
+	m_lastPlanStats.m_numPushed++;
+	m_lastPlanStats.m_peakOpenSize = std::max(m_lastPlanStats.m_peakOpenSize, static_cast<int>(m_openHeap.size()));
+}
+
+bool NavDStarLite::PeekOpen(OpenEntry& out_entry)
+{
+	// The heap has no decrease-key, entries that no longer match their node are dropped here
+	while (!m_openHeap.empty())
+	{
+		OpenEntry const& top = m_openHeap.front();
+		auto found = m_nodes.find(top.m_triangleIndex);
+		if (found != m_nodes.end() && found->second.m_isOpen && found->second.m_openKey == top.m_key)
+		{
+			out_entry = top;
+			return true;
+		}
+
+		std::pop_heap(m_openHeap.begin(), m_openHeap.end(), IsDStarEntryWorse);
+		m_openHeap.pop_back();
+	}
+	return false;
+}
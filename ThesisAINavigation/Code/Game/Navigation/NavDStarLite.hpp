@@ -0,0 +1,84 @@
+#pragma once
+#include "Game/Navigation/NavSearchContext.hpp"
+#include <unordered_map>
+#include <vector>
+
+class NavGraph;
+
+constexpr int NAV_DSTAR_MAX_EXPANSIONS = 1000000;
+
+//------------------------------------------------------------------------------------------------
+// One agent's D* Lite search over the NavGraph triangles (Koenig and Likhachev). The search runs
+// backwards from the goal, so when the agent moves only the key modifier changes, and when
+// triangle costs change only the nodes around them are put back on the open list. Repairing after
+// an obstacle appears touches the part of the tree the change actually affects instead of
+// searching again from scratch. Node state is sparse, only triangles the search reached are kept.
+class NavDStarLite
+{
+public:
+	NavDStarLite() = default;
+	~NavDStarLite() = default;
+
+	// Repairs the existing search when only the start moved or costs changed, otherwise starts over.
+	// Not thread safe, one planner is used by one job at a time.
+	bool Plan(NavGraph const* navGraph, int startTriangle, int goalTriangle);
+	bool ExtractCorridor(std::vector<int>& out_corridor) const;
+
+	bool IsPlannedFor(NavGraph const* navGraph, int goalTriangle) const;
+	bool HasPendingChanges(NavGraph const* navGraph) const;
+	void Reset();
+
+public:
+	struct Key
+	{
+		float m_primary = 0.f;
+		float m_secondary = 0.f;
+
+		bool operator<(Key const& other) const { return (m_primary < other.m_primary) || (m_primary == other.m_primary && m_secondary < other.m_secondary); }
+		bool operator==(Key const& other) const { return m_primary == other.m_primary && m_secondary == other.m_secondary; }
+	};
+
+	struct Node
+	{
+		float m_g;
+		float m_rhs;
+		Key m_openKey;
+		bool m_isOpen = false;
+	};
+
+	struct OpenEntry
+	{
+		Key m_key;
+		int m_triangleIndex = -1;
+	};
+
+private:
+	void Initialize(NavGraph const* navGraph, int startTriangle, int goalTriangle);
+	void ApplyCostChanges();
+	bool ComputeShortestPath();
+
+	Node& GetNode(int triangleIndex);
+	float GetG(int triangleIndex) const;
+	float GetRhs(int triangleIndex) const;
+	float GetHeuristic(int fromTriangle, int toTriangle) const;
+	Key CalculateKey(int triangleIndex) const;
+	void UpdateVertex(int triangleIndex);
+	void PushOpen(int triangleIndex, Key const& key);
+	bool PeekOpen(OpenEntry& out_entry);
+
+public:
+	NavGraph const* m_navGraph = nullptr;
+	int m_startTriangle = -1;
+	int m_goalTriangle = -1;
+	NavSearchStats m_lastPlanStats; // Repairs only count their own work, the heap size includes what earlier plans left queued
+
+private:
+	std::unordered_map<int, Node> m_nodes;
+	std::vector<OpenEntry> m_openHeap;
+	int m_lastStartTriangle = -1;
+	float m_keyModifier = 0.f;
+
+	// How much of the graph's history this search has seen, see NavGraph::m_costChangeLog
+	unsigned int m_syncedGraphVersion = 0;
+	int m_syncedCostChanges = 0;
+};
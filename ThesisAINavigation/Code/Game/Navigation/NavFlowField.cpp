@@ -0,0 +1,75 @@
+#include "Game/Navigation/NavFlowField.hpp"
+#include "Game/Diagnostics/Profiler.hpp"
+#include "Game/Navigation/NavSearchContext.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <cfloat>
+
+void NavFlowField::Build(NavGraph const* navGraph, Vec3 const& goalPoint)
+{
+	m_navGraph = navGraph;
+	m_graphVersion = navGraph->m_version;
+	m_goalPoint = goalPoint;
+	m_goalTriangle = navGraph->FindNearestTriangle(goalPoint);
+
+	int numTriangles = navGraph->GetNumTriangles();
+	m_nextTriangles.assign(static_cast<size_t>(numTriangles), NAV_FLOW_UNREACHABLE);
+	m_distances.assign(static_cast<size_t>(numTriangles), FLT_MAX);
+	if (m_goalTriangle == NAV_INVALID_INDEX) return;
+
+	// Plain Dijkstra on the thread's search context, a triangle's parent in the tree is its next hop
+	NavSearchContext& context = NavSearchContext::GetForCurrentThread();
+	context.BeginSearch(numTriangles);
+	context.MarkSeen(m_goalTriangle, 0.f, NAV_INVALID_INDEX);
+	context.PushOpen(m_goalTriangle, 0.f);
+
+	std::vector<NavTriangle> const& triangles = navGraph->m_triangles;
+	while (!context.IsOpenEmpty())
+	{
+		int currentTriangle = context.PopOpen().m_triangleIndex;
+		if (context.IsClosed(currentTriangle)) continue;
+		context.MarkClosed(currentTriangle);
+
+		float currentCost = context.m_gCosts[currentTriangle];
+		m_nextTriangles[currentTriangle] = context.m_parentIndexes[currentTriangle];
+		m_distances[currentTriangle] = currentCost;
+
+		NavTriangle const& triangle = triangles[currentTriangle];
+		for (int edge = 0; edge < 3; edge++)
+		{
+			int neighborTriangle = triangle.m_neighborIndexes[edge];
+			if (neighborTriangle == NAV_INVALID_INDEX || context.IsClosed(neighborTriangle)) continue;
+
+			// Agents walk toward the goal, so the cost is stepping from the neighbor into this triangle
+			float edgeCost = navGraph->GetEdgeCost(neighborTriangle, currentTriangle);
+			if (edgeCost == FLT_MAX) continue;
+
+			float cost = currentCost + edgeCost;
+			if (context.IsSeen(neighborTriangle) && cost >= context.m_gCosts[neighborTriangle]) continue;
+
+			context.MarkSeen(neighborTriangle, cost, currentTriangle);
+			context.PushOpen(neighborTriangle, cost);
+		}
+	}
+}
+
+bool NavFlowField::IsBuiltFor(NavGraph const* navGraph) const
+{
+	return navGraph != nullptr && m_navGraph == navGraph && m_graphVersion == navGraph->m_version;
+}
+
+bool NavFlowField::GetSteeringTarget(int triangleIndex, Vec3& out_target) const
+{
+	if (triangleIndex == NAV_INVALID_INDEX || !IsReachable(triangleIndex)) return false;
+
+	int nextTriangle = m_nextTriangles[triangleIndex];
+	out_target = (nextTriangle == NAV_INVALID_INDEX) ? m_goalPoint : m_navGraph->m_triangles[nextTriangle].m_centroid;
+	return true;
+}
+
+void NavFlowFieldJob::ExecuteGameJob()
+{
+	PROFILE_ZONE("NavFlowFieldJob");
+	m_flowField = new NavFlowField();
+	m_flowField->Build(m_navGraph, m_goalPoint);
+	m_numNavJobsInFlight--;
+}
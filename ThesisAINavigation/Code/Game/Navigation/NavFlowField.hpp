@@ -0,0 +1,62 @@
+#pragma once
+#include "Game/JobCompletionDispatcher.hpp"
+#include "Game/Navigation/NavGraph.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <atomic>
+#include <vector>
+
+class Map;
+
+//------------------------------------------------------------------------------------------------
+// Every triangle's next hop toward one shared goal, from a single reverse Dijkstra over the NavGraph
+// rooted at the goal triangle. Edge costs are not symmetric, since stepping into a triangle is scaled
+// by that triangle's cost, so the search relaxes every edge in the walking direction, neighbor into
+// current, and the tree holds each triangle's shortest path to the goal. Agents look up their
+// triangle's next hop instead of running their own search, which costs the same for ten agents or
+// ten thousand.
+class NavFlowField
+{
+public:
+	NavFlowField() = default;
+	~NavFlowField() = default;
+
+	void Build(NavGraph const* navGraph, Vec3 const& goalPoint);
+	bool IsBuiltFor(NavGraph const* navGraph) const;
+
+	// Where an agent standing in the triangle should head next: the next hop's centroid, or the goal
+	// point itself once in the goal triangle. Unreachable triangles return false.
+	bool GetSteeringTarget(int triangleIndex, Vec3& out_target) const;
+	bool IsReachable(int triangleIndex) const { return m_nextTriangles[triangleIndex] != NAV_FLOW_UNREACHABLE; }
+
+public:
+	static constexpr int NAV_FLOW_UNREACHABLE = -2;
+
+	NavGraph const* m_navGraph = nullptr;
+	unsigned int m_graphVersion = 0;
+	Vec3 m_goalPoint = Vec3::ZERO;
+	int m_goalTriangle = NAV_INVALID_INDEX;
+
+	// Per triangle, NAV_INVALID_INDEX on the goal triangle itself
+	std::vector<int> m_nextTriangles;
+	std::vector<float> m_distances;
+};
+
+//------------------------------------------------------------------------------------------------
+// Builds a flow field off the main thread. The finished field is handed over in the completion
+// callback, so the one agents are following is never written while they read it.
+class NavFlowFieldJob : public GameJob
+{
+public:
+	NavFlowFieldJob(Map* map, NavGraph const* navGraph, Vec3 const& goalPoint, std::atomic<int>& numNavJobsInFlight)
+		: GameJob(GameJobType::FLOW_FIELD_BUILD), m_map(map), m_navGraph(navGraph), m_goalPoint(goalPoint), m_numNavJobsInFlight(numNavJobsInFlight) {}
+	virtual ~NavFlowFieldJob() { delete m_flowField; }
+
+	virtual void ExecuteGameJob() override;
+
+public:
+	Map* m_map = nullptr;
+	NavGraph const* m_navGraph = nullptr;
+	Vec3 m_goalPoint = Vec3::ZERO;
+	NavFlowField* m_flowField = nullptr; // Owned until the completion callback takes it
+	std::atomic<int>& m_numNavJobsInFlight;
+};
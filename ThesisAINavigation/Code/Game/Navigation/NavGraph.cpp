@@ -0,0 +1,556 @@
+#include "Game/Navigation/NavGraph.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+constexpr unsigned long long EMPTY_EDGE_KEY = ~0ull;
+
+void NavGraph::Build(std::vector<Vec3> const& vertices, int gridWidth, int gridHeight, std::vector<int> const& vertexMapping)
+{
+	Clear();
+	m_vertices = vertices;
+
+	int numQuads = 0;
+	for (int y = 0; y < gridHeight - 1; y++)
+	{
+		for (int x = 0; x < gridWidth - 1; x++)
+		{
+			if (IsQuadMapped(x, y, gridWidth, vertexMapping)) numQuads++;
+		}
+	}
+	m_triangles.resize(static_cast<size_t>(numQuads) * 2);
+
+	int triangleIndex = 0;
+	for (int y = 0; y < gridHeight - 1; y++)
+	{
+		for (int x = 0; x < gridWidth - 1; x++)
+		{
+			if (!IsQuadMapped(x, y, gridWidth, vertexMapping)) continue;
+
+			int bottomLeft = vertexMapping[(y * gridWidth) + x];
+			int bottomRight = vertexMapping[(y * gridWidth) + x + 1];
+			int topLeft = vertexMapping[((y + 1) * gridWidth) + x];
+			int topRight = vertexMapping[((y + 1) * gridWidth) + x + 1];
+			WriteQuadTriangles(triangleIndex, y, bottomLeft, bottomRight, topLeft, topRight);
+			triangleIndex += 2;
+		}
+	}
+
+	LinkEdges(0, GetNumTriangles(), false);
+	m_version++;
+	BuildPointGrid();
+	LabelComponents();
+}
+
+bool NavGraph::IsQuadMapped(int x, int y, int gridWidth, std::vector<int> const& vertexMapping)
+{
+	return vertexMapping[(y * gridWidth) + x] >= 0 && vertexMapping[(y * gridWidth) + x + 1] >= 0 &&
+		vertexMapping[((y + 1) * gridWidth) + x] >= 0 && vertexMapping[((y + 1) * gridWidth) + x + 1] >= 0;
+}
+
+void NavGraph::WriteQuadTriangles(int triangleIndex, int gridRow, int bottomLeft, int bottomRight, int topLeft, int topRight)
+{
+	// Odd rows are shifted right, flipping the diagonal keeps the triangles closer to equilateral
+	if (gridRow % 2 == 0)
+	{
+		WriteTriangle(triangleIndex, bottomLeft, bottomRight, topRight);
+		WriteTriangle(triangleIndex + 1, bottomLeft, topRight, topLeft);
+	}
+	else
+	{
+		WriteTriangle(triangleIndex, bottomLeft, bottomRight, topLeft);
+		WriteTriangle(triangleIndex + 1, bottomRight, topRight, topLeft);
+	}
+}
+
+void NavGraph::Clear()
+{
+	m_vertices.clear();
+	m_triangles.clear();
+	m_triangleCostScales.clear();
+	m_costChangeLog.clear();
+	m_triangleComponents.clear();
+	m_componentFirstTriangles.clear();
+	m_componentTriangles.clear();
+	m_componentsVersion = 0;
+	m_componentAreaSampler.Clear();
+	m_areaSampler.Clear();
+	m_gridNumCellsX = 0;
+	m_gridNumCellsY = 0;
+	m_gridCellFirstTriangles.clear();
+	m_gridCellTriangles.clear();
+}
+
+void NavGraph::BuildPointGrid()
+{
+	m_gridNumCellsX = 0;
+	m_gridNumCellsY = 0;
+	m_gridCellFirstTriangles.clear();
+	m_gridCellTriangles.clear();
+	if (IsEmpty()) return;
+
+	float minX = FLT_MAX;
+	float minY = FLT_MAX;
+	float maxX = -FLT_MAX;
+	float maxY = -FLT_MAX;
+	for (Vec3 const& vertex : m_vertices)
+	{
+		minX = std::min(minX, vertex.x);
+		minY = std::min(minY, vertex.y);
+		maxX = std::max(maxX, vertex.x);
+		maxY = std::max(maxY, vertex.y);
+	}
+
+	// Sized so a cell holds a handful of triangles
+	float areaPerTriangle = ((maxX - minX) * (maxY - minY)) / static_cast<float>(GetNumTriangles());
+	m_gridCellSize = std::max(sqrtf(areaPerTriangle * 4.f), 0.01f);
+	m_gridOriginX = minX;
+	m_gridOriginY = minY;
+	m_gridNumCellsX = static_cast<int>((maxX - minX) / m_gridCellSize) + 1;
+	m_gridNumCellsY = static_cast<int>((maxY - minY) / m_gridCellSize) + 1;
+
+	// Count, prefix sum, fill
+	int numCells = m_gridNumCellsX * m_gridNumCellsY;
+	m_gridCellFirstTriangles.assign(static_cast<size_t>(numCells) + 1, 0);
+	for (int pass = 0; pass < 2; pass++)
+	{
+		for (int triangleIndex = 0; triangleIndex < GetNumTriangles(); triangleIndex++)
+		{
+			Vec3 const& a = GetTriangleVertex(triangleIndex, 0);
+			Vec3 const& b = GetTriangleVertex(triangleIndex, 1);
+			Vec3 const& c = GetTriangleVertex(triangleIndex, 2);
+			int minCellX = GetGridCellX(std::min(a.x, std::min(b.x, c.x)));
+			int maxCellX = GetGridCellX(std::max(a.x, std::max(b.x, c.x)));
+			int minCellY = GetGridCellY(std::min(a.y, std::min(b.y, c.y)));
+			int maxCellY = GetGridCellY(std::max(a.y, std::max(b.y, c.y)));
+			for (int cellY = minCellY; cellY <= maxCellY; cellY++)
+			{
+				for (int cellX = minCellX; cellX <= maxCellX; cellX++)
+				{
+					int cellIndex = (cellY * m_gridNumCellsX) + cellX;
+					if (pass == 0)
+					{
+						m_gridCellFirstTriangles[cellIndex + 1]++;
+					}
+					else
+					{
+						m_gridCellTriangles[m_gridCellFirstTriangles[cellIndex]++] = triangleIndex;
+					}
+				}
+			}
+		}
+
+		if (pass == 0)
+		{
+			for (int cellIndex = 0; cellIndex < numCells; cellIndex++)
+			{
+				m_gridCellFirstTriangles[cellIndex + 1] += m_gridCellFirstTriangles[cellIndex];
+			}
+			m_gridCellTriangles.resize(static_cast<size_t>(m_gridCellFirstTriangles[numCells]));
+		}
+	}
+
+	// Filling advanced every cell's start to the next cell's start, shift them back
+	for (int cellIndex = numCells; cellIndex > 0; cellIndex--)
+	{
+		m_gridCellFirstTriangles[cellIndex] = m_gridCellFirstTriangles[cellIndex - 1];
+	}
+	m_gridCellFirstTriangles[0] = 0;
+}
+
+int NavGraph::GetGridCellX(float x) const
+{
+	int cellX = static_cast<int>((x - m_gridOriginX) / m_gridCellSize);
+	return std::min(std::max(cellX, 0), m_gridNumCellsX - 1);
+}
+
+int NavGraph::GetGridCellY(float y) const
+{
+	int cellY = static_cast<int>((y - m_gridOriginY) / m_gridCellSize);
+	return std::min(std::max(cellY, 0), m_gridNumCellsY - 1);
+}
+
+int NavGraph::FindContainingTriangle(Vec3 const& point) const
+{
+	if (m_gridCellFirstTriangles.empty())
+	{
+		for (int triangleIndex = 0; triangleIndex < GetNumTriangles(); triangleIndex++)
+		{
+			if (IsPointInsideTriangleXY(triangleIndex, point))
+			{
+				return triangleIndex;
+			}
+		}
+		return NAV_INVALID_INDEX;
+	}
+
+	int cellIndex = (GetGridCellY(point.y) * m_gridNumCellsX) + GetGridCellX(point.x);
+	for (int slot = m_gridCellFirstTriangles[cellIndex]; slot < m_gridCellFirstTriangles[cellIndex + 1]; slot++)
+	{
+		if (IsPointInsideTriangleXY(m_gridCellTriangles[slot], point))
+		{
+			return m_gridCellTriangles[slot];
+		}
+	}
+	return NAV_INVALID_INDEX;
+}
+
+int NavGraph::FindNearestTriangle(Vec3 const& point) const
+{
+	int containingTriangle = FindContainingTriangle(point);
+	if (containingTriangle != NAV_INVALID_INDEX) return containingTriangle;
+
+	int nearestTriangle = NAV_INVALID_INDEX;
+	float nearestDistanceSq = FLT_MAX;
+	auto checkTriangle = [&](int triangleIndex)
+	{
+		Vec3 const& centroid = m_triangles[triangleIndex].m_centroid;
+		float dx = centroid.x - point.x;
+		float dy = centroid.y - point.y;
+		float distanceSq = (dx * dx) + (dy * dy);
+		if (distanceSq < nearestDistanceSq)
+		{
+			nearestDistanceSq = distanceSq;
+			nearestTriangle = triangleIndex;
+		}
+	};
+
+	if (m_gridCellFirstTriangles.empty())
+	{
+		for (int triangleIndex = 0; triangleIndex < GetNumTriangles(); triangleIndex++)
+		{
+			checkTriangle(triangleIndex);
+		}
+		return nearestTriangle;
+	}
+
+	// Search rings of cells around the point's cell. The stop test measures from the point itself to
+	// the edges of the block searched so far, since a point off the grid is clamped to an edge cell and
+	// may sit far outside it. Only edges with unsearched cells beyond them count.
+	int centerX = GetGridCellX(point.x);
+	int centerY = GetGridCellY(point.y);
+	int maxRing = std::max(m_gridNumCellsX, m_gridNumCellsY);
+	for (int ring = 0; ring <= maxRing; ring++)
+	{
+		for (int cellY = centerY - ring; cellY <= centerY + ring; cellY++)
+		{
+			if (cellY < 0 || cellY >= m_gridNumCellsY) continue;
+
+			// Inner rows only contribute their two end cells
+			bool isEdgeRow = (cellY == centerY - ring || cellY == centerY + ring);
+			int stepX = (isEdgeRow || ring == 0) ? 1 : 2 * ring;
+			for (int cellX = centerX - ring; cellX <= centerX + ring; cellX += stepX)
+			{
+				if (cellX < 0 || cellX >= m_gridNumCellsX) continue;
+
+				int cellIndex = (cellY * m_gridNumCellsX) + cellX;
+				for (int slot = m_gridCellFirstTriangles[cellIndex]; slot < m_gridCellFirstTriangles[cellIndex + 1]; slot++)
+				{
+					checkTriangle(m_gridCellTriangles[slot]);
+				}
+			}
+		}
+
+		if (nearestTriangle == NAV_INVALID_INDEX) continue;
+
+		float unsearchedDistance = FLT_MAX;
+		if (centerX - ring > 0)
+		{
+			unsearchedDistance = std::min(unsearchedDistance, point.x - (m_gridOriginX + static_cast<float>(centerX - ring) * m_gridCellSize));
+		}
+		if (centerX + ring < m_gridNumCellsX - 1)
+		{
+			unsearchedDistance = std::min(unsearchedDistance, (m_gridOriginX + static_cast<float>(centerX + ring + 1) * m_gridCellSize) - point.x);
+		}
+		if (centerY - ring > 0)
+		{
+			unsearchedDistance = std::min(unsearchedDistance, point.y - (m_gridOriginY + static_cast<float>(centerY - ring) * m_gridCellSize));
+		}
+		if (centerY + ring < m_gridNumCellsY - 1)
+		{
+			unsearchedDistance = std::min(unsearchedDistance, (m_gridOriginY + static_cast<float>(centerY + ring + 1) * m_gridCellSize) - point.y);
+		}
+		if (unsearchedDistance == FLT_MAX) break; // Every cell has been searched
+		if (unsearchedDistance > 0.f && nearestDistanceSq <= unsearchedDistance * unsearchedDistance) break;
+	}
+	return nearestTriangle;
+}
+
+int NavGraph::FindNearestTriangleFromHint(Vec3 const& point, int hintTriangle) const
+{
+	if (hintTriangle < 0 || hintTriangle >= GetNumTriangles()) return FindNearestTriangle(point);
+
+	// Step out through the edge the point lies beyond, as seen from inside the current triangle
+	int triangleIndex = hintTriangle;
+	for (int step = 0; step < NAV_POINT_WALK_MAX_STEPS; step++)
+	{
+		if (IsPointInsideTriangleXY(triangleIndex, point)) return triangleIndex;
+
+		NavTriangle const& triangle = m_triangles[triangleIndex];
+		int nextTriangle = NAV_INVALID_INDEX;
+		for (int edge = 0; edge < 3; edge++)
+		{
+			Vec3 const& edgeStart = GetTriangleVertex(triangleIndex, edge);
+			Vec3 const& edgeEnd = GetTriangleVertex(triangleIndex, (edge + 1) % 3);
+			float edgeX = edgeEnd.x - edgeStart.x;
+			float edgeY = edgeEnd.y - edgeStart.y;
+			float centroidSide = (edgeX * (triangle.m_centroid.y - edgeStart.y)) - (edgeY * (triangle.m_centroid.x - edgeStart.x));
+			float pointSide = (edgeX * (point.y - edgeStart.y)) - (edgeY * (point.x - edgeStart.x));
+			if ((centroidSide > 0.f && pointSide < 0.f) || (centroidSide < 0.f && pointSide > 0.f))
+			{
+				nextTriangle = triangle.m_neighborIndexes[edge];
+				break;
+			}
+		}
+
+		// Off the mesh or walked into a degenerate sliver
+		if (nextTriangle == NAV_INVALID_INDEX) break;
+		triangleIndex = nextTriangle;
+	}
+
+	return FindNearestTriangle(point);
+}
+
+float NavGraph::GetEdgeCost(int fromTriangle, int toTriangle) const
+{
+	float costScale = GetTriangleCostScale(toTriangle);
+	if (costScale >= NAV_BLOCKED_COST_SCALE) return FLT_MAX;
+
+	return GetDistance3D(m_triangles[fromTriangle].m_centroid, m_triangles[toTriangle].m_centroid) * costScale;
+}
+
+float NavGraph::GetTriangleCostScale(int triangleIndex) const
+{
+	return m_triangleCostScales.empty() ? 1.f : m_triangleCostScales[triangleIndex];
+}
+
+void NavGraph::SetTriangleCostScale(int triangleIndex, float costScale)
+{
+	if (m_triangleCostScales.empty())
+	{
+		m_triangleCostScales.resize(m_triangles.size(), 1.f);
+	}
+
+	m_triangleCostScales[triangleIndex] = (costScale < 1.f) ? 1.f : costScale;
+	m_costChangeLog.emplace_back(triangleIndex);
+	m_version++;
+}
+
+void NavGraph::LabelComponents()
+{
+	int numTriangles = GetNumTriangles();
+	m_triangleComponents.assign(static_cast<size_t>(numTriangles), NAV_INVALID_INDEX);
+	m_componentFirstTriangles.clear();
+	m_componentTriangles.clear();
+	m_componentTriangles.reserve(static_cast<size_t>(numTriangles));
+
+	// Each flood fill appends its whole component, so the triangle list comes out grouped already
+	for (int seedTriangle = 0; seedTriangle < numTriangles; seedTriangle++)
+	{
+		if (m_triangleComponents[seedTriangle] != NAV_INVALID_INDEX || IsTriangleBlocked(seedTriangle)) continue;
+
+		int componentIndex = static_cast<int>(m_componentFirstTriangles.size());
+		int firstTriangle = static_cast<int>(m_componentTriangles.size());
+		m_componentFirstTriangles.emplace_back(firstTriangle);
+		m_triangleComponents[seedTriangle] = componentIndex;
+		m_componentTriangles.emplace_back(seedTriangle);
+
+		for (int queueIndex = firstTriangle; queueIndex < static_cast<int>(m_componentTriangles.size()); queueIndex++)
+		{
+			NavTriangle const& triangle = m_triangles[m_componentTriangles[queueIndex]];
+			for (int edge = 0; edge < 3; edge++)
+			{
+				int neighborTriangle = triangle.m_neighborIndexes[edge];
+				if (neighborTriangle == NAV_INVALID_INDEX || m_triangleComponents[neighborTriangle] != NAV_INVALID_INDEX || IsTriangleBlocked(neighborTriangle)) continue;
+
+				m_triangleComponents[neighborTriangle] = componentIndex;
+				m_componentTriangles.emplace_back(neighborTriangle);
+			}
+		}
+	}
+	int numSlots = static_cast<int>(m_componentTriangles.size());
+	m_componentFirstTriangles.emplace_back(numSlots);
+
+	std::vector<float> slotAreas(static_cast<size_t>(numSlots));
+	for (int slot = 0; slot < numSlots; slot++)
+	{
+		slotAreas[slot] = GetTriangleArea(m_componentTriangles[slot]);
+	}
+
+	m_componentAreaSampler.Resize(numSlots);
+	for (int componentIndex = 0; componentIndex < GetNumComponents(); componentIndex++)
+	{
+		int firstSlot = m_componentFirstTriangles[componentIndex];
+		m_componentAreaSampler.BuildRange(slotAreas, firstSlot, m_componentFirstTriangles[componentIndex + 1] - firstSlot);
+	}
+	m_areaSampler.Resize(numSlots);
+	m_areaSampler.BuildRange(slotAreas, 0, numSlots);
+
+	m_componentsVersion = m_version;
+}
+
+bool NavGraph::IsGoalReachable(int startTriangle, int goalTriangle) const
+{
+	if (goalTriangle == NAV_INVALID_INDEX) return false;
+
+	int goalComponent = GetComponent(goalTriangle);
+	if (goalComponent == NAV_INVALID_INDEX) return false;
+
+	int startComponent = (startTriangle == NAV_INVALID_INDEX) ? NAV_INVALID_INDEX : GetComponent(startTriangle);
+	return startComponent == NAV_INVALID_INDEX || startComponent == goalComponent;
+}
+
+int NavGraph::GetRandomTriangle(float slotZeroToOne, float aliasZeroToOne) const
+{
+	if (m_componentTriangles.empty()) return NAV_INVALID_INDEX;
+	return m_componentTriangles[m_areaSampler.Sample(0, static_cast<int>(m_componentTriangles.size()), slotZeroToOne, aliasZeroToOne)];
+}
+
+int NavGraph::GetRandomTriangleInComponent(int componentIndex, float slotZeroToOne, float aliasZeroToOne) const
+{
+	int firstSlot = m_componentFirstTriangles[componentIndex];
+	int numSlots = m_componentFirstTriangles[componentIndex + 1] - firstSlot;
+	return m_componentTriangles[m_componentAreaSampler.Sample(firstSlot, numSlots, slotZeroToOne, aliasZeroToOne)];
+}
+
+float NavGraph::GetTriangleArea(int triangleIndex) const
+{
+	Vec3 const& a = GetTriangleVertex(triangleIndex, 0);
+	Vec3 const& b = GetTriangleVertex(triangleIndex, 1);
+	Vec3 const& c = GetTriangleVertex(triangleIndex, 2);
+	Vec3 ab = b - a;
+	Vec3 ac = c - a;
+	Vec3 normal = Vec3((ab.y * ac.z) - (ab.z * ac.y), (ab.z * ac.x) - (ab.x * ac.z), (ab.x * ac.y) - (ab.y * ac.x));
+	return normal.GetLength() * 0.5f;
+}
+
+Vec3 NavGraph::GetPointInTriangle(int triangleIndex, float u, float v) const
+{
+	if (u + v > 1.f)
+	{
+		u = 1.f - u;
+		v = 1.f - v;
+	}
+
+	Vec3 const& a = GetTriangleVertex(triangleIndex, 0);
+	Vec3 const& b = GetTriangleVertex(triangleIndex, 1);
+	Vec3 const& c = GetTriangleVertex(triangleIndex, 2);
+	return a + ((b - a) * u) + ((c - a) * v);
+}
+
+bool NavGraph::IsPointInsideTriangleXY(int triangleIndex, Vec3 const& point) const
+{
+	// Vertex jitter can flip a sliver triangle's winding, so inside means the same side of every edge
+	bool hasNegative = false;
+	bool hasPositive = false;
+	for (int corner = 0; corner < 3; corner++)
+	{
+		Vec3 const& edgeStart = GetTriangleVertex(triangleIndex, corner);
+		Vec3 const& edgeEnd = GetTriangleVertex(triangleIndex, (corner + 1) % 3);
+
+		float cross = ((edgeEnd.x - edgeStart.x) * (point.y - edgeStart.y)) - ((edgeEnd.y - edgeStart.y) * (point.x - edgeStart.x));
+		hasNegative = hasNegative || (cross < 0.f);
+		hasPositive = hasPositive || (cross > 0.f);
+	}
+	return !(hasNegative && hasPositive);
+}
+
+float NavGraph::GetHeightOnTriangle(int triangleIndex, Vec3 const& point) const
+{
+	Vec3 const& a = GetTriangleVertex(triangleIndex, 0);
+	Vec3 const& b = GetTriangleVertex(triangleIndex, 1);
+	Vec3 const& c = GetTriangleVertex(triangleIndex, 2);
+
+	// Barycentric weights in XY
+	float denominator = ((b.y - c.y) * (a.x - c.x)) + ((c.x - b.x) * (a.y - c.y));
+	if (denominator == 0.f) return m_triangles[triangleIndex].m_centroid.z;
+
+	float weightA = (((b.y - c.y) * (point.x - c.x)) + ((c.x - b.x) * (point.y - c.y))) / denominator;
+	float weightB = (((c.y - a.y) * (point.x - c.x)) + ((a.x - c.x) * (point.y - c.y))) / denominator;
+	float weightC = 1.f - weightA - weightB;
+
+	return (weightA * a.z) + (weightB * b.z) + (weightC * c.z);
+}
+
+void NavGraph::WriteTriangle(int triangleIndex, int vertexIndexA, int vertexIndexB, int vertexIndexC)
+{
+	NavTriangle& triangle = m_triangles[triangleIndex];
+	triangle.m_vertexIndexes[0] = vertexIndexA;
+	triangle.m_vertexIndexes[1] = vertexIndexB;
+	triangle.m_vertexIndexes[2] = vertexIndexC;
+	for (int edge = 0; edge < 3; edge++)
+	{
+		triangle.m_neighborIndexes[edge] = NAV_INVALID_INDEX;
+	}
+	triangle.m_centroid = (m_vertices[vertexIndexA] + m_vertices[vertexIndexB] + m_vertices[vertexIndexC]) / 3.f;
+}
+
+void NavGraph::LinkEdges(int firstTriangle, int lastTriangle, bool onlyOpenEdges)
+{
+	// Each undirected edge is keyed by its sorted vertex pair, the second triangle to see it links up
+	// with the first. Open addressing with linear probing in one flat table kept at most half full, so
+	// the whole pass is linear in the triangle count and allocates twice.
+	size_t numEdges = static_cast<size_t>(lastTriangle - firstTriangle) * 3;
+	if (onlyOpenEdges)
+	{
+		// Stitching only sees the few edges still open, size the table for those
+		numEdges = 0;
+		for (int triangleIndex = firstTriangle; triangleIndex < lastTriangle; triangleIndex++)
+		{
+			for (int edge = 0; edge < 3; edge++)
+			{
+				if (m_triangles[triangleIndex].m_neighborIndexes[edge] == NAV_INVALID_INDEX) numEdges++;
+			}
+		}
+	}
+
+	size_t capacity = 16;
+	while (capacity < numEdges * 2)
+	{
+		capacity <<= 1;
+	}
+	size_t slotMask = capacity - 1;
+	int hashShift = 64;
+	for (size_t bit = capacity; bit > 1; bit >>= 1)
+	{
+		hashShift--;
+	}
+
+	std::vector<unsigned long long> edgeKeys(capacity, EMPTY_EDGE_KEY);
+	std::vector<int> edgeOwners(capacity, NAV_INVALID_INDEX);
+
+	for (int triangleIndex = firstTriangle; triangleIndex < lastTriangle; triangleIndex++)
+	{
+		NavTriangle& triangle = m_triangles[triangleIndex];
+		for (int edge = 0; edge < 3; edge++)
+		{
+			if (onlyOpenEdges && triangle.m_neighborIndexes[edge] != NAV_INVALID_INDEX) continue;
+
+			unsigned long long edgeKey = MakeNavEdgeKey(triangle.m_vertexIndexes[edge], triangle.m_vertexIndexes[(edge + 1) % 3]);
+
+			// Fibonacci hashing spreads the packed pairs, whose low bits alone are very regular
+			size_t slot = static_cast<size_t>((edgeKey * 0x9E3779B97F4A7C15ull) >> hashShift);
+			while (edgeKeys[slot] != EMPTY_EDGE_KEY && edgeKeys[slot] != edgeKey)
+			{
+				slot = (slot + 1) & slotMask;
+			}
+
+			if (edgeKeys[slot] == EMPTY_EDGE_KEY)
+			{
+				edgeKeys[slot] = edgeKey;
+				edgeOwners[slot] = (triangleIndex * 3) + edge;
+				continue;
+			}
+
+			// A third triangle on the same edge would be non-manifold, it stays unlinked
+			if (edgeOwners[slot] == NAV_INVALID_INDEX) continue;
+
+			int otherTriangle = edgeOwners[slot] / 3;
+			int otherEdge = edgeOwners[slot] % 3;
+			triangle.m_neighborIndexes[edge] = otherTriangle;
+			m_triangles[otherTriangle].m_neighborIndexes[otherEdge] = triangleIndex;
+			edgeOwners[slot] = NAV_INVALID_INDEX;
+		}
+	}
+}
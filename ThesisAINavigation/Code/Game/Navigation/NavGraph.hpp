@@ -0,0 +1,134 @@
+#pragma once
+#include "Game/Navigation/NavAliasTable.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <vector>
+
+constexpr int NAV_INVALID_INDEX = -1;
+constexpr float NAV_BLOCKED_COST_SCALE = 1e30f; // Any scale at or above this closes the triangle
+constexpr int NAV_POINT_WALK_MAX_STEPS = 16;
+
+// Undirected edge key, the sorted vertex index pair packed into 64 bits
+inline unsigned long long MakeNavEdgeKey(int vertexIndexA, int vertexIndexB)
+{
+	unsigned int low = static_cast<unsigned int>((vertexIndexA < vertexIndexB) ? vertexIndexA : vertexIndexB);
+	unsigned int high = static_cast<unsigned int>((vertexIndexA < vertexIndexB) ? vertexIndexB : vertexIndexA);
+	return (static_cast<unsigned long long>(low) << 32) | high;
+}
+
+//------------------------------------------------------------------------------------------------
+// Neighbor i sits across the edge from vertex i to vertex (i + 1) % 3. Vertices wind counter
+// clockwise seen from above, apart from the odd sliver the vertex jitter folds over.
+struct NavTriangle
+{
+	int m_vertexIndexes[3] = { NAV_INVALID_INDEX, NAV_INVALID_INDEX, NAV_INVALID_INDEX };
+	int m_neighborIndexes[3] = { NAV_INVALID_INDEX, NAV_INVALID_INDEX, NAV_INVALID_INDEX };
+	Vec3 m_centroid = Vec3::ZERO;
+};
+
+//------------------------------------------------------------------------------------------------
+// Game side triangle graph over the same vertices and grid mapping Map::GenerateNavMesh hands to
+// NavMesh::CreateNavMesh. Every grid quad with four mapped corners becomes two triangles. This is
+// what the game's own pathfinding searches, so its layout is under our control.
+class NavGraph
+{
+public:
+	NavGraph() = default;
+	~NavGraph() = default;
+
+	void Build(std::vector<Vec3> const& vertices, int gridWidth, int gridHeight, std::vector<int> const& vertexMapping);
+	void Clear();
+
+	// Point location goes through the bucket grid once it is built, and scans every triangle before
+	// that. Nearest means nearest centroid in XY when no triangle contains the point.
+	void BuildPointGrid();
+	int FindContainingTriangle(Vec3 const& point) const;
+	int FindNearestTriangle(Vec3 const& point) const;
+
+	// Walks across edges from the hint toward the point, which for something that moved a few meters
+	// since the hint was taken is a handful of steps. Falls back to FindNearestTriangle.
+	int FindNearestTriangleFromHint(Vec3 const& point, int hintTriangle) const; // Hint is usually last frame's triangle
+	bool IsPointInsideTriangleXY(int triangleIndex, Vec3 const& point) const;
+	float GetHeightOnTriangle(int triangleIndex, Vec3 const& point) const;
+
+	// Building blocks for builders that size and fill the arrays themselves, e.g. tile by tile on
+	// several threads. Writing and linking only touch triangles inside the given range, and linking
+	// only pairs up triangles that are both inside it.
+	static bool IsQuadMapped(int x, int y, int gridWidth, std::vector<int> const& vertexMapping);
+	void WriteQuadTriangles(int triangleIndex, int gridRow, int bottomLeft, int bottomRight, int topLeft, int topRight);
+	void LinkEdges(int firstTriangle, int lastTriangle, bool onlyOpenEdges);
+
+	// Cost of stepping from a triangle into its neighbor, the centroid distance times the entered
+	// triangle's cost scale. FLT_MAX when the neighbor is blocked.
+	float GetEdgeCost(int fromTriangle, int toTriangle) const;
+	float GetTriangleCostScale(int triangleIndex) const;
+	bool IsTriangleBlocked(int triangleIndex) const { return GetTriangleCostScale(triangleIndex) >= NAV_BLOCKED_COST_SCALE; }
+
+	// Scales below 1 are clamped so centroid distance stays an admissible heuristic. Every call bumps
+	// m_version once and is appended to m_costChangeLog.
+	void SetTriangleCostScale(int triangleIndex, float costScale);
+
+	// Flood fills the triangles that are not blocked into connected components and rebuilds the area
+	// weighted samplers over them. Builders call it once the graph is linked, and whoever changes
+	// costs calls it again after the batch of changes. Blocked triangles get NAV_INVALID_INDEX.
+	void LabelComponents();
+	bool HasUpToDateComponents() const { return m_componentsVersion == m_version && !m_triangleComponents.empty(); }
+	int GetComponent(int triangleIndex) const { return m_triangleComponents[triangleIndex]; }
+	int GetNumComponents() const { return static_cast<int>(m_componentFirstTriangles.size()) - 1; }
+
+	// False when the goal is blocked or lies in another component than the start, so a search would
+	// only come back empty. A start on a blocked triangle rules nothing out. Needs up to date components.
+	bool IsGoalReachable(int startTriangle, int goalTriangle) const;
+
+	// O(1) picks weighted by triangle area, so every square meter is equally likely no matter how the
+	// jitter sized the triangles. Random numbers in [0, 1], see NavAliasTable::Sample.
+	int GetRandomTriangle(float slotZeroToOne, float aliasZeroToOne) const;
+	int GetRandomTriangleInComponent(int componentIndex, float slotZeroToOne, float aliasZeroToOne) const;
+	float GetTriangleArea(int triangleIndex) const;
+
+	// u and v in [0, 1] map uniformly onto the triangle, the pairs past the diagonal are folded back
+	Vec3 GetPointInTriangle(int triangleIndex, float u, float v) const;
+
+	Vec3 const& GetTriangleVertex(int triangleIndex, int corner) const { return m_vertices[m_triangles[triangleIndex].m_vertexIndexes[corner]]; }
+	int GetNumTriangles() const { return static_cast<int>(m_triangles.size()); }
+	bool IsEmpty() const { return m_triangles.empty(); }
+
+private:
+	void WriteTriangle(int triangleIndex, int vertexIndexA, int vertexIndexB, int vertexIndexC);
+	int GetGridCellX(float x) const;
+	int GetGridCellY(float y) const;
+
+public:
+	std::vector<Vec3> m_vertices;
+	std::vector<NavTriangle> m_triangles;
+
+	// Empty until the first cost change, every triangle then starts at 1
+	std::vector<float> m_triangleCostScales;
+
+	// Bumped on every rebuild and cost change so anything derived from the graph can tell it went stale
+	unsigned int m_version = 0;
+
+	// Triangles whose cost changed since the last rebuild, in order. Incremental planners remember
+	// how far they have read and repair only around these instead of starting over.
+	std::vector<int> m_costChangeLog;
+
+	// Component of every triangle, and the triangles grouped by component with one extra offset at
+	// the end. Only trusted while m_componentsVersion matches m_version.
+	std::vector<int> m_triangleComponents;
+	std::vector<int> m_componentFirstTriangles;
+	std::vector<int> m_componentTriangles;
+	unsigned int m_componentsVersion = 0;
+
+	// Uniform XY grid over the vertex bounds. Every cell lists the triangles whose bounds overlap it,
+	// m_gridCellFirstTriangles has one extra entry at the end.
+	float m_gridOriginX = 0.f;
+	float m_gridOriginY = 0.f;
+	float m_gridCellSize = 1.f;
+	int m_gridNumCellsX = 0;
+	int m_gridNumCellsY = 0;
+	std::vector<int> m_gridCellFirstTriangles;
+	std::vector<int> m_gridCellTriangles;
+
+	// Both index into m_componentTriangles. One range per component, and one over every unblocked triangle.
+	NavAliasTable m_componentAreaSampler;
+	NavAliasTable m_areaSampler;
+};
@@ -0,0 +1,373 @@
+#include "Game/Navigation/NavGraphCache.hpp"
+#include "Game/Navigation/NavGraph.hpp"
+#include "Game/Navigation/NavHierarchy.hpp"
+#include "Game/Navigation/NavLandmarks.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static char const* NAV_GRAPH_CACHE_FOLDER = "Data/NavCache";
+
+//------------------------------------------------------------------------------------------------
+// Read only view of a whole file, the only platform specific part of the cache. Empty when the file
+// is missing, empty or cannot be mapped.
+class NavCacheFileView
+{
+public:
+	explicit NavCacheFileView(std::string const& filePath);
+	~NavCacheFileView();
+
+	unsigned char const* GetData() const { return static_cast<unsigned char const*>(m_view); }
+	size_t GetSize() const { return m_size; }
+
+private:
+#if defined(_WIN32)
+	HANDLE m_fileHandle = INVALID_HANDLE_VALUE;
+	HANDLE m_mappingHandle = nullptr;
+#else
+	int m_fileDescriptor = -1;
+#endif
+	void const* m_view = nullptr;
+	size_t m_size = 0;
+};
+
+#if defined(_WIN32)
+NavCacheFileView::NavCacheFileView(std::string const& filePath)
+{
+	m_fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (m_fileHandle == INVALID_HANDLE_VALUE) return;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(m_fileHandle, &fileSize) || fileSize.QuadPart == 0) return;
+
+	m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_mappingHandle == nullptr) return;
+
+	m_view = MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	m_size = (m_view != nullptr) ? static_cast<size_t>(fileSize.QuadPart) : 0;
+}
+
+NavCacheFileView::~NavCacheFileView()
+{
+	if (m_view != nullptr) UnmapViewOfFile(m_view);
+	if (m_mappingHandle != nullptr) CloseHandle(m_mappingHandle);
+	if (m_fileHandle != INVALID_HANDLE_VALUE) CloseHandle(m_fileHandle);
+}
+#else
+NavCacheFileView::NavCacheFileView(std::string const& filePath)
+{
+	m_fileDescriptor = open(filePath.c_str(), O_RDONLY);
+	if (m_fileDescriptor < 0) return;
+
+	struct stat fileStat;
+	if (fstat(m_fileDescriptor, &fileStat) != 0 || fileStat.st_size <= 0) return;
+
+	void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+	if (view == MAP_FAILED) return;
+
+	m_view = view;
+	m_size = static_cast<size_t>(fileStat.st_size);
+}
+
+NavCacheFileView::~NavCacheFileView()
+{
+	if (m_view != nullptr) munmap(const_cast<void*>(m_view), m_size);
+	if (m_fileDescriptor >= 0) close(m_fileDescriptor);
+}
+#endif
+
+struct NavGraphCacheHeader
+{
+	unsigned int m_magic = 0;
+	unsigned int m_formatVersion = 0;
+	NavGraphCacheKey m_key;
+
+	// Guards against reading a file written by a build with different struct layouts
+	unsigned int m_vertexSize = 0;
+	unsigned int m_triangleSize = 0;
+	unsigned int m_abstractNodeSize = 0;
+	unsigned int m_abstractEdgeSize = 0;
+
+	int m_numVertices = 0;
+	int m_numTriangles = 0;
+	int m_numNodes = 0;
+	int m_numEdges = 0;
+	int m_numClusterFirstNodes = 0;
+	int m_numLandmarks = 0; // 0 when the tables were not built
+	int m_numHierarchyLandmarks = 0;
+
+	int m_clusterSize = 0;
+	int m_numClustersX = 0;
+	int m_numClustersY = 0;
+	float m_originX = 0.f;
+	float m_originY = 0.f;
+};
+
+static bool IsSameKey(NavGraphCacheKey const& a, NavGraphCacheKey const& b)
+{
+	return a.m_gridWidth == b.m_gridWidth && a.m_gridHeight == b.m_gridHeight &&
+		a.m_groundHeightThreshold == b.m_groundHeightThreshold && a.m_hillHeightThreshold == b.m_hillHeightThreshold &&
+		a.m_mountainHeightThreshold == b.m_mountainHeightThreshold && a.m_seed == b.m_seed && a.m_heightMapHash == b.m_heightMapHash;
+}
+
+template <typename T>
+static bool ReadArray(unsigned char const*& cursor, unsigned char const* end, std::vector<T>& out_array, int count)
+{
+	size_t numBytes = static_cast<size_t>(count) * sizeof(T);
+	if (count < 0 || static_cast<size_t>(end - cursor) < numBytes) return false;
+
+	out_array.resize(static_cast<size_t>(count));
+	if (numBytes > 0)
+	{
+		memcpy(out_array.data(), cursor, numBytes);
+	}
+	cursor += numBytes;
+	return true;
+}
+
+template <typename T>
+static void WriteArray(std::ofstream& file, std::vector<T> const& array)
+{
+	if (array.empty()) return;
+	file.write(reinterpret_cast<char const*>(array.data()), static_cast<std::streamsize>(array.size() * sizeof(T)));
+}
+
+static bool IsIndexInRange(int index, int count)
+{
+	return index >= 0 && index < count;
+}
+
+static bool IsOptionalIndexInRange(int index, int count)
+{
+	return index == NAV_INVALID_INDEX || IsIndexInRange(index, count);
+}
+
+// Sizes alone do not catch a stale or damaged file, every index the searches follow without a check
+// is checked once here instead
+static bool IsCacheConsistent(NavGraphCacheHeader const& header, NavGraph const& navGraph, NavHierarchy const& navHierarchy, NavLandmarks const& landmarks)
+{
+	int numVertices = header.m_numVertices;
+	int numTriangles = header.m_numTriangles;
+	int numNodes = header.m_numNodes;
+	int numEdges = header.m_numEdges;
+	if (header.m_numClustersX <= 0 || header.m_numClustersY <= 0 || header.m_clusterSize <= 0) return false;
+	if (static_cast<long long>(header.m_numClustersX) * header.m_numClustersY >= INT_MAX) return false;
+
+	int numClusters = header.m_numClustersX * header.m_numClustersY;
+	if (header.m_numClusterFirstNodes != numClusters + 1) return false;
+
+	for (NavTriangle const& triangle : navGraph.m_triangles)
+	{
+		for (int corner = 0; corner < 3; corner++)
+		{
+			if (!IsIndexInRange(triangle.m_vertexIndexes[corner], numVertices)) return false;
+			if (!IsOptionalIndexInRange(triangle.m_neighborIndexes[corner], numTriangles)) return false;
+		}
+	}
+
+	for (int triangleIndex = 0; triangleIndex < numTriangles; triangleIndex++)
+	{
+		if (!IsIndexInRange(navHierarchy.m_triangleClusters[triangleIndex], numClusters)) return false;
+		if (!IsOptionalIndexInRange(navHierarchy.m_triangleNodes[triangleIndex], numNodes)) return false;
+	}
+
+	for (NavAbstractNode const& node : navHierarchy.m_nodes)
+	{
+		if (!IsIndexInRange(node.m_triangleIndex, numTriangles) || !IsIndexInRange(node.m_clusterIndex, numClusters)) return false;
+		if (node.m_firstEdge < 0 || node.m_numEdges < 0 || node.m_firstEdge > numEdges - node.m_numEdges) return false;
+	}
+
+	for (NavAbstractEdge const& edge : navHierarchy.m_edges)
+	{
+		if (!IsIndexInRange(edge.m_toNode, numNodes)) return false;
+	}
+
+	// Cluster ranges must start at zero, never go backwards and end exactly at the node count
+	if (navHierarchy.m_clusterFirstNodes.front() != 0 || navHierarchy.m_clusterFirstNodes.back() != numNodes) return false;
+	for (int clusterIndex = 0; clusterIndex < numClusters; clusterIndex++)
+	{
+		if (navHierarchy.m_clusterFirstNodes[clusterIndex] > navHierarchy.m_clusterFirstNodes[clusterIndex + 1]) return false;
+	}
+
+	for (int nodeIndex : navHierarchy.m_clusterNodes)
+	{
+		if (!IsIndexInRange(nodeIndex, numNodes)) return false;
+	}
+
+	for (int landmarkNode : navHierarchy.m_landmarkNodes)
+	{
+		if (!IsIndexInRange(landmarkNode, numNodes)) return false;
+	}
+
+	for (int landmarkTriangle : landmarks.m_landmarkTriangles)
+	{
+		if (!IsIndexInRange(landmarkTriangle, numTriangles)) return false;
+	}
+	return true;
+}
+
+static bool ReadCacheFile(unsigned char const* data, size_t size, NavGraphCacheKey const& key, NavGraph& out_navGraph, NavHierarchy& out_navHierarchy, NavLandmarks& out_landmarks)
+{
+	if (size < sizeof(NavGraphCacheHeader)) return false;
+
+	NavGraphCacheHeader header;
+	memcpy(&header, data, sizeof(NavGraphCacheHeader));
+	if (header.m_magic != NAV_GRAPH_CACHE_MAGIC || header.m_formatVersion != NAV_GRAPH_CACHE_FORMAT_VERSION) return false;
+	if (!IsSameKey(header.m_key, key)) return false;
+	if (header.m_vertexSize != sizeof(Vec3) || header.m_triangleSize != sizeof(NavTriangle)) return false;
+	if (header.m_abstractNodeSize != sizeof(NavAbstractNode) || header.m_abstractEdgeSize != sizeof(NavAbstractEdge)) return false;
+
+	// The counts come from disk too, the landmark table size below must not overflow
+	if (header.m_numLandmarks < 0 || header.m_numTriangles < 0) return false;
+	if (static_cast<long long>(header.m_numLandmarks) * header.m_numTriangles > INT_MAX) return false;
+	if (header.m_numHierarchyLandmarks < 0 || header.m_numNodes < 0) return false;
+	if (static_cast<long long>(header.m_numHierarchyLandmarks) * header.m_numNodes > INT_MAX) return false;
+
+	unsigned char const* cursor = data + sizeof(NavGraphCacheHeader);
+	unsigned char const* end = data + size;
+
+	out_navGraph.Clear();
+	out_navHierarchy.Clear();
+	out_landmarks.Clear();
+	bool isComplete = ReadArray(cursor, end, out_navGraph.m_vertices, header.m_numVertices) &&
+		ReadArray(cursor, end, out_navGraph.m_triangles, header.m_numTriangles) &&
+		ReadArray(cursor, end, out_navHierarchy.m_triangleClusters, header.m_numTriangles) &&
+		ReadArray(cursor, end, out_navHierarchy.m_triangleNodes, header.m_numTriangles) &&
+		ReadArray(cursor, end, out_navHierarchy.m_nodes, header.m_numNodes) &&
+		ReadArray(cursor, end, out_navHierarchy.m_edges, header.m_numEdges) &&
+		ReadArray(cursor, end, out_navHierarchy.m_clusterFirstNodes, header.m_numClusterFirstNodes) &&
+		ReadArray(cursor, end, out_navHierarchy.m_clusterNodes, header.m_numNodes) &&
+		ReadArray(cursor, end, out_navHierarchy.m_landmarkNodes, header.m_numHierarchyLandmarks) &&
+		ReadArray(cursor, end, out_navHierarchy.m_landmarkDistances, header.m_numHierarchyLandmarks * header.m_numNodes) &&
+		ReadArray(cursor, end, out_landmarks.m_landmarkTriangles, header.m_numLandmarks) &&
+		ReadArray(cursor, end, out_landmarks.m_distances, header.m_numLandmarks * header.m_numTriangles);
+
+	if (!isComplete || !IsCacheConsistent(header, out_navGraph, out_navHierarchy, out_landmarks))
+	{
+		out_navGraph.Clear();
+		out_navHierarchy.Clear();
+		out_landmarks.Clear();
+		return false;
+	}
+
+	out_navGraph.m_version++;
+	out_navGraph.BuildPointGrid();
+	out_navGraph.LabelComponents();
+
+	out_navHierarchy.m_navGraph = &out_navGraph;
+	out_navHierarchy.m_graphVersion = out_navGraph.m_version;
+	out_navHierarchy.m_numSyncedCostChanges = 0;
+	out_navHierarchy.m_clusterSize = header.m_clusterSize;
+	out_navHierarchy.m_numClustersX = header.m_numClustersX;
+	out_navHierarchy.m_numClustersY = header.m_numClustersY;
+	out_navHierarchy.m_originX = header.m_originX;
+	out_navHierarchy.m_originY = header.m_originY;
+
+	if (header.m_numLandmarks > 0)
+	{
+		out_landmarks.m_navGraph = &out_navGraph;
+		out_landmarks.m_graphVersion = out_navGraph.m_version;
+		out_landmarks.m_numCostChangesAtBuild = 0;
+	}
+	return true;
+}
+
+bool NavGraphCache::Load(NavGraphCacheKey const& key, NavGraph& out_navGraph, NavHierarchy& out_navHierarchy, NavLandmarks& out_landmarks)
+{
+	NavCacheFileView fileView(GetCachePath(key));
+	if (fileView.GetData() == nullptr) return false;
+
+	return ReadCacheFile(fileView.GetData(), fileView.GetSize(), key, out_navGraph, out_navHierarchy, out_landmarks);
+}
+
+bool NavGraphCache::Save(NavGraphCacheKey const& key, NavGraph const& navGraph, NavHierarchy const& navHierarchy, NavLandmarks const& landmarks)
+{
+	if (navGraph.IsEmpty() || !navHierarchy.IsBuiltFor(&navGraph)) return false;
+	bool hasLandmarks = landmarks.IsBuiltFor(&navGraph);
+
+	NavGraphCacheHeader header;
+	header.m_magic = NAV_GRAPH_CACHE_MAGIC;
+	header.m_formatVersion = NAV_GRAPH_CACHE_FORMAT_VERSION;
+	header.m_key = key;
+	header.m_vertexSize = sizeof(Vec3);
+	header.m_triangleSize = sizeof(NavTriangle);
+	header.m_abstractNodeSize = sizeof(NavAbstractNode);
+	header.m_abstractEdgeSize = sizeof(NavAbstractEdge);
+	header.m_numVertices = static_cast<int>(navGraph.m_vertices.size());
+	header.m_numTriangles = navGraph.GetNumTriangles();
+	header.m_numNodes = navHierarchy.GetNumNodes();
+	header.m_numEdges = static_cast<int>(navHierarchy.m_edges.size());
+	header.m_numClusterFirstNodes = static_cast<int>(navHierarchy.m_clusterFirstNodes.size());
+	header.m_numLandmarks = hasLandmarks ? landmarks.GetNumLandmarks() : 0;
+	header.m_numHierarchyLandmarks = static_cast<int>(navHierarchy.m_landmarkNodes.size());
+	header.m_clusterSize = navHierarchy.m_clusterSize;
+	header.m_numClustersX = navHierarchy.m_numClustersX;
+	header.m_numClustersY = navHierarchy.m_numClustersY;
+	header.m_originX = navHierarchy.m_originX;
+	header.m_originY = navHierarchy.m_originY;
+
+	std::error_code errorCode;
+	std::filesystem::create_directories(NAV_GRAPH_CACHE_FOLDER, errorCode);
+
+	// Write next to the final path and rename, so a crash mid write never leaves a torn cache behind
+	std::string cachePath = GetCachePath(key);
+	std::string tempPath = cachePath + ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) return false;
+
+		file.write(reinterpret_cast<char const*>(&header), sizeof(NavGraphCacheHeader));
+		WriteArray(file, navGraph.m_vertices);
+		WriteArray(file, navGraph.m_triangles);
+		WriteArray(file, navHierarchy.m_triangleClusters);
+		WriteArray(file, navHierarchy.m_triangleNodes);
+		WriteArray(file, navHierarchy.m_nodes);
+		WriteArray(file, navHierarchy.m_edges);
+		WriteArray(file, navHierarchy.m_clusterFirstNodes);
+		WriteArray(file, navHierarchy.m_clusterNodes);
+		WriteArray(file, navHierarchy.m_landmarkNodes);
+		WriteArray(file, navHierarchy.m_landmarkDistances);
+		if (hasLandmarks)
+		{
+			WriteArray(file, landmarks.m_landmarkTriangles);
+			WriteArray(file, landmarks.m_distances);
+		}
+		if (!file.good()) return false;
+	}
+
+	std::filesystem::rename(tempPath, cachePath, errorCode);
+	return !errorCode;
+}
+
+std::string NavGraphCache::GetCachePath(NavGraphCacheKey const& key)
+{
+	// The name only has to spread keys out, the header holds the full key that Load checks
+	unsigned long long keyHash = key.m_heightMapHash ^ (static_cast<unsigned long long>(key.m_seed) * 0x9E3779B97F4A7C15ull);
+	return Stringf("%s/NavGraph_%dx%d_%016llx.navcache", NAV_GRAPH_CACHE_FOLDER, key.m_gridWidth, key.m_gridHeight, keyHash);
+}
+
+unsigned long long NavGraphCache::HashHeightMap(std::vector<float> const& heightMap)
+{
+	// FNV-1a over the raw bytes
+	unsigned long long hash = 0xCBF29CE484222325ull;
+	unsigned char const* bytes = reinterpret_cast<unsigned char const*>(heightMap.data());
+	size_t numBytes = heightMap.size() * sizeof(float);
+	for (size_t byteIndex = 0; byteIndex < numBytes; byteIndex++)
+	{
+		hash ^= bytes[byteIndex];
+		hash *= 0x100000001B3ull;
+	}
+	return hash;
+}
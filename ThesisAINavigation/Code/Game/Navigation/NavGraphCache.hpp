@@ -0,0 +1,39 @@
+#pragma once
+#include <string>
+#include <vector>
+
+class NavGraph;
+class NavHierarchy;
+class NavLandmarks;
+
+constexpr unsigned int NAV_GRAPH_CACHE_MAGIC = 0x4753564E; // "NVSG"
+constexpr unsigned int NAV_GRAPH_CACHE_FORMAT_VERSION = 4;
+
+//------------------------------------------------------------------------------------------------
+// Everything the generated graph depends on. The heightmap hash catches terrain changes the config
+// values alone would miss.
+struct NavGraphCacheKey
+{
+	int m_gridWidth = 0;
+	int m_gridHeight = 0;
+	float m_groundHeightThreshold = 0.f;
+	float m_hillHeightThreshold = 0.f;
+	float m_mountainHeightThreshold = 0.f;
+	unsigned int m_seed = 0;
+	unsigned long long m_heightMapHash = 0;
+};
+
+//------------------------------------------------------------------------------------------------
+// Versioned binary snapshot of a NavGraph, its NavHierarchy and, when built, its NavLandmarks tables
+// under Data/NavCache. Loads map the file read only and copy each array straight out of the view, so
+// nothing gets parsed or rebuilt. A file with the wrong magic, version, key or struct sizes, or with
+// any index that points outside its arrays, is treated as a miss and the caller rebuilds.
+class NavGraphCache
+{
+public:
+	static bool Load(NavGraphCacheKey const& key, NavGraph& out_navGraph, NavHierarchy& out_navHierarchy, NavLandmarks& out_landmarks);
+	static bool Save(NavGraphCacheKey const& key, NavGraph const& navGraph, NavHierarchy const& navHierarchy, NavLandmarks const& landmarks);
+
+	static std::string GetCachePath(NavGraphCacheKey const& key);
+	static unsigned long long HashHeightMap(std::vector<float> const& heightMap);
+};
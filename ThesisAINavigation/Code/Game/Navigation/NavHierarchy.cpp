@@ -0,0 +1,636 @@
+#include "Game/Navigation/NavHierarchy.hpp"
+#include "Game/Navigation/NavGraph.hpp"
+#include "Game/Navigation/NavLandmarks.hpp"
+#include "Game/Navigation/NavSearchContext.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+#include <cfloat>
+
+struct BorderCrossing
+{
+	unsigned long long m_clusterPairKey = 0;
+	float m_borderPosition = 0.f;
+	int m_lowClusterTriangle = NAV_INVALID_INDEX;
+	int m_highClusterTriangle = NAV_INVALID_INDEX;
+};
+
+static bool IsCrossingBefore(BorderCrossing const& a, BorderCrossing const& b)
+{
+	if (a.m_clusterPairKey != b.m_clusterPairKey) return a.m_clusterPairKey < b.m_clusterPairKey;
+	return a.m_borderPosition < b.m_borderPosition;
+}
+
+//------------------------------------------------------------------------------------------------
+// Per thread query scratch. The abstract search gets its own context since refining a segment
+// restarts the triangle context.
+struct NavHierarchyScratch
+{
+	NavSearchContext m_abstractContext;
+	std::vector<NavAbstractEdge> m_startLinks;
+	std::vector<NavAbstractEdge> m_goalLinks;
+	std::vector<float> m_goalLandmarkDistances;
+	std::vector<int> m_abstractPath;
+	std::vector<int> m_corridor;
+};
+
+static NavHierarchyScratch& GetScratchForCurrentThread()
+{
+	thread_local NavHierarchyScratch s_scratch;
+	return s_scratch;
+}
+
+void NavHierarchy::Build(NavGraph const* navGraph, int clusterSize)
+{
+	Clear();
+	m_navGraph = navGraph;
+	if (m_navGraph == nullptr || m_navGraph->IsEmpty()) return;
+
+	m_graphVersion = m_navGraph->m_version;
+	m_numSyncedCostChanges = static_cast<int>(m_navGraph->m_costChangeLog.size());
+
+	std::vector<std::vector<NavAbstractEdge>> nodeEdges;
+	BuildClusters(clusterSize);
+	BuildTransitions(nodeEdges);
+	BuildIntraClusterEdges(nodeEdges);
+	FlattenEdges(nodeEdges);
+	BuildLandmarks(NAV_HIERARCHY_NUM_LANDMARKS);
+}
+
+bool NavHierarchy::ApplyCostChanges()
+{
+	if (m_navGraph == nullptr || m_triangleClusters.empty()) return false;
+
+	// Same test as the landmarks: every version bump since the last sync must be a logged cost change
+	std::vector<int> const& costChangeLog = m_navGraph->m_costChangeLog;
+	int numCostChanges = static_cast<int>(costChangeLog.size());
+	if (numCostChanges < m_numSyncedCostChanges) return false;
+	if (m_navGraph->m_version - m_graphVersion != static_cast<unsigned int>(numCostChanges - m_numSyncedCostChanges)) return false;
+	if (numCostChanges == m_numSyncedCostChanges) return true;
+
+	std::vector<bool> isClusterDirty(static_cast<size_t>(GetNumClusters()), false);
+	for (int changeIndex = m_numSyncedCostChanges; changeIndex < numCostChanges; changeIndex++)
+	{
+		isClusterDirty[m_triangleClusters[costChangeLog[changeIndex]]] = true;
+	}
+
+	// Border hops are few, so all of them are recosted. Intra cluster edges are kept for clean
+	// clusters and reflooded for dirty ones, where blocking can also cut or reconnect nodes.
+	std::vector<std::vector<NavAbstractEdge>> nodeEdges(m_nodes.size());
+	for (int nodeIndex = 0; nodeIndex < GetNumNodes(); nodeIndex++)
+	{
+		NavAbstractNode const& node = m_nodes[nodeIndex];
+		for (int edgeIndex = node.m_firstEdge; edgeIndex < node.m_firstEdge + node.m_numEdges; edgeIndex++)
+		{
+			NavAbstractEdge edge = m_edges[edgeIndex];
+			NavAbstractNode const& toNode = m_nodes[edge.m_toNode];
+			if (toNode.m_clusterIndex != node.m_clusterIndex)
+			{
+				edge.m_cost = m_navGraph->GetEdgeCost(node.m_triangleIndex, toNode.m_triangleIndex);
+			}
+			else if (isClusterDirty[node.m_clusterIndex])
+			{
+				continue;
+			}
+			nodeEdges[nodeIndex].emplace_back(edge);
+		}
+	}
+
+	for (int clusterIndex = 0; clusterIndex < GetNumClusters(); clusterIndex++)
+	{
+		if (isClusterDirty[clusterIndex])
+		{
+			FloodClusterEdges(clusterIndex, nodeEdges);
+		}
+	}
+
+	m_edges.clear();
+	FlattenEdges(nodeEdges);
+	m_graphVersion = m_navGraph->m_version;
+	m_numSyncedCostChanges = numCostChanges;
+	return true;
+}
+
+void NavHierarchy::Clear()
+{
+	m_navGraph = nullptr;
+	m_graphVersion = 0;
+	m_numSyncedCostChanges = 0;
+	m_numClustersX = 0;
+	m_numClustersY = 0;
+	m_triangleClusters.clear();
+	m_nodes.clear();
+	m_edges.clear();
+	m_triangleNodes.clear();
+	m_clusterFirstNodes.clear();
+	m_clusterNodes.clear();
+	m_landmarkNodes.clear();
+	m_landmarkDistances.clear();
+}
+
+bool NavHierarchy::IsBuiltFor(NavGraph const* navGraph) const
+{
+	return navGraph != nullptr && m_navGraph == navGraph && m_graphVersion == navGraph->m_version && !m_triangleClusters.empty();
+}
+
+void NavHierarchy::BuildClusters(int clusterSize)
+{
+	m_clusterSize = (clusterSize > 0) ? clusterSize : NAV_CLUSTER_SIZE;
+
+	std::vector<NavTriangle> const& triangles = m_navGraph->m_triangles;
+	float minX = FLT_MAX;
+	float minY = FLT_MAX;
+	float maxX = -FLT_MAX;
+	float maxY = -FLT_MAX;
+	for (NavTriangle const& triangle : triangles)
+	{
+		minX = std::min(minX, triangle.m_centroid.x);
+		minY = std::min(minY, triangle.m_centroid.y);
+		maxX = std::max(maxX, triangle.m_centroid.x);
+		maxY = std::max(maxY, triangle.m_centroid.y);
+	}
+
+	float clusterSizeFloat = static_cast<float>(m_clusterSize);
+	m_originX = minX;
+	m_originY = minY;
+	m_numClustersX = static_cast<int>((maxX - minX) / clusterSizeFloat) + 1;
+	m_numClustersY = static_cast<int>((maxY - minY) / clusterSizeFloat) + 1;
+
+	m_triangleClusters.resize(triangles.size());
+	for (int triangleIndex = 0; triangleIndex < m_navGraph->GetNumTriangles(); triangleIndex++)
+	{
+		Vec3 const& centroid = triangles[triangleIndex].m_centroid;
+		int clusterX = std::min(static_cast<int>((centroid.x - m_originX) / clusterSizeFloat), m_numClustersX - 1);
+		int clusterY = std::min(static_cast<int>((centroid.y - m_originY) / clusterSizeFloat), m_numClustersY - 1);
+		m_triangleClusters[triangleIndex] = (clusterY * m_numClustersX) + clusterX;
+	}
+
+	m_triangleNodes.assign(triangles.size(), NAV_INVALID_INDEX);
+}
+
+void NavHierarchy::BuildTransitions(std::vector<std::vector<NavAbstractEdge>>& nodeEdges)
+{
+	std::vector<NavTriangle> const& triangles = m_navGraph->m_triangles;
+
+	// Every triangle edge that crosses a cluster border, seen once from the lower cluster's side
+	std::vector<BorderCrossing> crossings;
+	for (int triangleIndex = 0; triangleIndex < m_navGraph->GetNumTriangles(); triangleIndex++)
+	{
+		int clusterIndex = m_triangleClusters[triangleIndex];
+		for (int edge = 0; edge < 3; edge++)
+		{
+			int neighborTriangle = triangles[triangleIndex].m_neighborIndexes[edge];
+			if (neighborTriangle == NAV_INVALID_INDEX) continue;
+
+			int neighborCluster = m_triangleClusters[neighborTriangle];
+			if (neighborCluster <= clusterIndex) continue;
+
+			// Order crossings along the border so nearby ones end up in the same transition
+			Vec3 edgeMidpoint = (m_navGraph->GetTriangleVertex(triangleIndex, edge) + m_navGraph->GetTriangleVertex(triangleIndex, (edge + 1) % 3)) * 0.5f;
+			bool isSameClusterRow = (clusterIndex / m_numClustersX) == (neighborCluster / m_numClustersX);
+
+			BorderCrossing crossing;
+			crossing.m_clusterPairKey = (static_cast<unsigned long long>(clusterIndex) << 32) | static_cast<unsigned int>(neighborCluster);
+			crossing.m_borderPosition = isSameClusterRow ? edgeMidpoint.y : edgeMidpoint.x;
+			crossing.m_lowClusterTriangle = triangleIndex;
+			crossing.m_highClusterTriangle = neighborTriangle;
+			crossings.emplace_back(crossing);
+		}
+	}
+	std::sort(crossings.begin(), crossings.end(), IsCrossingBefore);
+
+	int numCrossings = static_cast<int>(crossings.size());
+	int borderStart = 0;
+	while (borderStart < numCrossings)
+	{
+		int borderEnd = borderStart;
+		while (borderEnd < numCrossings && crossings[borderEnd].m_clusterPairKey == crossings[borderStart].m_clusterPairKey)
+		{
+			borderEnd++;
+		}
+
+		// Long borders get several transitions so routes do not all funnel through one point
+		int numBorderCrossings = borderEnd - borderStart;
+		int numTransitions = (numBorderCrossings + NAV_CROSSINGS_PER_TRANSITION - 1) / NAV_CROSSINGS_PER_TRANSITION;
+		for (int transitionIndex = 0; transitionIndex < numTransitions; transitionIndex++)
+		{
+			int chunkStart = borderStart + ((transitionIndex * numBorderCrossings) / numTransitions);
+			int chunkEnd = borderStart + (((transitionIndex + 1) * numBorderCrossings) / numTransitions);
+			BorderCrossing const& crossing = crossings[(chunkStart + chunkEnd) / 2];
+
+			int lowNode = GetOrAddNode(crossing.m_lowClusterTriangle, nodeEdges);
+			int highNode = GetOrAddNode(crossing.m_highClusterTriangle, nodeEdges);
+
+			NavAbstractEdge edge;
+			edge.m_toNode = highNode;
+			edge.m_cost = m_navGraph->GetEdgeCost(crossing.m_lowClusterTriangle, crossing.m_highClusterTriangle);
+			nodeEdges[lowNode].emplace_back(edge);
+			edge.m_toNode = lowNode;
+			edge.m_cost = m_navGraph->GetEdgeCost(crossing.m_highClusterTriangle, crossing.m_lowClusterTriangle);
+			nodeEdges[highNode].emplace_back(edge);
+		}
+
+		borderStart = borderEnd;
+	}
+}
+
+void NavHierarchy::BuildIntraClusterEdges(std::vector<std::vector<NavAbstractEdge>>& nodeEdges)
+{
+	// Group nodes by cluster
+	int numClusters = GetNumClusters();
+	m_clusterFirstNodes.assign(static_cast<size_t>(numClusters) + 1, 0);
+	for (NavAbstractNode const& node : m_nodes)
+	{
+		m_clusterFirstNodes[node.m_clusterIndex + 1]++;
+	}
+	for (int clusterIndex = 0; clusterIndex < numClusters; clusterIndex++)
+	{
+		m_clusterFirstNodes[clusterIndex + 1] += m_clusterFirstNodes[clusterIndex];
+	}
+
+	m_clusterNodes.resize(m_nodes.size());
+	std::vector<int> clusterFill(m_clusterFirstNodes.begin(), m_clusterFirstNodes.end() - 1);
+	for (int nodeIndex = 0; nodeIndex < GetNumNodes(); nodeIndex++)
+	{
+		m_clusterNodes[clusterFill[m_nodes[nodeIndex].m_clusterIndex]++] = nodeIndex;
+	}
+
+	for (int clusterIndex = 0; clusterIndex < numClusters; clusterIndex++)
+	{
+		FloodClusterEdges(clusterIndex, nodeEdges);
+	}
+}
+
+void NavHierarchy::FloodClusterEdges(int clusterIndex, std::vector<std::vector<NavAbstractEdge>>& nodeEdges)
+{
+	// One flood per node gives its true in cluster distance to every other node of the cluster
+	NavSearchContext& context = NavSearchContext::GetForCurrentThread();
+	int firstNode = m_clusterFirstNodes[clusterIndex];
+	int lastNode = m_clusterFirstNodes[clusterIndex + 1];
+	for (int fromSlot = firstNode; fromSlot < lastNode; fromSlot++)
+	{
+		int fromNode = m_clusterNodes[fromSlot];
+		int fromTriangle = m_nodes[fromNode].m_triangleIndex;
+		if (m_navGraph->IsTriangleBlocked(fromTriangle)) continue;
+
+		SearchWithinCluster(fromTriangle, NAV_INVALID_INDEX, clusterIndex, context);
+		for (int toSlot = firstNode; toSlot < lastNode; toSlot++)
+		{
+			int toNode = m_clusterNodes[toSlot];
+			int toTriangle = m_nodes[toNode].m_triangleIndex;
+			if (toNode == fromNode || !context.IsSeen(toTriangle)) continue;
+
+			NavAbstractEdge edge;
+			edge.m_toNode = toNode;
+			edge.m_cost = context.m_gCosts[toTriangle];
+			nodeEdges[fromNode].emplace_back(edge);
+		}
+	}
+}
+
+void NavHierarchy::FlattenEdges(std::vector<std::vector<NavAbstractEdge>> const& nodeEdges)
+{
+	// A node's edges sit next to each other
+	for (int nodeIndex = 0; nodeIndex < GetNumNodes(); nodeIndex++)
+	{
+		m_nodes[nodeIndex].m_firstEdge = static_cast<int>(m_edges.size());
+		m_nodes[nodeIndex].m_numEdges = static_cast<int>(nodeEdges[nodeIndex].size());
+		m_edges.insert(m_edges.end(), nodeEdges[nodeIndex].begin(), nodeEdges[nodeIndex].end());
+	}
+}
+
+void NavHierarchy::BuildLandmarks(int numLandmarks)
+{
+	int numNodes = GetNumNodes();
+	if (numNodes == 0) return;
+	numLandmarks = std::min(numLandmarks, numNodes);
+
+	// Farthest point selection: each landmark is the node farthest from all the ones picked so far,
+	// which spreads them around the rim. The first flood only finds a starting point on the rim.
+	NavSearchContext& context = NavSearchContext::GetForCurrentThread();
+	std::vector<float> nearestLandmarkDistances(static_cast<size_t>(numNodes), FLT_MAX);
+	m_landmarkDistances.assign(static_cast<size_t>(numNodes) * numLandmarks, FLT_MAX);
+
+	int nextLandmark = 0;
+	for (int landmarkIndex = -1; landmarkIndex < numLandmarks; landmarkIndex++)
+	{
+		ComputeLandmarkDistances(nextLandmark, context);
+		if (landmarkIndex >= 0)
+		{
+			m_landmarkNodes.emplace_back(nextLandmark);
+		}
+
+		float farthestDistance = -1.f;
+		for (int nodeIndex = 0; nodeIndex < numNodes; nodeIndex++)
+		{
+			if (!context.IsSeen(nodeIndex)) continue;
+
+			float distance = context.m_gCosts[nodeIndex];
+			if (landmarkIndex >= 0)
+			{
+				m_landmarkDistances[(static_cast<size_t>(nodeIndex) * numLandmarks) + landmarkIndex] = distance;
+				nearestLandmarkDistances[nodeIndex] = std::min(nearestLandmarkDistances[nodeIndex], distance);
+				distance = nearestLandmarkDistances[nodeIndex];
+			}
+			if (distance > farthestDistance)
+			{
+				farthestDistance = distance;
+				nextLandmark = nodeIndex;
+			}
+		}
+	}
+}
+
+void NavHierarchy::ComputeLandmarkDistances(int sourceNode, NavSearchContext& context) const
+{
+	// Plain Dijkstra over the abstract edges, leaving the distances in the context
+	context.BeginSearch(GetNumNodes());
+	context.MarkSeen(sourceNode, 0.f, NAV_INVALID_INDEX);
+	context.PushOpen(sourceNode, 0.f);
+
+	while (!context.IsOpenEmpty())
+	{
+		int currentNode = context.PopOpen().m_triangleIndex;
+		if (context.IsClosed(currentNode)) continue;
+		context.MarkClosed(currentNode);
+
+		float currentGCost = context.m_gCosts[currentNode];
+		NavAbstractNode const& node = m_nodes[currentNode];
+		for (int edgeIndex = node.m_firstEdge; edgeIndex < node.m_firstEdge + node.m_numEdges; edgeIndex++)
+		{
+			NavAbstractEdge const& edge = m_edges[edgeIndex];
+			if (edge.m_cost == FLT_MAX || context.IsClosed(edge.m_toNode)) continue;
+
+			float gCost = currentGCost + edge.m_cost;
+			if (context.IsSeen(edge.m_toNode) && gCost >= context.m_gCosts[edge.m_toNode]) continue;
+
+			context.MarkSeen(edge.m_toNode, gCost, currentNode);
+			context.PushOpen(edge.m_toNode, gCost);
+		}
+	}
+}
+
+int NavHierarchy::GetOrAddNode(int triangleIndex, std::vector<std::vector<NavAbstractEdge>>& nodeEdges)
+{
+	if (m_triangleNodes[triangleIndex] != NAV_INVALID_INDEX) return m_triangleNodes[triangleIndex];
+
+	NavAbstractNode node;
+	node.m_triangleIndex = triangleIndex;
+	node.m_clusterIndex = m_triangleClusters[triangleIndex];
+	m_nodes.emplace_back(node);
+	nodeEdges.emplace_back();
+
+	m_triangleNodes[triangleIndex] = GetNumNodes() - 1;
+	return m_triangleNodes[triangleIndex];
+}
+
+bool NavHierarchy::FindCorridor(int startTriangle, int goalTriangle, NavSearchContext& context, NavLandmarks const* landmarks) const
+{
+	if (startTriangle == NAV_INVALID_INDEX || goalTriangle == NAV_INVALID_INDEX) return false;
+
+	NavHierarchyScratch& scratch = GetScratchForCurrentThread();
+	int startCluster = m_triangleClusters[startTriangle];
+	int goalCluster = m_triangleClusters[goalTriangle];
+
+	// Short queries never leave their cluster
+	if (startCluster == goalCluster)
+	{
+		scratch.m_corridor.clear();
+		if (AppendClusterCorridor(startTriangle, goalTriangle, startCluster, context, scratch.m_corridor, landmarks))
+		{
+			context.m_corridor.swap(scratch.m_corridor);
+			return true;
+		}
+	}
+
+	// Temporarily link start and goal to the abstract nodes of their clusters
+	int firstStartNode = m_clusterFirstNodes[startCluster];
+	int lastStartNode = m_clusterFirstNodes[startCluster + 1];
+	scratch.m_startLinks.clear();
+	SearchWithinCluster(startTriangle, NAV_INVALID_INDEX, startCluster, context);
+	for (int slot = firstStartNode; slot < lastStartNode; slot++)
+	{
+		int nodeIndex = m_clusterNodes[slot];
+		if (!context.IsSeen(m_nodes[nodeIndex].m_triangleIndex)) continue;
+
+		NavAbstractEdge link;
+		link.m_toNode = nodeIndex;
+		link.m_cost = context.m_gCosts[m_nodes[nodeIndex].m_triangleIndex];
+		scratch.m_startLinks.emplace_back(link);
+	}
+
+	int firstGoalNode = m_clusterFirstNodes[goalCluster];
+	int lastGoalNode = m_clusterFirstNodes[goalCluster + 1];
+	scratch.m_goalLinks.clear();
+	SearchWithinCluster(goalTriangle, NAV_INVALID_INDEX, goalCluster, context);
+	for (int slot = firstGoalNode; slot < lastGoalNode; slot++)
+	{
+		int nodeIndex = m_clusterNodes[slot];
+		if (!context.IsSeen(m_nodes[nodeIndex].m_triangleIndex)) continue;
+
+		NavAbstractEdge link;
+		link.m_toNode = nodeIndex;
+		link.m_cost = context.m_gCosts[m_nodes[nodeIndex].m_triangleIndex];
+		scratch.m_goalLinks.emplace_back(link);
+	}
+
+	if (scratch.m_startLinks.empty() || scratch.m_goalLinks.empty()) return false;
+
+	// Abstract A*, the two temporary nodes go after the real ones
+	std::vector<NavTriangle> const& triangles = m_navGraph->m_triangles;
+	Vec3 const& goalCentroid = triangles[goalTriangle].m_centroid;
+	int startNode = GetNumNodes();
+	int goalNode = GetNumNodes() + 1;
+
+	// The goal node is only reached through its links, so its landmark distances are the best link
+	// into it. The in cluster edges keep the triangle inequality holding across the links.
+	int numLandmarks = static_cast<int>(m_landmarkNodes.size());
+	scratch.m_goalLandmarkDistances.assign(static_cast<size_t>(numLandmarks), FLT_MAX);
+	for (NavAbstractEdge const& link : scratch.m_goalLinks)
+	{
+		float const* linkDistances = m_landmarkDistances.data() + (static_cast<size_t>(link.m_toNode) * numLandmarks);
+		for (int landmarkIndex = 0; landmarkIndex < numLandmarks; landmarkIndex++)
+		{
+			if (linkDistances[landmarkIndex] == FLT_MAX) continue;
+			scratch.m_goalLandmarkDistances[landmarkIndex] = std::min(scratch.m_goalLandmarkDistances[landmarkIndex], linkDistances[landmarkIndex] + link.m_cost);
+		}
+	}
+
+	auto getHeuristic = [&](int nodeIndex)
+	{
+		float bestBound = GetDistance3D(triangles[m_nodes[nodeIndex].m_triangleIndex].m_centroid, goalCentroid);
+		float const* nodeDistances = m_landmarkDistances.data() + (static_cast<size_t>(nodeIndex) * numLandmarks);
+		for (int landmarkIndex = 0; landmarkIndex < numLandmarks; landmarkIndex++)
+		{
+			float nodeDistance = nodeDistances[landmarkIndex];
+			float goalDistance = scratch.m_goalLandmarkDistances[landmarkIndex];
+			if (nodeDistance == FLT_MAX || goalDistance == FLT_MAX) continue;
+
+			bestBound = std::max(bestBound, fabsf(goalDistance - nodeDistance));
+		}
+		return bestBound;
+	};
+
+	NavSearchContext& abstractContext = scratch.m_abstractContext;
+	abstractContext.m_stats = NavSearchStats();
+	abstractContext.BeginSearch(GetNumNodes() + 2);
+	abstractContext.MarkSeen(startNode, 0.f, NAV_INVALID_INDEX);
+	abstractContext.PushOpen(startNode, GetDistance3D(triangles[startTriangle].m_centroid, goalCentroid));
+
+	int currentNode = NAV_INVALID_INDEX;
+	auto relaxEdge = [&](int toNode, float gCost)
+	{
+		if (abstractContext.IsClosed(toNode)) return;
+		if (abstractContext.IsSeen(toNode) && gCost >= abstractContext.m_gCosts[toNode]) return;
+
+		float heuristic = (toNode == goalNode) ? 0.f : getHeuristic(toNode);
+		abstractContext.MarkSeen(toNode, gCost, currentNode);
+		abstractContext.PushOpen(toNode, gCost + heuristic);
+	};
+
+	bool isGoalReached = false;
+	while (!abstractContext.IsOpenEmpty())
+	{
+		currentNode = abstractContext.PopOpen().m_triangleIndex;
+		if (abstractContext.IsClosed(currentNode)) continue;
+		abstractContext.MarkClosed(currentNode);
+
+		if (currentNode == goalNode)
+		{
+			isGoalReached = true;
+			break;
+		}
+
+		float currentGCost = abstractContext.m_gCosts[currentNode];
+		if (currentNode == startNode)
+		{
+			for (NavAbstractEdge const& link : scratch.m_startLinks)
+			{
+				relaxEdge(link.m_toNode, currentGCost + link.m_cost);
+			}
+			continue;
+		}
+
+		NavAbstractNode const& node = m_nodes[currentNode];
+		for (int edgeIndex = node.m_firstEdge; edgeIndex < node.m_firstEdge + node.m_numEdges; edgeIndex++)
+		{
+			if (m_edges[edgeIndex].m_cost == FLT_MAX) continue; // Blocked border hop
+			relaxEdge(m_edges[edgeIndex].m_toNode, currentGCost + m_edges[edgeIndex].m_cost);
+		}
+
+		if (node.m_clusterIndex == goalCluster)
+		{
+			for (NavAbstractEdge const& link : scratch.m_goalLinks)
+			{
+				if (link.m_toNode == currentNode)
+				{
+					relaxEdge(goalNode, currentGCost + link.m_cost);
+				}
+			}
+		}
+	}
+
+	// The caller only sees the triangle context, the abstract search is part of the same query
+	context.m_stats.Add(abstractContext.m_stats);
+	if (!isGoalReached) return false;
+
+	scratch.m_abstractPath.clear();
+	for (int nodeIndex = goalNode; nodeIndex != NAV_INVALID_INDEX; nodeIndex = abstractContext.m_parentIndexes[nodeIndex])
+	{
+		scratch.m_abstractPath.emplace_back(nodeIndex);
+	}
+	std::reverse(scratch.m_abstractPath.begin(), scratch.m_abstractPath.end());
+
+	// Refine only the clusters the abstract route passes through
+	scratch.m_corridor.clear();
+	scratch.m_corridor.emplace_back(startTriangle);
+	for (int pathIndex = 1; pathIndex < static_cast<int>(scratch.m_abstractPath.size()); pathIndex++)
+	{
+		int fromNode = scratch.m_abstractPath[pathIndex - 1];
+		int toNode = scratch.m_abstractPath[pathIndex];
+		int fromTriangle = (fromNode == startNode) ? startTriangle : m_nodes[fromNode].m_triangleIndex;
+		int toTriangle = (toNode == goalNode) ? goalTriangle : m_nodes[toNode].m_triangleIndex;
+		if (fromTriangle == toTriangle) continue;
+
+		// Border hops connect direct neighbors
+		int fromCluster = m_triangleClusters[fromTriangle];
+		if (fromCluster != m_triangleClusters[toTriangle])
+		{
+			scratch.m_corridor.emplace_back(toTriangle);
+			continue;
+		}
+
+		if (!AppendClusterCorridor(fromTriangle, toTriangle, fromCluster, context, scratch.m_corridor, landmarks)) return false;
+	}
+
+	context.m_corridor.swap(scratch.m_corridor);
+	return true;
+}
+
+bool NavHierarchy::SearchWithinCluster(int startTriangle, int goalTriangle, int clusterIndex, NavSearchContext& context, NavLandmarks const* landmarks) const
+{
+	context.BeginSearch(m_navGraph->GetNumTriangles());
+
+	std::vector<NavTriangle> const& triangles = m_navGraph->m_triangles;
+	bool hasGoal = goalTriangle != NAV_INVALID_INDEX;
+	Vec3 goalCentroid = hasGoal ? triangles[goalTriangle].m_centroid : Vec3::ZERO;
+
+	// Same bounds as NavPathfinder::FindCorridor. Staying inside the cluster only lengthens paths, so they stay admissible.
+	auto getHeuristic = [&](int triangleIndex)
+	{
+		if (!hasGoal) return 0.f;
+
+		float straightLine = GetDistance3D(triangles[triangleIndex].m_centroid, goalCentroid);
+		return (landmarks != nullptr) ? std::max(straightLine, landmarks->GetHeuristic(triangleIndex, goalTriangle)) : straightLine;
+	};
+
+	context.MarkSeen(startTriangle, 0.f, NAV_INVALID_INDEX);
+	context.PushOpen(startTriangle, getHeuristic(startTriangle));
+
+	while (!context.IsOpenEmpty())
+	{
+		int currentTriangle = context.PopOpen().m_triangleIndex;
+		if (context.IsClosed(currentTriangle)) continue;
+		context.MarkClosed(currentTriangle);
+
+		if (currentTriangle == goalTriangle) return true;
+
+		NavTriangle const& triangle = triangles[currentTriangle];
+		float currentGCost = context.m_gCosts[currentTriangle];
+
+		for (int edge = 0; edge < 3; edge++)
+		{
+			int neighborTriangle = triangle.m_neighborIndexes[edge];
+			if (neighborTriangle == NAV_INVALID_INDEX || m_triangleClusters[neighborTriangle] != clusterIndex || context.IsClosed(neighborTriangle)) continue;
+
+			float edgeCost = m_navGraph->GetEdgeCost(currentTriangle, neighborTriangle);
+			if (edgeCost == FLT_MAX) continue;
+
+			float gCost = currentGCost + edgeCost;
+			if (context.IsSeen(neighborTriangle) && gCost >= context.m_gCosts[neighborTriangle]) continue;
+
+			context.MarkSeen(neighborTriangle, gCost, currentTriangle);
+			context.PushOpen(neighborTriangle, gCost + getHeuristic(neighborTriangle));
+		}
+	}
+
+	return !hasGoal;
+}
+
+bool NavHierarchy::AppendClusterCorridor(int startTriangle, int goalTriangle, int clusterIndex, NavSearchContext& context, std::vector<int>& out_corridor, NavLandmarks const* landmarks) const
+{
+	if (!SearchWithinCluster(startTriangle, goalTriangle, clusterIndex, context, landmarks)) return false;
+
+	// Walk back into the context's corridor, then append it start first
+	for (int triangleIndex = goalTriangle; triangleIndex != NAV_INVALID_INDEX; triangleIndex = context.m_parentIndexes[triangleIndex])
+	{
+		context.m_corridor.emplace_back(triangleIndex);
+	}
+
+	for (int corridorIndex = static_cast<int>(context.m_corridor.size()) - 1; corridorIndex >= 0; corridorIndex--)
+	{
+		int triangleIndex = context.m_corridor[corridorIndex];
+		if (!out_corridor.empty() && out_corridor.back() == triangleIndex) continue;
+		out_corridor.emplace_back(triangleIndex);
+	}
+	return true;
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include "Game/Navigation/NavGraph.hpp"
+#include <vector>
+
+class NavLandmarks;
+class NavSearchContext;
+
+constexpr int NAV_CLUSTER_SIZE = 16;
+constexpr int NAV_CROSSINGS_PER_TRANSITION = 8;
+constexpr int NAV_HIERARCHY_NUM_LANDMARKS = 8;
+
+//------------------------------------------------------------------------------------------------
+// Abstract nodes are the triangles on either side of a chosen cluster border crossing. Edges either
+// hop across the border (the two triangles are neighbors) or run inside one cluster, in which case
+// the cost is the shortest path that stays inside it.
+struct NavAbstractNode
+{
+	int m_triangleIndex = NAV_INVALID_INDEX;
+	int m_clusterIndex = NAV_INVALID_INDEX;
+	int m_firstEdge = 0;
+	int m_numEdges = 0;
+};
+
+// Border hops are kept while their triangle is blocked, with FLT_MAX cost, so reopening it only
+// needs a new cost
+struct NavAbstractEdge
+{
+	int m_toNode = NAV_INVALID_INDEX;
+	float m_cost = 0.f;
+};
+
+//------------------------------------------------------------------------------------------------
+// HPA* layer over a NavGraph. Triangles are binned into square clusters by centroid, a few crossings
+// on every shared cluster border become abstract nodes, and intra cluster costs are precomputed.
+// A query searches the small abstract graph and then only refines the clusters the route crosses.
+// Costs follow the graph's triangle cost scales; after a batch of cost changes ApplyCostChanges
+// refloods only the clusters that hold a changed triangle, and the layer stays in use.
+//
+// The abstract search is guided by landmark lower bounds over the abstract graph (the same ALT
+// bounds NavLandmarks keeps per triangle, but only a few floats per abstract node). Straight line
+// distance alone lets a long query expand close to half the abstract graph. The tables are taken at
+// Build on the unscaled graph, and cost scales only raise costs, so they stay admissible.
+class NavHierarchy
+{
+public:
+	NavHierarchy() = default;
+	~NavHierarchy() = default;
+
+	void Build(NavGraph const* navGraph, int clusterSize = NAV_CLUSTER_SIZE);
+	void Clear();
+
+	// Fills context.m_corridor from start to goal like NavPathfinder::FindCorridor. Triangle landmarks,
+	// when given, tighten the heuristic of the refinement inside each cluster.
+	bool FindCorridor(int startTriangle, int goalTriangle, NavSearchContext& context, NavLandmarks const* landmarks = nullptr) const;
+
+	// Main thread, with no query running. False when the graph was rebuilt rather than recosted since
+	// the last sync, in which case the layer stays stale until the next Build.
+	bool ApplyCostChanges();
+
+	bool IsBuiltFor(NavGraph const* navGraph) const;
+	int GetClusterIndex(int triangleIndex) const { return m_triangleClusters[triangleIndex]; }
+	int GetNumClusters() const { return m_numClustersX * m_numClustersY; }
+	int GetNumNodes() const { return static_cast<int>(m_nodes.size()); }
+
+private:
+	void BuildClusters(int clusterSize);
+	void BuildTransitions(std::vector<std::vector<NavAbstractEdge>>& nodeEdges);
+	void BuildIntraClusterEdges(std::vector<std::vector<NavAbstractEdge>>& nodeEdges);
+	void FloodClusterEdges(int clusterIndex, std::vector<std::vector<NavAbstractEdge>>& nodeEdges);
+	void FlattenEdges(std::vector<std::vector<NavAbstractEdge>> const& nodeEdges);
+	void BuildLandmarks(int numLandmarks);
+	void ComputeLandmarkDistances(int sourceNode, NavSearchContext& context) const;
+	int GetOrAddNode(int triangleIndex, std::vector<std::vector<NavAbstractEdge>>& nodeEdges);
+
+	// Goal NAV_INVALID_INDEX floods the whole cluster, leaving every reachable g cost in the context
+	bool SearchWithinCluster(int startTriangle, int goalTriangle, int clusterIndex, NavSearchContext& context, NavLandmarks const* landmarks = nullptr) const;
+	bool AppendClusterCorridor(int startTriangle, int goalTriangle, int clusterIndex, NavSearchContext& context, std::vector<int>& out_corridor, NavLandmarks const* landmarks) const;
+
+public:
+	NavGraph const* m_navGraph = nullptr;
+	unsigned int m_graphVersion = 0;
+	int m_numSyncedCostChanges = 0; // How much of NavGraph::m_costChangeLog the edge costs include
+
+	int m_clusterSize = NAV_CLUSTER_SIZE;
+	int m_numClustersX = 0;
+	int m_numClustersY = 0;
+	float m_originX = 0.f;
+	float m_originY = 0.f;
+	std::vector<int> m_triangleClusters;
+
+	std::vector<NavAbstractNode> m_nodes;
+	std::vector<NavAbstractEdge> m_edges;
+	std::vector<int> m_triangleNodes;
+
+	// Abstract nodes grouped by cluster, m_clusterFirstNodes has one extra entry at the end
+	std::vector<int> m_clusterFirstNodes;
+	std::vector<int> m_clusterNodes;
+
+	// Node major like NavLandmarks::m_distances, FLT_MAX where the node cannot reach the landmark
+	std::vector<int> m_landmarkNodes;
+	std::vector<float> m_landmarkDistances;
+};
@@ -0,0 +1,165 @@
+#include "Game/Navigation/NavLandmarks.hpp"
+#include "Game/Diagnostics/Profiler.hpp"
+#include "Game/Navigation/NavSearchContext.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <thread>
+
+constexpr float NAV_LANDMARK_PI = 3.14159265f;
+
+void NavLandmarks::Build(NavGraph const* navGraph, int numLandmarks)
+{
+	Clear();
+	m_navGraph = navGraph;
+	if (m_navGraph == nullptr || m_navGraph->IsEmpty() || numLandmarks <= 0) return;
+
+	m_graphVersion = m_navGraph->m_version;
+	m_numCostChangesAtBuild = static_cast<int>(m_navGraph->m_costChangeLog.size());
+
+	SelectLandmarks(numLandmarks);
+	int numSelected = GetNumLandmarks();
+	m_distances.assign(static_cast<size_t>(m_navGraph->GetNumTriangles()) * static_cast<size_t>(numSelected), FLT_MAX);
+
+	// Every landmark writes its own column, the main thread runs the last one itself instead of idling
+	for (int landmarkIndex = 0; landmarkIndex < numSelected - 1; landmarkIndex++)
+	{
+		m_numPendingLandmarkJobs++;
+		QueueGameJob(new NavLandmarkJob(*this, landmarkIndex, m_numPendingLandmarkJobs));
+	}
+	if (numSelected > 0)
+	{
+		ComputeDistancesFromLandmark(numSelected - 1);
+	}
+
+	while (m_numPendingLandmarkJobs > 0)
+	{
+		std::this_thread::yield();
+	}
+}
+
+void NavLandmarks::Clear()
+{
+	m_navGraph = nullptr;
+	m_graphVersion = 0;
+	m_numCostChangesAtBuild = 0;
+	m_landmarkTriangles.clear();
+	m_distances.clear();
+}
+
+bool NavLandmarks::IsBuiltFor(NavGraph const* navGraph) const
+{
+	if (navGraph == nullptr || m_navGraph != navGraph || m_landmarkTriangles.empty()) return false;
+
+	// Cost changes keep the tables valid, any other version bump means the graph was rebuilt
+	int numCostChanges = static_cast<int>(navGraph->m_costChangeLog.size());
+	if (numCostChanges < m_numCostChangesAtBuild) return false;
+	return navGraph->m_version - m_graphVersion == static_cast<unsigned int>(numCostChanges - m_numCostChangesAtBuild);
+}
+
+float NavLandmarks::GetHeuristic(int triangleIndex, int goalTriangle) const
+{
+	int numLandmarks = GetNumLandmarks();
+	float const* triangleDistances = &m_distances[static_cast<size_t>(triangleIndex) * numLandmarks];
+	float const* goalDistances = &m_distances[static_cast<size_t>(goalTriangle) * numLandmarks];
+
+	float bestBound = 0.f;
+	for (int landmarkIndex = 0; landmarkIndex < numLandmarks; landmarkIndex++)
+	{
+		float triangleDistance = triangleDistances[landmarkIndex];
+		float goalDistance = goalDistances[landmarkIndex];
+		if (triangleDistance == FLT_MAX || goalDistance == FLT_MAX) continue;
+
+		bestBound = std::max(bestBound, fabsf(goalDistance - triangleDistance));
+	}
+	return bestBound;
+}
+
+void NavLandmarks::ComputeDistancesFromLandmark(int landmarkIndex)
+{
+	// Plain Dijkstra over centroid distances, ignoring cost scales on purpose
+	std::vector<NavTriangle> const& triangles = m_navGraph->m_triangles;
+	int numLandmarks = GetNumLandmarks();
+	int landmarkTriangle = m_landmarkTriangles[landmarkIndex];
+
+	NavSearchContext& context = NavSearchContext::GetForCurrentThread();
+	context.BeginSearch(m_navGraph->GetNumTriangles());
+	context.MarkSeen(landmarkTriangle, 0.f, NAV_INVALID_INDEX);
+	context.PushOpen(landmarkTriangle, 0.f);
+
+	while (!context.IsOpenEmpty())
+	{
+		int currentTriangle = context.PopOpen().m_triangleIndex;
+		if (context.IsClosed(currentTriangle)) continue;
+		context.MarkClosed(currentTriangle);
+
+		float currentDistance = context.m_gCosts[currentTriangle];
+		m_distances[(static_cast<size_t>(currentTriangle) * numLandmarks) + landmarkIndex] = currentDistance;
+
+		NavTriangle const& triangle = triangles[currentTriangle];
+		for (int edge = 0; edge < 3; edge++)
+		{
+			int neighborTriangle = triangle.m_neighborIndexes[edge];
+			if (neighborTriangle == NAV_INVALID_INDEX || context.IsClosed(neighborTriangle)) continue;
+
+			float distance = currentDistance + GetDistance3D(triangle.m_centroid, triangles[neighborTriangle].m_centroid);
+			if (context.IsSeen(neighborTriangle) && distance >= context.m_gCosts[neighborTriangle]) continue;
+
+			context.MarkSeen(neighborTriangle, distance, currentTriangle);
+			context.PushOpen(neighborTriangle, distance);
+		}
+	}
+}
+
+void NavLandmarks::SelectLandmarks(int numLandmarks)
+{
+	// Split the graph into equal angle sectors around the center of its bounds and take the triangle
+	// farthest out in each one. Landmarks behind the goal as seen from the start give the tightest
+	// bounds, so they want to sit on the rim, spread all the way around.
+	std::vector<NavTriangle> const& triangles = m_navGraph->m_triangles;
+	float minX = FLT_MAX;
+	float minY = FLT_MAX;
+	float maxX = -FLT_MAX;
+	float maxY = -FLT_MAX;
+	for (NavTriangle const& triangle : triangles)
+	{
+		minX = std::min(minX, triangle.m_centroid.x);
+		minY = std::min(minY, triangle.m_centroid.y);
+		maxX = std::max(maxX, triangle.m_centroid.x);
+		maxY = std::max(maxY, triangle.m_centroid.y);
+	}
+	float centerX = (minX + maxX) * 0.5f;
+	float centerY = (minY + maxY) * 0.5f;
+
+	std::vector<int> sectorTriangles(static_cast<size_t>(numLandmarks), NAV_INVALID_INDEX);
+	std::vector<float> sectorDistancesSq(static_cast<size_t>(numLandmarks), -1.f);
+	float sectorsPerRadian = static_cast<float>(numLandmarks) / (2.f * NAV_LANDMARK_PI);
+	for (int triangleIndex = 0; triangleIndex < m_navGraph->GetNumTriangles(); triangleIndex++)
+	{
+		float offsetX = triangles[triangleIndex].m_centroid.x - centerX;
+		float offsetY = triangles[triangleIndex].m_centroid.y - centerY;
+		float angle = atan2f(offsetY, offsetX) + NAV_LANDMARK_PI;
+		int sector = std::min(static_cast<int>(angle * sectorsPerRadian), numLandmarks - 1);
+
+		float distanceSq = (offsetX * offsetX) + (offsetY * offsetY);
+		if (distanceSq > sectorDistancesSq[sector])
+		{
+			sectorDistancesSq[sector] = distanceSq;
+			sectorTriangles[sector] = triangleIndex;
+		}
+	}
+
+	for (int triangleIndex : sectorTriangles)
+	{
+		if (triangleIndex == NAV_INVALID_INDEX) continue;
+		m_landmarkTriangles.emplace_back(triangleIndex);
+	}
+}
+
+void NavLandmarkJob::ExecuteGameJob()
+{
+	PROFILE_ZONE("NavLandmarkJob");
+	m_landmarks.ComputeDistancesFromLandmark(m_landmarkIndex);
+	m_numPendingJobs--;
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "Game/JobCompletionDispatcher.hpp"
+#include "Game/Navigation/NavGraph.hpp"
+#include <atomic>
+#include <vector>
+
+constexpr int NAV_DEFAULT_NUM_LANDMARKS = 8;
+
+//------------------------------------------------------------------------------------------------
+// ALT (A*, Landmarks, Triangle inequality) heuristic tables. A few landmark triangles are spread
+// around the edge of the graph, and the shortest path distance from every landmark to every triangle
+// is precomputed. For any landmark L, |d(L, goal) - d(L, n)| never overestimates d(n, goal). Unlike
+// straight line distance, it accounts for the detours around unwalkable mountains.
+//
+// Distances are taken on the unscaled graph. Cost scales only ever raise edge costs, so the bounds
+// stay admissible after obstacles are placed and the tables only go stale when the graph is rebuilt.
+class NavLandmarks
+{
+public:
+	NavLandmarks() = default;
+	~NavLandmarks() = default;
+
+	// One Dijkstra per landmark, run in parallel on the JobSystem
+	void Build(NavGraph const* navGraph, int numLandmarks = NAV_DEFAULT_NUM_LANDMARKS);
+	void Clear();
+
+	bool IsBuiltFor(NavGraph const* navGraph) const;
+	float GetHeuristic(int triangleIndex, int goalTriangle) const;
+	int GetNumLandmarks() const { return static_cast<int>(m_landmarkTriangles.size()); }
+
+	void ComputeDistancesFromLandmark(int landmarkIndex);
+
+private:
+	void SelectLandmarks(int numLandmarks);
+
+public:
+	NavGraph const* m_navGraph = nullptr;
+	unsigned int m_graphVersion = 0;
+	int m_numCostChangesAtBuild = 0;
+
+	std::vector<int> m_landmarkTriangles;
+
+	// Triangle major, the distances of one triangle to every landmark sit next to each other.
+	// FLT_MAX where the triangle cannot reach the landmark.
+	std::vector<float> m_distances;
+
+private:
+	std::atomic<int> m_numPendingLandmarkJobs{ 0 };
+};
+
+//------------------------------------------------------------------------------------------------
+class NavLandmarkJob : public GameJob
+{
+public:
+	NavLandmarkJob(NavLandmarks& landmarks, int landmarkIndex, std::atomic<int>& numPendingJobs)
+		: GameJob(GameJobType::NAV_LANDMARK_BUILD), m_landmarks(landmarks), m_landmarkIndex(landmarkIndex), m_numPendingJobs(numPendingJobs) {}
+
+	virtual void ExecuteGameJob() override;
+
+public:
+	NavLandmarks& m_landmarks;
+	int m_landmarkIndex = 0;
+	std::atomic<int>& m_numPendingJobs;
+};
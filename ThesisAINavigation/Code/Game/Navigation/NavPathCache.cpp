@@ -0,0 +1,81 @@
+#include "Game/Navigation/NavPathCache.hpp"
+#include <iterator>
+
+static unsigned long long MakePathCacheKey(int startTriangle, int goalTriangle)
+{
+	return (static_cast<unsigned long long>(static_cast<unsigned int>(startTriangle)) << 32) | static_cast<unsigned int>(goalTriangle);
+}
+
+NavPathCache::NavPathCache(int capacity)
+	: m_capacity(capacity)
+{
+	m_entryLookup.reserve(static_cast<size_t>(capacity));
+}
+
+bool NavPathCache::TryGetCorridor(int startTriangle, int goalTriangle, unsigned int graphVersion, std::vector<int>& out_corridor)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	InvalidateIfStale(graphVersion);
+
+	auto found = m_entryLookup.find(MakePathCacheKey(startTriangle, goalTriangle));
+	if (found == m_entryLookup.end())
+	{
+		m_numMisses++;
+		return false;
+	}
+
+	m_entries.splice(m_entries.begin(), m_entries, found->second);
+	out_corridor.assign(found->second->m_corridor.begin(), found->second->m_corridor.end());
+	m_numHits++;
+	return true;
+}
+
+void NavPathCache::StoreCorridor(int startTriangle, int goalTriangle, unsigned int graphVersion, std::vector<int> const& corridor)
+{
+	if (m_capacity <= 0) return;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	InvalidateIfStale(graphVersion);
+
+	// Another worker may have stored the same pair while we were searching
+	unsigned long long key = MakePathCacheKey(startTriangle, goalTriangle);
+	if (m_entryLookup.find(key) != m_entryLookup.end()) return;
+
+	// A full cache recycles its least recently used entry, corridor allocation included
+	if (static_cast<int>(m_entries.size()) >= m_capacity)
+	{
+		m_entryLookup.erase(m_entries.back().m_key);
+		m_entries.splice(m_entries.begin(), m_entries, std::prev(m_entries.end()));
+	}
+	else
+	{
+		m_entries.emplace_front();
+	}
+
+	Entry& entry = m_entries.front();
+	entry.m_key = key;
+	entry.m_corridor.assign(corridor.begin(), corridor.end());
+	m_entryLookup[key] = m_entries.begin();
+}
+
+void NavPathCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_entries.clear();
+	m_entryLookup.clear();
+}
+
+int NavPathCache::GetNumEntries() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return static_cast<int>(m_entries.size());
+}
+
+void NavPathCache::InvalidateIfStale(unsigned int graphVersion)
+{
+	if (graphVersion == m_graphVersion) return;
+
+	m_entries.clear();
+	m_entryLookup.clear();
+	m_graphVersion = graphVersion;
+}
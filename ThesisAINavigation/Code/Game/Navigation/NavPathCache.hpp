@@ -0,0 +1,47 @@
+#pragma once
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+constexpr int NAV_PATH_CACHE_DEFAULT_CAPACITY = 1024;
+
+//------------------------------------------------------------------------------------------------
+// LRU cache of triangle corridors keyed by (start triangle, goal triangle). Only the corridor is
+// kept, the caller funnels it against its own start and goal points, so agents standing anywhere in
+// the same pair of triangles share one entry. Entries belong to one graph version and the whole
+// cache is dropped as soon as a lookup or store sees a newer one. Safe to use from any thread.
+class NavPathCache
+{
+public:
+	explicit NavPathCache(int capacity = NAV_PATH_CACHE_DEFAULT_CAPACITY);
+	~NavPathCache() = default;
+
+	bool TryGetCorridor(int startTriangle, int goalTriangle, unsigned int graphVersion, std::vector<int>& out_corridor);
+	void StoreCorridor(int startTriangle, int goalTriangle, unsigned int graphVersion, std::vector<int> const& corridor);
+	void Clear();
+
+	unsigned long long GetNumHits() const { return m_numHits; }
+	unsigned long long GetNumMisses() const { return m_numMisses; }
+	int GetNumEntries() const;
+
+private:
+	struct Entry
+	{
+		unsigned long long m_key = 0;
+		std::vector<int> m_corridor;
+	};
+
+	void InvalidateIfStale(unsigned int graphVersion);
+
+private:
+	mutable std::mutex m_mutex;
+	std::list<Entry> m_entries; // Most recently used first
+	std::unordered_map<unsigned long long, std::list<Entry>::iterator> m_entryLookup;
+	int m_capacity = 0;
+	unsigned int m_graphVersion = 0;
+
+	std::atomic<unsigned long long> m_numHits{ 0 };
+	std::atomic<unsigned long long> m_numMisses{ 0 };
+};
@@ -0,0 +1,311 @@
+#include "Game/Navigation/NavPathfinder.hpp"
+#include "Game/Navigation/NavDStarLite.hpp"
+#include "Game/Navigation/NavGraph.hpp"
+#include "Game/Navigation/NavHierarchy.hpp"
+#include "Game/Navigation/NavLandmarks.hpp"
+#include "Game/Navigation/NavPathCache.hpp"
+#include "Game/Navigation/NavSearchContext.hpp"
+#include "Game/Navigation/NavTileStreamer.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+#include <cfloat>
+
+NavPathfinder::NavPathfinder(NavGraph const* navGraph, NavHierarchy const* navHierarchy)
+	: m_navGraph(navGraph), m_navHierarchy(navHierarchy)
+{
+}
+
+static void FillQueryStats(NavQuerySource source, NavSearchStats const& searchStats, bool isFound, Vec3 const& startPoint, std::vector<Vec3> const& path, double beginSeconds, NavQueryStats& out_stats)
+{
+	out_stats.m_source = source;
+	out_stats.m_search = searchStats;
+	out_stats.m_isFound = isFound;
+	out_stats.m_numWaypoints = static_cast<int>(path.size());
+	out_stats.m_pathLength = NavPathfinder::GetPathLength(startPoint, path);
+	out_stats.m_msElapsed = 1000.f * static_cast<float>(GetCurrentTimeSeconds() - beginSeconds);
+}
+
+bool NavPathfinder::ComputeAStar(Vec3 const& startPoint, Vec3 const& goalPoint, std::vector<Vec3>& out_path, NavQueryStats* out_stats) const
+{
+	double beginSeconds = (out_stats != nullptr) ? GetCurrentTimeSeconds() : 0.0;
+
+	// Every search of this query runs on this context or adds into it
+	NavSearchContext& context = NavSearchContext::GetForCurrentThread();
+	context.m_stats = NavSearchStats();
+
+	NavQuerySource source = NavQuerySource::NONE;
+	bool isWaitingForTiles = false;
+	bool isFound = FindPath(startPoint, goalPoint, out_path, source, isWaitingForTiles);
+	if (out_stats != nullptr)
+	{
+		FillQueryStats(source, context.m_stats, isFound, startPoint, out_path, beginSeconds, *out_stats);
+		out_stats->m_isWaitingForTiles = isWaitingForTiles;
+	}
+	return isFound;
+}
+
+bool NavPathfinder::FindPath(Vec3 const& startPoint, Vec3 const& goalPoint, std::vector<Vec3>& out_path, NavQuerySource& out_source, bool& out_isWaitingForTiles) const
+{
+	out_path.clear();
+	out_isWaitingForTiles = false;
+	if (m_tileStreamer != nullptr)
+	{
+		out_source = NavQuerySource::STREAMED;
+		NavSearchContext& streamContext = NavSearchContext::GetForCurrentThread();
+		NavStreamSearchResult streamResult = m_tileStreamer->FindPortals(startPoint, goalPoint, streamContext);
+		out_isWaitingForTiles = (streamResult == NavStreamSearchResult::PENDING_TILES);
+		if (streamResult != NavStreamSearchResult::FOUND) return false;
+
+		StringPullPortals(streamContext, out_path);
+		return true;
+	}
+	if (m_navGraph == nullptr || m_navGraph->IsEmpty()) return false;
+
+	int startTriangle = m_navGraph->FindNearestTriangle(startPoint);
+	int goalTriangle = m_navGraph->FindNearestTriangle(goalPoint);
+
+	NavSearchContext& context = NavSearchContext::GetForCurrentThread();
+	bool isCorridorCached = m_pathCache != nullptr && m_pathCache->TryGetCorridor(startTriangle, goalTriangle, m_navGraph->m_version, context.m_corridor);
+	bool isCorridorFound = isCorridorCached;
+	NavLandmarks const* landmarks = (m_landmarks != nullptr && m_landmarks->IsBuiltFor(m_navGraph)) ? m_landmarks : nullptr;
+	out_source = isCorridorCached ? NavQuerySource::CACHED : NavQuerySource::NONE;
+
+	// The hierarchy keeps its own bounds over the abstract graph, the triangle landmark tables only
+	// guide its refinement and the flat fallback
+	if (!isCorridorFound && m_navHierarchy != nullptr && m_navHierarchy->IsBuiltFor(m_navGraph))
+	{
+		out_source = NavQuerySource::HIERARCHY;
+		isCorridorFound = m_navHierarchy->FindCorridor(startTriangle, goalTriangle, context, landmarks);
+	}
+	if (!isCorridorFound)
+	{
+		out_source = NavQuerySource::FLAT;
+		isCorridorFound = FindCorridor(startTriangle, goalTriangle, context);
+	}
+	if (!isCorridorFound) return false;
+
+	if (m_pathCache != nullptr && !isCorridorCached)
+	{
+		m_pathCache->StoreCorridor(startTriangle, goalTriangle, m_navGraph->m_version, context.m_corridor);
+	}
+
+	BuildPortals(context.m_corridor, startPoint, goalPoint, context);
+	StringPullPortals(context, out_path);
+	return true;
+}
+
+bool NavPathfinder::ComputeIncremental(NavDStarLite& planner, Vec3 const& startPoint, Vec3 const& goalPoint, std::vector<Vec3>& out_path, NavQueryStats* out_stats) const
+{
+	double beginSeconds = (out_stats != nullptr) ? GetCurrentTimeSeconds() : 0.0;
+	out_path.clear();
+
+	bool isPlanned = m_navGraph != nullptr && !m_navGraph->IsEmpty();
+	bool isFound = false;
+	if (isPlanned)
+	{
+		int startTriangle = m_navGraph->FindNearestTriangleFromHint(startPoint, planner.m_startTriangle);
+		int goalTriangle = m_navGraph->FindNearestTriangleFromHint(goalPoint, planner.m_goalTriangle);
+
+		NavSearchContext& context = NavSearchContext::GetForCurrentThread();
+		if (planner.Plan(m_navGraph, startTriangle, goalTriangle) && planner.ExtractCorridor(context.m_corridor))
+		{
+			BuildPortals(context.m_corridor, startPoint, goalPoint, context);
+			StringPullPortals(context, out_path);
+			isFound = true;
+		}
+	}
+
+	if (out_stats != nullptr)
+	{
+		FillQueryStats(isPlanned ? NavQuerySource::INCREMENTAL : NavQuerySource::NONE, isPlanned ? planner.m_lastPlanStats : NavSearchStats(), isFound, startPoint, out_path, beginSeconds, *out_stats);
+	}
+	return isFound;
+}
+
+bool NavPathfinder::FindCorridor(int startTriangle, int goalTriangle, NavSearchContext& context) const
+{
+	context.BeginSearch(m_navGraph->GetNumTriangles());
+	if (startTriangle == NAV_INVALID_INDEX || goalTriangle == NAV_INVALID_INDEX) return false;
+
+	std::vector<NavTriangle> const& triangles = m_navGraph->m_triangles;
+	Vec3 const& goalCentroid = triangles[goalTriangle].m_centroid;
+	NavLandmarks const* landmarks = (m_landmarks != nullptr && m_landmarks->IsBuiltFor(m_navGraph)) ? m_landmarks : nullptr;
+
+	// Both bounds are admissible, so the larger one is too
+	auto getHeuristic = [&](int triangleIndex)
+	{
+		float straightLine = GetDistance3D(triangles[triangleIndex].m_centroid, goalCentroid);
+		return (landmarks != nullptr) ? std::max(straightLine, landmarks->GetHeuristic(triangleIndex, goalTriangle)) : straightLine;
+	};
+
+	context.MarkSeen(startTriangle, 0.f, NAV_INVALID_INDEX);
+	context.PushOpen(startTriangle, getHeuristic(startTriangle));
+
+	while (!context.IsOpenEmpty())
+	{
+		int currentTriangle = context.PopOpen().m_triangleIndex;
+
+		// The heap keeps stale duplicates instead of supporting decrease-key
+		if (context.IsClosed(currentTriangle)) continue;
+		context.MarkClosed(currentTriangle);
+
+		if (currentTriangle == goalTriangle)
+		{
+			for (int triangleIndex = goalTriangle; triangleIndex != NAV_INVALID_INDEX; triangleIndex = context.m_parentIndexes[triangleIndex])
+			{
+				context.m_corridor.emplace_back(triangleIndex);
+			}
+			std::reverse(context.m_corridor.begin(), context.m_corridor.end());
+			return true;
+		}
+
+		NavTriangle const& triangle = triangles[currentTriangle];
+		float currentGCost = context.m_gCosts[currentTriangle];
+
+		for (int edge = 0; edge < 3; edge++)
+		{
+			int neighborTriangle = triangle.m_neighborIndexes[edge];
+			if (neighborTriangle == NAV_INVALID_INDEX || context.IsClosed(neighborTriangle)) continue;
+
+			float edgeCost = m_navGraph->GetEdgeCost(currentTriangle, neighborTriangle);
+			if (edgeCost == FLT_MAX) continue;
+
+			float gCost = currentGCost + edgeCost;
+			if (context.IsSeen(neighborTriangle) && gCost >= context.m_gCosts[neighborTriangle]) continue;
+
+			context.MarkSeen(neighborTriangle, gCost, currentTriangle);
+			context.PushOpen(neighborTriangle, gCost + getHeuristic(neighborTriangle));
+		}
+	}
+
+	return false;
+}
+
+// Positive when c is to the left of the ray from a through b, in XY
+static float GetSignedAreaXY(Vec3 const& a, Vec3 const& b, Vec3 const& c)
+{
+	return ((b.x - a.x) * (c.y - a.y)) - ((b.y - a.y) * (c.x - a.x));
+}
+
+static bool IsSamePointXY(Vec3 const& a, Vec3 const& b)
+{
+	return a.x == b.x && a.y == b.y;
+}
+
+void NavPathfinder::BuildPortals(std::vector<int> const& corridor, Vec3 const& startPoint, Vec3 const& goalPoint, NavSearchContext& context) const
+{
+	context.m_portalLefts.clear();
+	context.m_portalRights.clear();
+	context.m_portalLefts.emplace_back(startPoint);
+	context.m_portalRights.emplace_back(startPoint);
+
+	std::vector<NavTriangle> const& triangles = m_navGraph->m_triangles;
+	for (int corridorIndex = 0; corridorIndex + 1 < static_cast<int>(corridor.size()); corridorIndex++)
+	{
+		int fromTriangle = corridor[corridorIndex];
+		int toTriangle = corridor[corridorIndex + 1];
+		for (int edge = 0; edge < 3; edge++)
+		{
+			if (triangles[fromTriangle].m_neighborIndexes[edge] != toTriangle) continue;
+
+			AddPortal(triangles[fromTriangle].m_centroid, m_navGraph->GetTriangleVertex(fromTriangle, edge), m_navGraph->GetTriangleVertex(fromTriangle, (edge + 1) % 3), context);
+			break;
+		}
+	}
+
+	context.m_portalLefts.emplace_back(goalPoint);
+	context.m_portalRights.emplace_back(goalPoint);
+}
+
+void NavPathfinder::AddPortal(Vec3 const& fromCentroid, Vec3 const& edgeStart, Vec3 const& edgeEnd, NavSearchContext& context)
+{
+	// Sides are decided from inside the triangle we leave, jittered slivers may wind either way
+	bool isEndOnLeft = GetSignedAreaXY(fromCentroid, edgeStart, edgeEnd) > 0.f;
+	context.m_portalLefts.emplace_back(isEndOnLeft ? edgeEnd : edgeStart);
+	context.m_portalRights.emplace_back(isEndOnLeft ? edgeStart : edgeEnd);
+}
+
+float NavPathfinder::GetPathLength(Vec3 const& startPoint, std::vector<Vec3> const& path)
+{
+	float pathLength = 0.f;
+	Vec3 previousPoint = startPoint;
+	for (int pathIndex = static_cast<int>(path.size()) - 1; pathIndex >= 0; pathIndex--)
+	{
+		pathLength += GetDistance3D(previousPoint, path[pathIndex]);
+		previousPoint = path[pathIndex];
+	}
+	return pathLength;
+}
+
+void NavPathfinder::StringPullPortals(NavSearchContext const& context, std::vector<Vec3>& out_path) const
+{
+	// Simple stupid funnel: narrow the apex's left and right rays portal by portal, and when one side
+	// crosses over the other, that side's point is a corner and becomes the new apex
+	std::vector<Vec3> const& lefts = context.m_portalLefts;
+	std::vector<Vec3> const& rights = context.m_portalRights;
+	int numPortals = static_cast<int>(lefts.size());
+
+	Vec3 apex = lefts[0];
+	Vec3 funnelLeft = lefts[0];
+	Vec3 funnelRight = rights[0];
+	int leftIndex = 0;
+	int rightIndex = 0;
+
+	for (int portalIndex = 1; portalIndex < numPortals; portalIndex++)
+	{
+		Vec3 const& left = lefts[portalIndex];
+		Vec3 const& right = rights[portalIndex];
+
+		if (GetSignedAreaXY(apex, funnelRight, right) >= 0.f)
+		{
+			if (IsSamePointXY(apex, funnelRight) || GetSignedAreaXY(apex, funnelLeft, right) < 0.f)
+			{
+				funnelRight = right;
+				rightIndex = portalIndex;
+			}
+			else
+			{
+				if (out_path.empty() || !IsSamePointXY(out_path.back(), funnelLeft))
+				{
+					out_path.emplace_back(funnelLeft);
+				}
+				apex = funnelLeft;
+				funnelRight = apex;
+				rightIndex = leftIndex;
+				portalIndex = leftIndex;
+				continue;
+			}
+		}
+
+		if (GetSignedAreaXY(apex, funnelLeft, left) <= 0.f)
+		{
+			if (IsSamePointXY(apex, funnelLeft) || GetSignedAreaXY(apex, funnelRight, left) > 0.f)
+			{
+				funnelLeft = left;
+				leftIndex = portalIndex;
+			}
+			else
+			{
+				if (out_path.empty() || !IsSamePointXY(out_path.back(), funnelRight))
+				{
+					out_path.emplace_back(funnelRight);
+				}
+				apex = funnelRight;
+				funnelLeft = apex;
+				leftIndex = rightIndex;
+				portalIndex = rightIndex;
+				continue;
+			}
+		}
+	}
+
+	Vec3 const& goalPoint = lefts[numPortals - 1];
+	if (out_path.empty() || !IsSamePointXY(out_path.back(), goalPoint))
+	{
+		out_path.emplace_back(goalPoint);
+	}
+
+	// Corners came out start to goal, the path is consumed from the back
+	std::reverse(out_path.begin(), out_path.end());
+}
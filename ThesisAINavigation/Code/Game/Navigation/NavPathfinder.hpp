@@ -0,0 +1,83 @@
+#pragma once
+#include "Game/Navigation/NavSearchContext.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <vector>
+
+class NavGraph;
+class NavDStarLite;
+class NavHierarchy;
+class NavLandmarks;
+class NavPathCache;
+class NavTileStreamer;
+
+enum class NavQuerySource
+{
+	NONE,
+	STREAMED,
+	CACHED,
+	HIERARCHY,
+	FLAT,
+	INCREMENTAL,
+	NUM_NAV_QUERY_SOURCES
+};
+
+//------------------------------------------------------------------------------------------------
+// What one path query cost. The search counters cover every search the query ran, so a hierarchy
+// miss that fell back to the flat search reports both; a cached corridor reports none.
+struct NavQueryStats
+{
+	NavQuerySource m_source = NavQuerySource::NONE; // Whoever produced the corridor, or the last one tried
+	NavSearchStats m_search;
+	bool m_isFound = false;
+	bool m_isWaitingForTiles = false; // Streamed tiles were missing and got requested, the same query succeeds later
+	int m_numWaypoints = 0;
+	float m_pathLength = 0.f; // Meters from the start point along every waypoint
+	float m_msElapsed = 0.f;
+};
+
+//------------------------------------------------------------------------------------------------
+// A* over the NavGraph triangle adjacency with centroid to centroid edge costs. Searches run on the
+// calling thread's NavSearchContext, so any number of workers can query the same graph at once.
+// With an up to date NavHierarchy the corridor comes from HPA* instead, falling back to the flat
+// search when the abstract graph finds nothing. With a NavTileStreamer set, the search runs over the
+// resident tiles instead of a full graph. Either way the corridor is funnelled into corners. A
+// NavPathCache, when set, hands back corridors for triangle pairs that were searched before. With
+// NavLandmarks set, the flat fallback and the hierarchy's refinement inside each cluster use the ALT
+// lower bounds as their heuristic, which expands only a sliver of what straight line distance would.
+class NavPathfinder
+{
+public:
+	NavPathfinder(NavGraph const* navGraph, NavHierarchy const* navHierarchy = nullptr);
+	~NavPathfinder() = default;
+
+	// Same contract as NavMeshPathfinding::ComputeAStar: the next waypoint is at the back of out_path
+	// and the goal point is at the front. out_path is cleared first and keeps its capacity. When
+	// streamed tiles are still missing it returns false, the tiles get requested and a retry succeeds.
+	// out_stats, when given, is filled whether or not a path was found.
+	bool ComputeAStar(Vec3 const& startPoint, Vec3 const& goalPoint, std::vector<Vec3>& out_path, NavQueryStats* out_stats = nullptr) const;
+
+	// Same contract, but the corridor comes from the caller's D* Lite planner, which repairs its
+	// previous search when only the start moved or triangle costs changed.
+	bool ComputeIncremental(NavDStarLite& planner, Vec3 const& startPoint, Vec3 const& goalPoint, std::vector<Vec3>& out_path, NavQueryStats* out_stats = nullptr) const;
+
+	bool FindCorridor(int startTriangle, int goalTriangle, NavSearchContext& context) const;
+
+	// Turns the corridor into the shared edges crossed, then string pulls them into the corner points
+	// a straight line walker actually has to turn at. The start point itself is not part of the path.
+	void BuildPortals(std::vector<int> const& corridor, Vec3 const& startPoint, Vec3 const& goalPoint, NavSearchContext& context) const;
+	void StringPullPortals(NavSearchContext const& context, std::vector<Vec3>& out_path) const;
+	static void AddPortal(Vec3 const& fromCentroid, Vec3 const& edgeStart, Vec3 const& edgeEnd, NavSearchContext& context);
+
+	// Walks the path in the order it is consumed, back to front, starting from startPoint
+	static float GetPathLength(Vec3 const& startPoint, std::vector<Vec3> const& path);
+
+private:
+	bool FindPath(Vec3 const& startPoint, Vec3 const& goalPoint, std::vector<Vec3>& out_path, NavQuerySource& out_source, bool& out_isWaitingForTiles) const;
+
+public:
+	NavGraph const* m_navGraph = nullptr;
+	NavHierarchy const* m_navHierarchy = nullptr;
+	NavLandmarks const* m_landmarks = nullptr;
+	NavTileStreamer* m_tileStreamer = nullptr;
+	NavPathCache* m_pathCache = nullptr;
+};
@@ -0,0 +1,72 @@
+#include "Game/Navigation/NavSearchContext.hpp"
+#include <algorithm>
+
+// Min heap on f cost
+static bool IsOpenEntryWorse(NavSearchContext::OpenEntry const& a, NavSearchContext::OpenEntry const& b)
+{
+	return a.m_fCost > b.m_fCost;
+}
+
+void NavSearchStats::Add(NavSearchStats const& other)
+{
+	m_numExpanded += other.m_numExpanded;
+	m_numPushed += other.m_numPushed;
+	m_peakOpenSize = std::max(m_peakOpenSize, other.m_peakOpenSize);
+}
+
+NavSearchContext& NavSearchContext::GetForCurrentThread()
+{
+	thread_local NavSearchContext s_searchContext;
+	return s_searchContext;
+}
+
+void NavSearchContext::BeginSearch(int numTriangles)
+{
+	size_t numNodes = static_cast<size_t>(numTriangles);
+	if (m_seenGenerations.size() < numNodes)
+	{
+		m_gCosts.resize(numNodes, 0.f);
+		m_parentIndexes.resize(numNodes, -1);
+		m_seenGenerations.resize(numNodes, 0);
+		m_closedGenerations.resize(numNodes, 0);
+	}
+
+	m_generation++;
+	if (m_generation == 0)
+	{
+		// Wrapped around, old stamps could now look current
+		std::fill(m_seenGenerations.begin(), m_seenGenerations.end(), 0);
+		std::fill(m_closedGenerations.begin(), m_closedGenerations.end(), 0);
+		m_generation = 1;
+	}
+
+	m_openHeap.clear();
+	m_corridor.clear();
+}
+
+void NavSearchContext::MarkSeen(int triangleIndex, float gCost, int parentIndex)
+{
+	m_seenGenerations[triangleIndex] = m_generation;
+	m_gCosts[triangleIndex] = gCost;
+	m_parentIndexes[triangleIndex] = parentIndex;
+}
+
+void NavSearchContext::PushOpen(int triangleIndex, float fCost)
+{
+	OpenEntry entry;
+	entry.m_fCost = fCost;
+	entry.m_triangleIndex = triangleIndex;
+	m_openHeap.emplace_back(entry);
+	std::push_heap(m_openHeap.begin(), m_openHeap.end(), IsOpenEntryWorse);
+
+	m_stats.m_numPushed++;
+	m_stats.m_peakOpenSize = std::max(m_stats.m_peakOpenSize, static_cast<int>(m_openHeap.size()));
+}
+
+NavSearchContext::OpenEntry NavSearchContext::PopOpen()
+{
+	std::pop_heap(m_openHeap.begin(), m_openHeap.end(), IsOpenEntryWorse);
+	OpenEntry entry = m_openHeap.back();
+	m_openHeap.pop_back();
+	return entry;
+}
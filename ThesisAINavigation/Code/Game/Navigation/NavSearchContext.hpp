@@ -0,0 +1,69 @@
+#pragma once
+#include "Engine/Math/Vec3.hpp"
+#include <vector>
+
+//------------------------------------------------------------------------------------------------
+// Work done by the searches that produced one path. A node counts as expanded when it is closed and
+// as pushed every time it enters the open list, stale duplicates included, so pushed minus expanded
+// is the heap churn the lazy decrease-key costs.
+struct NavSearchStats
+{
+	int m_numExpanded = 0;
+	int m_numPushed = 0;
+	int m_peakOpenSize = 0;
+
+	void Add(NavSearchStats const& other);
+};
+
+//------------------------------------------------------------------------------------------------
+// Scratch state for one A* search, kept alive per thread so repeated queries reuse it. Node records
+// are only trusted when their stamp matches the current search generation, so starting a new search
+// is O(1) instead of clearing arrays sized to the whole navmesh. Once the arrays and the heap have
+// grown to fit the graph, a search allocates nothing.
+class NavSearchContext
+{
+public:
+	struct OpenEntry
+	{
+		float m_fCost = 0.f;
+		int m_triangleIndex = -1;
+	};
+
+public:
+	NavSearchContext() = default;
+	~NavSearchContext() = default;
+
+	static NavSearchContext& GetForCurrentThread();
+
+	void BeginSearch(int numTriangles);
+
+	bool IsSeen(int triangleIndex) const { return m_seenGenerations[triangleIndex] == m_generation; }
+	bool IsClosed(int triangleIndex) const { return m_closedGenerations[triangleIndex] == m_generation; }
+	void MarkSeen(int triangleIndex, float gCost, int parentIndex);
+	void MarkClosed(int triangleIndex) { m_closedGenerations[triangleIndex] = m_generation; m_stats.m_numExpanded++; }
+
+	void PushOpen(int triangleIndex, float fCost);
+	OpenEntry PopOpen();
+	bool IsOpenEmpty() const { return m_openHeap.empty(); }
+
+public:
+	std::vector<float> m_gCosts;
+	std::vector<int> m_parentIndexes;
+
+	// Triangle corridor from start to goal, valid until the next search on this thread
+	std::vector<int> m_corridor;
+
+	// Funnel input, one left/right pair per crossed edge with the start and goal as degenerate portals
+	std::vector<Vec3> m_portalLefts;
+	std::vector<Vec3> m_portalRights;
+
+	// Keeps adding up across searches until cleared, so a query that runs several searches on this
+	// context (HPA* refining cluster by cluster) reports them all
+	NavSearchStats m_stats;
+
+private:
+	std::vector<unsigned int> m_seenGenerations;
+	std::vector<unsigned int> m_closedGenerations;
+	std::vector<OpenEntry> m_openHeap;
+	unsigned int m_generation = 0;
+};
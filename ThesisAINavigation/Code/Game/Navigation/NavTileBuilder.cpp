@@ -0,0 +1,201 @@
+#include "Game/Navigation/NavTileBuilder.hpp"
+#include "Game/Diagnostics/Profiler.hpp"
+#include "Game/Navigation/NavGraph.hpp"
+#include <algorithm>
+#include <thread>
+
+// Hashes the cell instead of advancing a generator, any thread can compute any vertex
+static float GetVertexJitter(unsigned int seed, int x, int y, unsigned int channel, float maxDisplacement)
+{
+	unsigned int bits = (static_cast<unsigned int>(x) * 198491317u) + (static_cast<unsigned int>(y) * 6542989u) + (channel * 357239u);
+	bits *= 0xB5297A4Du;
+	bits += seed;
+	bits ^= (bits >> 8);
+	bits += 0x68E31DA4u;
+	bits ^= (bits << 8);
+	bits *= 0x1B56C4E9u;
+	bits ^= (bits >> 8);
+
+	float zeroToOne = static_cast<float>(bits & 0x00FFFFFFu) / static_cast<float>(0x00FFFFFFu);
+	return ((zeroToOne * 2.f) - 1.f) * maxDisplacement;
+}
+
+NavTileBuilder::NavTileBuilder(NavVertexSettings const& settings, std::vector<float> const& heightMap)
+	: m_settings(settings), m_heightMap(heightMap)
+{
+	m_numTilesX = (m_settings.m_gridWidth + NAV_TILE_SIZE - 1) / NAV_TILE_SIZE;
+	m_numTilesY = (m_settings.m_gridHeight + NAV_TILE_SIZE - 1) / NAV_TILE_SIZE;
+	m_mappedWidth = std::max(m_settings.m_gridWidth - (2 * m_settings.m_borderSkip), 0);
+	m_mappedHeight = std::max(m_settings.m_gridHeight - (2 * m_settings.m_borderSkip), 0);
+}
+
+void NavTileBuilder::BuildGraph(NavGraph& out_navGraph)
+{
+	m_navGraph = &out_navGraph;
+	out_navGraph.Clear();
+
+	// Triangles are stored tile by tile so every tile owns one contiguous range
+	int numTiles = GetNumTiles();
+	m_tileFirstTriangles.assign(static_cast<size_t>(numTiles) + 1, 0);
+	for (int tileIndex = 0; tileIndex < numTiles; tileIndex++)
+	{
+		int minX, minY, maxX, maxY;
+		GetTileQuadBounds(tileIndex, minX, minY, maxX, maxY);
+		int numQuads = std::max(maxX - minX, 0) * std::max(maxY - minY, 0);
+		m_tileFirstTriangles[tileIndex + 1] = m_tileFirstTriangles[tileIndex] + (numQuads * 2);
+	}
+
+	out_navGraph.m_vertices.resize(static_cast<size_t>(m_mappedWidth) * static_cast<size_t>(m_mappedHeight));
+	out_navGraph.m_triangles.resize(static_cast<size_t>(m_tileFirstTriangles[numTiles]));
+
+	// Border quads read vertices from the neighboring tile, so every vertex exists before any triangle
+	RunPhase(NavTileBuildPhase::VERTICES);
+	RunPhase(NavTileBuildPhase::TRIANGLES);
+
+	out_navGraph.LinkEdges(0, out_navGraph.GetNumTriangles(), true);
+	out_navGraph.m_version++;
+	out_navGraph.BuildPointGrid();
+	out_navGraph.LabelComponents();
+	m_navGraph = nullptr;
+}
+
+void NavTileBuilder::RunPhase(NavTileBuildPhase phase)
+{
+	// The main thread builds the last tile itself instead of idling
+	int numTiles = GetNumTiles();
+	for (int tileIndex = 0; tileIndex < numTiles - 1; tileIndex++)
+	{
+		m_numPendingTileJobs++;
+		QueueGameJob(new NavTileBuildJob(*this, phase, tileIndex, m_numPendingTileJobs));
+	}
+	if (numTiles > 0)
+	{
+		BuildTile(phase, numTiles - 1);
+	}
+
+	while (m_numPendingTileJobs > 0)
+	{
+		std::this_thread::yield();
+	}
+}
+
+void NavTileBuilder::BuildTile(NavTileBuildPhase phase, int tileIndex)
+{
+	if (phase == NavTileBuildPhase::VERTICES)
+	{
+		BuildTileVertices(tileIndex);
+	}
+	else
+	{
+		BuildTileTriangles(tileIndex);
+	}
+}
+
+void NavTileBuilder::BuildTileVertices(int tileIndex)
+{
+	int tileX = tileIndex % m_numTilesX;
+	int tileY = tileIndex / m_numTilesX;
+	int maxX = std::min((tileX + 1) * NAV_TILE_SIZE, m_settings.m_gridWidth);
+	int maxY = std::min((tileY + 1) * NAV_TILE_SIZE, m_settings.m_gridHeight);
+
+	for (int y = tileY * NAV_TILE_SIZE; y < maxY; y++)
+	{
+		for (int x = tileX * NAV_TILE_SIZE; x < maxX; x++)
+		{
+			int vertexIndex = GetVertexIndex(x, y);
+			if (vertexIndex < 0) continue;
+
+			m_navGraph->m_vertices[vertexIndex] = ComputeVertex(x, y);
+		}
+	}
+}
+
+void NavTileBuilder::BuildTileTriangles(int tileIndex)
+{
+	int minX, minY, maxX, maxY;
+	GetTileQuadBounds(tileIndex, minX, minY, maxX, maxY);
+
+	int triangleIndex = m_tileFirstTriangles[tileIndex];
+	for (int y = minY; y < maxY; y++)
+	{
+		for (int x = minX; x < maxX; x++)
+		{
+			m_navGraph->WriteQuadTriangles(triangleIndex, y, GetVertexIndex(x, y), GetVertexIndex(x + 1, y), GetVertexIndex(x, y + 1), GetVertexIndex(x + 1, y + 1));
+			triangleIndex += 2;
+		}
+	}
+
+	m_navGraph->LinkEdges(m_tileFirstTriangles[tileIndex], m_tileFirstTriangles[tileIndex + 1], false);
+}
+
+void NavTileBuilder::GetTileQuadBounds(int tileIndex, int& out_minX, int& out_minY, int& out_maxX, int& out_maxY) const
+{
+	int tileX = tileIndex % m_numTilesX;
+	int tileY = tileIndex / m_numTilesX;
+	int firstQuadX = m_settings.m_borderSkip;
+	int firstQuadY = m_settings.m_borderSkip;
+	int endQuadX = m_settings.m_borderSkip + m_mappedWidth - 1;
+	int endQuadY = m_settings.m_borderSkip + m_mappedHeight - 1;
+
+	out_minX = std::max(tileX * NAV_TILE_SIZE, firstQuadX);
+	out_minY = std::max(tileY * NAV_TILE_SIZE, firstQuadY);
+	out_maxX = std::max(std::min((tileX + 1) * NAV_TILE_SIZE, endQuadX), out_minX);
+	out_maxY = std::max(std::min((tileY + 1) * NAV_TILE_SIZE, endQuadY), out_minY);
+}
+
+int NavTileBuilder::GetTileIndexOfQuad(int quadX, int quadY) const
+{
+	int firstQuad = m_settings.m_borderSkip;
+	if (quadX < firstQuad || quadY < firstQuad || quadX >= firstQuad + m_mappedWidth - 1 || quadY >= firstQuad + m_mappedHeight - 1) return NAV_INVALID_INDEX;
+
+	return ((quadY / NAV_TILE_SIZE) * m_numTilesX) + (quadX / NAV_TILE_SIZE);
+}
+
+void NavTileBuilder::BuildVertexMapping(std::vector<int>& out_vertexMapping) const
+{
+	out_vertexMapping.resize(static_cast<size_t>(m_settings.m_gridWidth) * static_cast<size_t>(m_settings.m_gridHeight));
+	for (int y = 0; y < m_settings.m_gridHeight; y++)
+	{
+		for (int x = 0; x < m_settings.m_gridWidth; x++)
+		{
+			out_vertexMapping[(y * m_settings.m_gridWidth) + x] = GetVertexIndex(x, y);
+		}
+	}
+}
+
+int NavTileBuilder::GetVertexIndex(int x, int y) const
+{
+	int mappedX = x - m_settings.m_borderSkip;
+	int mappedY = y - m_settings.m_borderSkip;
+	if (mappedX < 0 || mappedY < 0 || mappedX >= m_mappedWidth || mappedY >= m_mappedHeight) return NAV_INVALID_INDEX;
+
+	return (mappedY * m_mappedWidth) + mappedX;
+}
+
+Vec3 NavTileBuilder::ComputeVertex(int x, int y) const
+{
+	int gridWidth = m_settings.m_gridWidth;
+	int gridHeight = m_settings.m_gridHeight;
+	int borderSkip = m_settings.m_borderSkip;
+
+	float height = m_heightMap[(y * gridWidth) + x];
+	float adjustedX = static_cast<float>(x) - (static_cast<float>(gridWidth) / 2.f);
+	float adjustedY = static_cast<float>(y) - (static_cast<float>(gridHeight) / 2.f);
+	float adjustedZ = (height * m_settings.m_heightScale) + m_settings.m_heightBias;
+
+	bool isBorderArea = (x == borderSkip || x == gridWidth - 1 - borderSkip || y == borderSkip || y == gridHeight - 1 - borderSkip);
+	if (!isBorderArea)
+	{
+		adjustedX += ((y % 2 != 0) ? m_settings.m_rowOffset : 0.f) + GetVertexJitter(m_settings.m_seed, x, y, 0, m_settings.m_maxDisplacement);
+		adjustedY += GetVertexJitter(m_settings.m_seed, x, y, 1, m_settings.m_maxDisplacement);
+	}
+
+	return Vec3(adjustedX, adjustedY, adjustedZ);
+}
+
+void NavTileBuildJob::ExecuteGameJob()
+{
+	PROFILE_ZONE("NavTileBuildJob");
+	m_builder.BuildTile(m_phase, m_tileIndex);
+	m_numPendingJobs--;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include "Game/JobCompletionDispatcher.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <atomic>
+#include <vector>
+
+class NavGraph;
+
+constexpr int NAV_TILE_SIZE = 64;
+
+//------------------------------------------------------------------------------------------------
+// How a heightmap cell turns into a navmesh vertex. Cells within m_borderSkip of the edge are left
+// out so agents keep their radius clear of the terrain edge, and the outermost kept ring is neither
+// shifted nor jittered.
+struct NavVertexSettings
+{
+	int m_gridWidth = 0;
+	int m_gridHeight = 0;
+	int m_borderSkip = 0;
+	float m_rowOffset = 0.f;
+	float m_maxDisplacement = 0.f;
+	float m_heightScale = 1.f;
+	float m_heightBias = 0.f;
+	unsigned int m_seed = 0;
+};
+
+enum class NavTileBuildPhase
+{
+	VERTICES,
+	TRIANGLES
+};
+
+//------------------------------------------------------------------------------------------------
+// Builds a NavGraph from a heightmap in NAV_TILE_SIZE square tiles on the JobSystem. Every vertex
+// and triangle index is known up front from the grid, so each tile writes straight into the shared
+// arrays: first all vertices, then each tile's triangles and the adjacency inside it. A serial pass
+// stitches the edges left open along tile borders. Jitter is hashed from the cell, not rolled in
+// order, so the result does not depend on how tiles get scheduled.
+class NavTileBuilder
+{
+public:
+	NavTileBuilder(NavVertexSettings const& settings, std::vector<float> const& heightMap);
+	~NavTileBuilder() = default;
+
+	void BuildGraph(NavGraph& out_navGraph);
+	void BuildTile(NavTileBuildPhase phase, int tileIndex);
+
+	// Same mapping NavMesh::CreateNavMesh expects, cushion cells map to -1
+	void BuildVertexMapping(std::vector<int>& out_vertexMapping) const;
+	int GetVertexIndex(int x, int y) const;
+	Vec3 ComputeVertex(int x, int y) const;
+
+	// Quads whose four corners are all mapped, clipped to the tile. Max bounds are exclusive.
+	void GetTileQuadBounds(int tileIndex, int& out_minX, int& out_minY, int& out_maxX, int& out_maxY) const;
+	int GetTileIndexOfQuad(int quadX, int quadY) const;
+	int GetNumTiles() const { return m_numTilesX * m_numTilesY; }
+
+private:
+	void RunPhase(NavTileBuildPhase phase);
+	void BuildTileVertices(int tileIndex);
+	void BuildTileTriangles(int tileIndex);
+
+public:
+	NavVertexSettings m_settings;
+	std::vector<float> const& m_heightMap;
+	NavGraph* m_navGraph = nullptr;
+
+	int m_numTilesX = 0;
+	int m_numTilesY = 0;
+	int m_mappedWidth = 0;
+	int m_mappedHeight = 0;
+
+	// Prefix sum, tile i owns triangles [m_tileFirstTriangles[i], m_tileFirstTriangles[i + 1])
+	std::vector<int> m_tileFirstTriangles;
+
+private:
+	std::atomic<int> m_numPendingTileJobs{ 0 };
+};
+
+//------------------------------------------------------------------------------------------------
+class NavTileBuildJob : public GameJob
+{
+public:
+	NavTileBuildJob(NavTileBuilder& builder, NavTileBuildPhase phase, int tileIndex, std::atomic<int>& numPendingJobs)
+		: GameJob(GameJobType::NAV_TILE_BUILD), m_builder(builder), m_phase(phase), m_tileIndex(tileIndex), m_numPendingJobs(numPendingJobs) {}
+
+	virtual void ExecuteGameJob() override;
+
+public:
+	NavTileBuilder& m_builder;
+	NavTileBuildPhase m_phase = NavTileBuildPhase::VERTICES;
+	int m_tileIndex = 0;
+	std::atomic<int>& m_numPendingJobs;
+};
@@ -0,0 +1,542 @@
+#include "Game/Navigation/NavTileStreamer.hpp"
+#include "Game/Diagnostics/Profiler.hpp"
+#include "Game/Navigation/NavPathfinder.hpp"
+#include "Game/Navigation/NavSearchContext.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <unordered_map>
+
+struct NavStreamRecord
+{
+	float m_gCost = 0.f;
+	unsigned long long m_parentNode = 0;
+	bool m_hasParent = false;
+	bool m_isClosed = false;
+};
+
+struct NavStreamOpenEntry
+{
+	float m_fCost = 0.f;
+	unsigned long long m_node = 0;
+};
+
+static bool IsStreamOpenEntryWorse(NavStreamOpenEntry const& a, NavStreamOpenEntry const& b)
+{
+	return a.m_fCost > b.m_fCost;
+}
+
+//------------------------------------------------------------------------------------------------
+// A streamed world has far too many triangles for dense per triangle arrays, so search state is
+// keyed by (tile, triangle) in a map that only holds what the search touched. The tiles a search
+// reads are pinned here until the next search on the same thread.
+struct NavStreamScratch
+{
+	std::unordered_map<unsigned long long, NavStreamRecord> m_records;
+	std::vector<NavStreamOpenEntry> m_openHeap;
+	std::unordered_map<int, std::shared_ptr<NavStreamTile const>> m_pinnedTiles;
+	std::vector<unsigned long long> m_corridor;
+};
+
+static NavStreamScratch& GetStreamScratchForCurrentThread()
+{
+	thread_local NavStreamScratch s_scratch;
+	return s_scratch;
+}
+
+static unsigned long long MakeStreamNode(int tileIndex, int triangleIndex)
+{
+	return (static_cast<unsigned long long>(static_cast<unsigned int>(tileIndex)) << 32) | static_cast<unsigned int>(triangleIndex);
+}
+
+static int GetStreamNodeTile(unsigned long long node)
+{
+	return static_cast<int>(node >> 32);
+}
+
+static int GetStreamNodeTriangle(unsigned long long node)
+{
+	return static_cast<int>(node & 0xFFFFFFFFull);
+}
+
+int NavStreamTile::FindBorderTriangle(unsigned long long edgeKey) const
+{
+	auto found = std::lower_bound(m_borderEdges.begin(), m_borderEdges.end(), edgeKey,
+		[](NavBorderEdge const& borderEdge, unsigned long long key) { return borderEdge.m_edgeKey < key; });
+	if (found == m_borderEdges.end() || found->m_edgeKey != edgeKey) return NAV_INVALID_INDEX;
+
+	return found->m_triangleIndex;
+}
+
+size_t NavStreamTile::GetMemoryBytes() const
+{
+	return sizeof(NavStreamTile) + (m_graph.m_vertices.capacity() * sizeof(Vec3)) + (m_graph.m_triangles.capacity() * sizeof(NavTriangle)) +
+		(m_globalVertexIndexes.capacity() * sizeof(int)) + (m_borderEdges.capacity() * sizeof(NavBorderEdge)) +
+		((m_graph.m_gridCellFirstTriangles.capacity() + m_graph.m_gridCellTriangles.capacity()) * sizeof(int));
+}
+
+NavTileStreamer::NavTileStreamer(NavVertexSettings const& settings, std::vector<float> const& heightMap, size_t memoryBudgetBytes)
+	: m_builder(settings, heightMap), m_memoryBudgetBytes(memoryBudgetBytes)
+{
+	int numTiles = m_builder.GetNumTiles();
+	m_tiles.resize(numTiles);
+	m_tileStates.resize(numTiles, NavStreamTileState::UNLOADED);
+	m_tileLastNeededFrames.resize(numTiles, 0);
+}
+
+NavTileStreamer::~NavTileStreamer()
+{
+	// Tile jobs write back into this object
+	while (m_numPendingTileJobs > 0)
+	{
+		std::this_thread::yield();
+	}
+}
+
+void NavTileStreamer::Update(std::vector<Vec3> const& interestPoints)
+{
+	std::vector<int> tilesToBuild;
+	{
+		std::lock_guard<std::mutex> lock(m_tileMutex);
+		m_frameNumber++;
+
+		for (Vec3 const& point : interestPoints)
+		{
+			int centerTile = GetTileIndexAtPoint(point);
+			if (centerTile == NAV_INVALID_INDEX) continue;
+
+			int centerTileX = centerTile % m_builder.m_numTilesX;
+			int centerTileY = centerTile / m_builder.m_numTilesX;
+			int minTileX = std::max(centerTileX - NAV_STREAMING_RADIUS_TILES, 0);
+			int minTileY = std::max(centerTileY - NAV_STREAMING_RADIUS_TILES, 0);
+			int maxTileX = std::min(centerTileX + NAV_STREAMING_RADIUS_TILES, m_builder.m_numTilesX - 1);
+			int maxTileY = std::min(centerTileY + NAV_STREAMING_RADIUS_TILES, m_builder.m_numTilesY - 1);
+			for (int tileY = minTileY; tileY <= maxTileY; tileY++)
+			{
+				for (int tileX = minTileX; tileX <= maxTileX; tileX++)
+				{
+					int tileIndex = (tileY * m_builder.m_numTilesX) + tileX;
+					m_tileLastNeededFrames[tileIndex] = m_frameNumber;
+					if (m_tileStates[tileIndex] == NavStreamTileState::UNLOADED)
+					{
+						m_tileStates[tileIndex] = NavStreamTileState::BUILDING;
+						tilesToBuild.emplace_back(tileIndex);
+					}
+				}
+			}
+		}
+
+		// Tiles searches ran into since last frame
+		for (int tileIndex : m_requestedTiles)
+		{
+			m_tileLastNeededFrames[tileIndex] = m_frameNumber;
+			if (m_tileStates[tileIndex] == NavStreamTileState::UNLOADED)
+			{
+				m_tileStates[tileIndex] = NavStreamTileState::BUILDING;
+				tilesToBuild.emplace_back(tileIndex);
+			}
+		}
+		m_requestedTiles.clear();
+
+		EvictOverBudget();
+	}
+
+	// Queued outside the lock, a finished job takes it again to install its tile
+	for (int tileIndex : tilesToBuild)
+	{
+		QueueTileBuild(tileIndex);
+	}
+}
+
+std::shared_ptr<NavStreamTile const> NavTileStreamer::GetTile(int tileIndex) const
+{
+	std::lock_guard<std::mutex> lock(m_tileMutex);
+	return m_tiles[tileIndex];
+}
+
+void NavTileStreamer::RequestTile(int tileIndex)
+{
+	std::lock_guard<std::mutex> lock(m_tileMutex);
+	if (m_tileStates[tileIndex] != NavStreamTileState::UNLOADED) return;
+	if (std::find(m_requestedTiles.begin(), m_requestedTiles.end(), tileIndex) != m_requestedTiles.end()) return;
+
+	m_requestedTiles.emplace_back(tileIndex);
+}
+
+NavStreamSearchResult NavTileStreamer::FindPortals(Vec3 const& startPoint, Vec3 const& goalPoint, NavSearchContext& context)
+{
+	NavStreamScratch& scratch = GetStreamScratchForCurrentThread();
+	scratch.m_records.clear();
+	scratch.m_openHeap.clear();
+	scratch.m_pinnedTiles.clear();
+	scratch.m_corridor.clear();
+
+	bool isMissingTiles = false;
+	auto acquireTile = [&](int tileIndex) -> NavStreamTile const*
+	{
+		auto pinned = scratch.m_pinnedTiles.find(tileIndex);
+		if (pinned != scratch.m_pinnedTiles.end()) return pinned->second.get();
+
+		std::shared_ptr<NavStreamTile const> tile = GetTile(tileIndex);
+		if (tile == nullptr)
+		{
+			RequestTile(tileIndex);
+			isMissingTiles = true;
+		}
+		scratch.m_pinnedTiles[tileIndex] = tile;
+		return tile.get();
+	};
+
+	int startTileIndex = GetTileIndexAtPoint(startPoint);
+	int goalTileIndex = GetTileIndexAtPoint(goalPoint);
+	if (startTileIndex == NAV_INVALID_INDEX || goalTileIndex == NAV_INVALID_INDEX) return NavStreamSearchResult::NO_PATH;
+
+	NavStreamTile const* startTile = acquireTile(startTileIndex);
+	NavStreamTile const* goalTile = acquireTile(goalTileIndex);
+	if (startTile == nullptr || goalTile == nullptr) return NavStreamSearchResult::PENDING_TILES;
+	if (startTile->m_graph.IsEmpty() || goalTile->m_graph.IsEmpty()) return NavStreamSearchResult::NO_PATH;
+
+	unsigned long long startNode = MakeStreamNode(startTileIndex, startTile->m_graph.FindNearestTriangle(startPoint));
+	unsigned long long goalNode = MakeStreamNode(goalTileIndex, goalTile->m_graph.FindNearestTriangle(goalPoint));
+	Vec3 const& goalCentroid = goalTile->m_graph.m_triangles[GetStreamNodeTriangle(goalNode)].m_centroid;
+
+	NavStreamRecord& startRecord = scratch.m_records[startNode];
+	startRecord.m_gCost = 0.f;
+	NavStreamOpenEntry startEntry;
+	startEntry.m_node = startNode;
+	startEntry.m_fCost = GetDistance3D(startTile->m_graph.m_triangles[GetStreamNodeTriangle(startNode)].m_centroid, goalCentroid);
+	scratch.m_openHeap.emplace_back(startEntry);
+	context.m_stats.m_numPushed++;
+
+	bool isGoalReached = false;
+	int numExpanded = 0;
+	while (!scratch.m_openHeap.empty() && numExpanded < NAV_STREAMING_MAX_SEARCH_NODES)
+	{
+		std::pop_heap(scratch.m_openHeap.begin(), scratch.m_openHeap.end(), IsStreamOpenEntryWorse);
+		unsigned long long currentNode = scratch.m_openHeap.back().m_node;
+		scratch.m_openHeap.pop_back();
+
+		NavStreamRecord& currentRecord = scratch.m_records[currentNode];
+		if (currentRecord.m_isClosed) continue;
+		currentRecord.m_isClosed = true;
+		numExpanded++;
+		context.m_stats.m_numExpanded++;
+
+		if (currentNode == goalNode)
+		{
+			isGoalReached = true;
+			break;
+		}
+
+		int currentTileIndex = GetStreamNodeTile(currentNode);
+		NavStreamTile const* currentTile = acquireTile(currentTileIndex);
+		NavTriangle const& triangle = currentTile->m_graph.m_triangles[GetStreamNodeTriangle(currentNode)];
+		float currentGCost = currentRecord.m_gCost;
+
+		for (int edge = 0; edge < 3; edge++)
+		{
+			int neighborTileIndex = currentTileIndex;
+			int neighborTriangle = triangle.m_neighborIndexes[edge];
+			NavStreamTile const* neighborTile = currentTile;
+
+			// Open edges either lie on the world edge or continue in the next tile
+			if (neighborTriangle == NAV_INVALID_INDEX)
+			{
+				int globalVertexA = currentTile->m_globalVertexIndexes[triangle.m_vertexIndexes[edge]];
+				int globalVertexB = currentTile->m_globalVertexIndexes[triangle.m_vertexIndexes[(edge + 1) % 3]];
+				neighborTileIndex = GetTileIndexAcrossEdge(currentTileIndex, globalVertexA, globalVertexB);
+				if (neighborTileIndex == NAV_INVALID_INDEX) continue;
+
+				neighborTile = acquireTile(neighborTileIndex);
+				if (neighborTile == nullptr) continue;
+
+				neighborTriangle = neighborTile->FindBorderTriangle(MakeNavEdgeKey(globalVertexA, globalVertexB));
+				if (neighborTriangle == NAV_INVALID_INDEX) continue;
+			}
+
+			unsigned long long neighborNode = MakeStreamNode(neighborTileIndex, neighborTriangle);
+			Vec3 const& neighborCentroid = neighborTile->m_graph.m_triangles[neighborTriangle].m_centroid;
+			float gCost = currentGCost + GetDistance3D(triangle.m_centroid, neighborCentroid);
+
+			auto found = scratch.m_records.find(neighborNode);
+			if (found != scratch.m_records.end() && (found->second.m_isClosed || gCost >= found->second.m_gCost)) continue;
+
+			NavStreamRecord& neighborRecord = scratch.m_records[neighborNode];
+			neighborRecord.m_gCost = gCost;
+			neighborRecord.m_parentNode = currentNode;
+			neighborRecord.m_hasParent = true;
+
+			NavStreamOpenEntry entry;
+			entry.m_node = neighborNode;
+			entry.m_fCost = gCost + GetDistance3D(neighborCentroid, goalCentroid);
+			scratch.m_openHeap.emplace_back(entry);
+			std::push_heap(scratch.m_openHeap.begin(), scratch.m_openHeap.end(), IsStreamOpenEntryWorse);
+			context.m_stats.m_numPushed++;
+			context.m_stats.m_peakOpenSize = std::max(context.m_stats.m_peakOpenSize, static_cast<int>(scratch.m_openHeap.size()));
+		}
+	}
+
+	if (!isGoalReached) return isMissingTiles ? NavStreamSearchResult::PENDING_TILES : NavStreamSearchResult::NO_PATH;
+
+	for (unsigned long long node = goalNode;; node = scratch.m_records[node].m_parentNode)
+	{
+		scratch.m_corridor.emplace_back(node);
+		if (!scratch.m_records[node].m_hasParent) break;
+	}
+	std::reverse(scratch.m_corridor.begin(), scratch.m_corridor.end());
+
+	// Consecutive triangles share two global vertices whichever tiles they sit in
+	context.m_portalLefts.clear();
+	context.m_portalRights.clear();
+	context.m_portalLefts.emplace_back(startPoint);
+	context.m_portalRights.emplace_back(startPoint);
+	for (int corridorIndex = 0; corridorIndex + 1 < static_cast<int>(scratch.m_corridor.size()); corridorIndex++)
+	{
+		NavStreamTile const* fromTile = scratch.m_pinnedTiles[GetStreamNodeTile(scratch.m_corridor[corridorIndex])].get();
+		NavStreamTile const* toTile = scratch.m_pinnedTiles[GetStreamNodeTile(scratch.m_corridor[corridorIndex + 1])].get();
+		int fromTriangle = GetStreamNodeTriangle(scratch.m_corridor[corridorIndex]);
+		int toTriangle = GetStreamNodeTriangle(scratch.m_corridor[corridorIndex + 1]);
+
+		int sharedCorners[2] = { NAV_INVALID_INDEX, NAV_INVALID_INDEX };
+		int numShared = 0;
+		for (int corner = 0; corner < 3 && numShared < 2; corner++)
+		{
+			int globalVertex = fromTile->m_globalVertexIndexes[fromTile->m_graph.m_triangles[fromTriangle].m_vertexIndexes[corner]];
+			for (int otherCorner = 0; otherCorner < 3; otherCorner++)
+			{
+				if (toTile->m_globalVertexIndexes[toTile->m_graph.m_triangles[toTriangle].m_vertexIndexes[otherCorner]] == globalVertex)
+				{
+					sharedCorners[numShared++] = corner;
+					break;
+				}
+			}
+		}
+		if (numShared < 2) continue;
+
+		NavPathfinder::AddPortal(fromTile->m_graph.m_triangles[fromTriangle].m_centroid, fromTile->m_graph.GetTriangleVertex(fromTriangle, sharedCorners[0]),
+			fromTile->m_graph.GetTriangleVertex(fromTriangle, sharedCorners[1]), context);
+	}
+	context.m_portalLefts.emplace_back(goalPoint);
+	context.m_portalRights.emplace_back(goalPoint);
+	return NavStreamSearchResult::FOUND;
+}
+
+int NavTileStreamer::GetTileIndexAtPoint(Vec3 const& point) const
+{
+	NavVertexSettings const& settings = m_builder.m_settings;
+	if (m_builder.m_mappedWidth < 2 || m_builder.m_mappedHeight < 2) return NAV_INVALID_INDEX;
+
+	// Vertices sit within a cell of their grid position, so the cell under the point is close enough
+	int firstQuad = settings.m_borderSkip;
+	int quadX = static_cast<int>(floorf(point.x + (static_cast<float>(settings.m_gridWidth) / 2.f)));
+	int quadY = static_cast<int>(floorf(point.y + (static_cast<float>(settings.m_gridHeight) / 2.f)));
+	quadX = std::clamp(quadX, firstQuad, firstQuad + m_builder.m_mappedWidth - 2);
+	quadY = std::clamp(quadY, firstQuad, firstQuad + m_builder.m_mappedHeight - 2);
+	return m_builder.GetTileIndexOfQuad(quadX, quadY);
+}
+
+bool NavTileStreamer::TryGetHeight(Vec3 const& point, float& out_height) const
+{
+	int tileIndex = GetTileIndexAtPoint(point);
+	if (tileIndex == NAV_INVALID_INDEX) return false;
+
+	std::shared_ptr<NavStreamTile const> tile = GetTile(tileIndex);
+	if (tile == nullptr || tile->m_graph.IsEmpty()) return false;
+
+	int triangleIndex = tile->m_graph.FindNearestTriangle(point);
+	if (triangleIndex == NAV_INVALID_INDEX) return false;
+
+	out_height = tile->m_graph.GetHeightOnTriangle(triangleIndex, point);
+	return true;
+}
+
+Vec3 NavTileStreamer::GetRandomPoint(float zeroToOneX, float zeroToOneY, float u, float v) const
+{
+	int numQuadsX = m_builder.m_mappedWidth - 1;
+	int numQuadsY = m_builder.m_mappedHeight - 1;
+	if (numQuadsX <= 0 || numQuadsY <= 0) return Vec3::ZERO;
+
+	int firstQuad = m_builder.m_settings.m_borderSkip;
+	int quadX = firstQuad + std::min(static_cast<int>(zeroToOneX * static_cast<float>(numQuadsX)), numQuadsX - 1);
+	int quadY = firstQuad + std::min(static_cast<int>(zeroToOneY * static_cast<float>(numQuadsY)), numQuadsY - 1);
+	Vec3 bottomLeft = m_builder.ComputeVertex(quadX, quadY);
+	Vec3 bottomRight = m_builder.ComputeVertex(quadX + 1, quadY);
+	Vec3 topLeft = m_builder.ComputeVertex(quadX, quadY + 1);
+	Vec3 topRight = m_builder.ComputeVertex(quadX + 1, quadY + 1);
+
+	// Folding the upper half of the unit square picks the quad's second triangle, split the same way
+	// as NavGraph::WriteQuadTriangles
+	bool isSecondTriangle = (u + v > 1.f);
+	if (isSecondTriangle)
+	{
+		u = 1.f - u;
+		v = 1.f - v;
+	}
+
+	Vec3 a, b, c;
+	if (quadY % 2 == 0)
+	{
+		a = bottomLeft;
+		b = isSecondTriangle ? topRight : bottomRight;
+		c = isSecondTriangle ? topLeft : topRight;
+	}
+	else
+	{
+		a = isSecondTriangle ? bottomRight : bottomLeft;
+		b = isSecondTriangle ? topRight : bottomRight;
+		c = topLeft;
+	}
+	return a + ((b - a) * u) + ((c - a) * v);
+}
+
+int NavTileStreamer::GetNumResidentTiles() const
+{
+	std::lock_guard<std::mutex> lock(m_tileMutex);
+	return static_cast<int>(m_residentTiles.size());
+}
+
+size_t NavTileStreamer::GetResidentBytes() const
+{
+	std::lock_guard<std::mutex> lock(m_tileMutex);
+	return m_residentBytes;
+}
+
+void NavTileStreamer::BuildTile(int tileIndex, NavStreamTile& out_tile) const
+{
+	out_tile.m_tileIndex = tileIndex;
+
+	int minX, minY, maxX, maxY;
+	m_builder.GetTileQuadBounds(tileIndex, minX, minY, maxX, maxY);
+	int numQuadsX = maxX - minX;
+	int numQuadsY = maxY - minY;
+	if (numQuadsX <= 0 || numQuadsY <= 0) return;
+
+	// The tile owns its quads plus the shared vertex row and column on its far edges
+	int numVerticesX = numQuadsX + 1;
+	int numVerticesY = numQuadsY + 1;
+	NavGraph& graph = out_tile.m_graph;
+	graph.m_vertices.resize(static_cast<size_t>(numVerticesX) * static_cast<size_t>(numVerticesY));
+	out_tile.m_globalVertexIndexes.resize(graph.m_vertices.size());
+	for (int y = minY; y <= maxY; y++)
+	{
+		for (int x = minX; x <= maxX; x++)
+		{
+			int localVertex = ((y - minY) * numVerticesX) + (x - minX);
+			graph.m_vertices[localVertex] = m_builder.ComputeVertex(x, y);
+			out_tile.m_globalVertexIndexes[localVertex] = m_builder.GetVertexIndex(x, y);
+		}
+	}
+
+	graph.m_triangles.resize(static_cast<size_t>(numQuadsX) * static_cast<size_t>(numQuadsY) * 2);
+	int triangleIndex = 0;
+	for (int y = minY; y < maxY; y++)
+	{
+		for (int x = minX; x < maxX; x++)
+		{
+			int bottomLeft = ((y - minY) * numVerticesX) + (x - minX);
+			int topLeft = bottomLeft + numVerticesX;
+			graph.WriteQuadTriangles(triangleIndex, y, bottomLeft, bottomLeft + 1, topLeft, topLeft + 1);
+			triangleIndex += 2;
+		}
+	}
+	graph.LinkEdges(0, graph.GetNumTriangles(), false);
+	graph.BuildPointGrid();
+	graph.m_version++;
+
+	for (int triangle = 0; triangle < graph.GetNumTriangles(); triangle++)
+	{
+		for (int edge = 0; edge < 3; edge++)
+		{
+			if (graph.m_triangles[triangle].m_neighborIndexes[edge] != NAV_INVALID_INDEX) continue;
+
+			NavBorderEdge borderEdge;
+			borderEdge.m_edgeKey = MakeNavEdgeKey(out_tile.m_globalVertexIndexes[graph.m_triangles[triangle].m_vertexIndexes[edge]],
+				out_tile.m_globalVertexIndexes[graph.m_triangles[triangle].m_vertexIndexes[(edge + 1) % 3]]);
+			borderEdge.m_triangleIndex = triangle;
+			out_tile.m_borderEdges.emplace_back(borderEdge);
+		}
+	}
+	std::sort(out_tile.m_borderEdges.begin(), out_tile.m_borderEdges.end(),
+		[](NavBorderEdge const& a, NavBorderEdge const& b) { return a.m_edgeKey < b.m_edgeKey; });
+}
+
+void NavTileStreamer::InstallTile(std::shared_ptr<NavStreamTile> const& tile)
+{
+	std::lock_guard<std::mutex> lock(m_tileMutex);
+	m_tiles[tile->m_tileIndex] = tile;
+	m_tileStates[tile->m_tileIndex] = NavStreamTileState::READY;
+	m_residentTiles.emplace_back(tile->m_tileIndex);
+	m_residentBytes += tile->GetMemoryBytes();
+}
+
+void NavTileStreamer::QueueTileBuild(int tileIndex)
+{
+	m_numPendingTileJobs++;
+	QueueGameJob(new NavStreamTileJob(*this, tileIndex, m_numPendingTileJobs));
+}
+
+void NavTileStreamer::EvictOverBudget()
+{
+	// Least recently needed first, anything needed this frame stays even over budget
+	while (m_residentBytes > m_memoryBudgetBytes)
+	{
+		int evictSlot = NAV_INVALID_INDEX;
+		for (int residentSlot = 0; residentSlot < static_cast<int>(m_residentTiles.size()); residentSlot++)
+		{
+			int tileIndex = m_residentTiles[residentSlot];
+			if (m_tileLastNeededFrames[tileIndex] >= m_frameNumber) continue;
+			if (evictSlot == NAV_INVALID_INDEX || m_tileLastNeededFrames[tileIndex] < m_tileLastNeededFrames[m_residentTiles[evictSlot]])
+			{
+				evictSlot = residentSlot;
+			}
+		}
+		if (evictSlot == NAV_INVALID_INDEX) break;
+
+		int tileIndex = m_residentTiles[evictSlot];
+		m_residentBytes -= m_tiles[tileIndex]->GetMemoryBytes();
+		m_tiles[tileIndex].reset();
+		m_tileStates[tileIndex] = NavStreamTileState::UNLOADED;
+		m_residentTiles[evictSlot] = m_residentTiles.back();
+		m_residentTiles.pop_back();
+	}
+}
+
+int NavTileStreamer::GetTileIndexAcrossEdge(int tileIndex, int globalVertexA, int globalVertexB) const
+{
+	// Open edges are always a quad's horizontal or vertical side, diagonals stay inside their quad
+	int mappedWidth = m_builder.m_mappedWidth;
+	int borderSkip = m_builder.m_settings.m_borderSkip;
+	int vertexAX = (globalVertexA % mappedWidth) + borderSkip;
+	int vertexAY = (globalVertexA / mappedWidth) + borderSkip;
+	int vertexBX = (globalVertexB % mappedWidth) + borderSkip;
+	int vertexBY = (globalVertexB / mappedWidth) + borderSkip;
+
+	int firstTile = NAV_INVALID_INDEX;
+	int secondTile = NAV_INVALID_INDEX;
+	if (vertexAY == vertexBY)
+	{
+		int quadX = std::min(vertexAX, vertexBX);
+		firstTile = m_builder.GetTileIndexOfQuad(quadX, vertexAY - 1);
+		secondTile = m_builder.GetTileIndexOfQuad(quadX, vertexAY);
+	}
+	else if (vertexAX == vertexBX)
+	{
+		int quadY = std::min(vertexAY, vertexBY);
+		firstTile = m_builder.GetTileIndexOfQuad(vertexAX - 1, quadY);
+		secondTile = m_builder.GetTileIndexOfQuad(vertexAX, quadY);
+	}
+
+	if (firstTile == tileIndex) return secondTile;
+	if (secondTile == tileIndex) return firstTile;
+	return NAV_INVALID_INDEX;
+}
+
+void NavStreamTileJob::ExecuteGameJob()
+{
+	PROFILE_ZONE("NavStreamTileJob");
+	std::shared_ptr<NavStreamTile> tile = std::make_shared<NavStreamTile>();
+	m_streamer.BuildTile(m_tileIndex, *tile);
+	m_streamer.InstallTile(tile);
+	m_numPendingJobs--;
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include "Game/Navigation/NavGraph.hpp"
+#include "Game/Navigation/NavTileBuilder.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class NavSearchContext;
+
+constexpr int NAV_STREAMING_RADIUS_TILES = 2;
+constexpr int NAV_STREAMING_MAX_SEARCH_NODES = 200000;
+
+//------------------------------------------------------------------------------------------------
+// An edge left open inside a streamed tile, keyed by the sorted global vertex pair so the tile on
+// the other side can be matched without either tile knowing about the other.
+struct NavBorderEdge
+{
+	unsigned long long m_edgeKey = 0;
+	int m_triangleIndex = NAV_INVALID_INDEX;
+};
+
+//------------------------------------------------------------------------------------------------
+// One NAV_TILE_SIZE tile with its own tile local graph. Immutable once built, searches hold it by
+// shared_ptr so eviction never pulls it out from under a worker.
+struct NavStreamTile
+{
+	int m_tileIndex = NAV_INVALID_INDEX;
+	NavGraph m_graph;
+	std::vector<int> m_globalVertexIndexes;
+	std::vector<NavBorderEdge> m_borderEdges; // Sorted by key
+
+	int FindBorderTriangle(unsigned long long edgeKey) const;
+	size_t GetMemoryBytes() const;
+};
+
+enum class NavStreamTileState
+{
+	UNLOADED,
+	BUILDING,
+	READY
+};
+
+enum class NavStreamSearchResult
+{
+	FOUND,
+	NO_PATH,
+	PENDING_TILES
+};
+
+//------------------------------------------------------------------------------------------------
+// Keeps only the nav tiles around the interest points (agents and camera) resident. Missing tiles
+// are built on the JobSystem, and once the resident set is over budget the least recently needed
+// tiles are evicted. Searches that run into a missing tile request it and report PENDING_TILES so
+// the caller can retry once it has streamed in.
+class NavTileStreamer
+{
+public:
+	NavTileStreamer(NavVertexSettings const& settings, std::vector<float> const& heightMap, size_t memoryBudgetBytes);
+	~NavTileStreamer();
+
+	// Main thread, once per frame
+	void Update(std::vector<Vec3> const& interestPoints);
+
+	// Any thread
+	std::shared_ptr<NavStreamTile const> GetTile(int tileIndex) const;
+	void RequestTile(int tileIndex);
+	NavStreamSearchResult FindPortals(Vec3 const& startPoint, Vec3 const& goalPoint, NavSearchContext& context);
+
+	int GetTileIndexAtPoint(Vec3 const& point) const;
+	bool TryGetHeight(Vec3 const& point, float& out_height) const; // False until the tile under the point is resident
+	int GetNumResidentTiles() const;
+
+	// A uniform point in a uniform quad of the walkable grid. Computed from the heightmap, so it
+	// needs no resident tile and works for spawns and goals anywhere on the map.
+	Vec3 GetRandomPoint(float zeroToOneX, float zeroToOneY, float u, float v) const;
+	size_t GetResidentBytes() const;
+
+	void BuildTile(int tileIndex, NavStreamTile& out_tile) const;
+	void InstallTile(std::shared_ptr<NavStreamTile> const& tile);
+
+private:
+	void QueueTileBuild(int tileIndex);
+	void EvictOverBudget();
+	int GetTileIndexAcrossEdge(int tileIndex, int globalVertexA, int globalVertexB) const;
+
+public:
+	NavTileBuilder m_builder;
+	size_t m_memoryBudgetBytes = 0;
+
+private:
+	mutable std::mutex m_tileMutex;
+	std::vector<std::shared_ptr<NavStreamTile const>> m_tiles;
+	std::vector<NavStreamTileState> m_tileStates;
+	std::vector<int> m_tileLastNeededFrames;
+	std::vector<int> m_residentTiles;
+	std::vector<int> m_requestedTiles;
+	size_t m_residentBytes = 0;
+	int m_frameNumber = 0;
+
+	std::atomic<int> m_numPendingTileJobs{ 0 };
+};
+
+//------------------------------------------------------------------------------------------------
+class NavStreamTileJob : public GameJob
+{
+public:
+	NavStreamTileJob(NavTileStreamer& streamer, int tileIndex, std::atomic<int>& numPendingJobs)
+		: GameJob(GameJobType::NAV_TILE_BUILD), m_streamer(streamer), m_tileIndex(tileIndex), m_numPendingJobs(numPendingJobs) {}
+
+	virtual void ExecuteGameJob() override;
+
+public:
+	NavTileStreamer& m_streamer;
+	int m_tileIndex = 0;
+	std::atomic<int>& m_numPendingJobs;
+};
@@ -1,4 +1,5 @@
 #include "Game/PlayGround.hpp"
+#include "Game/Diagnostics/Profiler.hpp"
 #include "Engine/Renderer/DebugRenderer.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/Shader.hpp"
@@ -23,8 +24,11 @@
 PlayGround::PlayGround(Game* owner, const std::vector<PlayGroundSpawnInfo>& spawnInfos)
 	: m_game(owner), m_maxNumAgents(static_cast<int>(spawnInfos.size()))
 {
-	LoadModel();
-	LoadGrid();
+	if (!m_game->m_gameModeConfig.m_isHeadless)
+	{
+		LoadModel();
+		LoadGrid();
+	}
 	PopulatePlayGroundWithActors(spawnInfos);
 }
 
@@ -52,6 +56,7 @@ void PlayGround::LoadGrid()
 
 void PlayGround::Render() const
 {
+	PROFILE_ZONE("PlayGround::Render");
 	RenderPlayGround();
 	RenderActors();
 }
@@ -66,16 +71,13 @@ void PlayGround::RenderPlayGround() const
 
 void PlayGround::RenderActors() const
 {
-	if (!m_agentActors.empty())
+	for (Actor* agent : m_agentActors.GetSlots())
 	{
-		for (int index = 0; index < m_agentActors.size(); index++)
+		if (agent == nullptr)
 		{
-			if (m_agentActors[index] == nullptr)
-			{
-				continue;
-			}
-			m_agentActors[index]->Render();
+			continue;
 		}
+		agent->Render();
 	}
 }
 
@@ -89,81 +91,73 @@ void PlayGround::PopulatePlayGroundWithActors(const std::vector<PlayGroundSpawnI
 
 void PlayGround::PlayGroundUpdate()
 {
+	PROFILE_ZONE("PlayGround::PlayGroundUpdate");
+	m_jobCompletionDispatcher.DispatchCompletedJobs(m_agentActors);
 	UpdateActors();
 }
 
 void PlayGround::UpdateActors()
 {
-	if (!m_agentActors.empty())
+	if (!m_agentActors.IsEmpty())
 	{
-		for (int index = 0; index < m_agentActors.size(); index++)
+		std::vector<Actor*> const& agentSlots = m_agentActors.GetSlots();
+
+		// Neighbor queries read from the hash and the state store snapshot, so both are rebuilt once before anyone moves this frame
+		for (Actor* agent : agentSlots)
+		{
+			if (agent == nullptr) continue;
+			agent->UpdateSearchRadius();
+		}
+		m_agentStates.TakeSnapshot();
+		m_agentSpatialHash.Rebuild(m_agentStates);
+
+		if (m_game->m_gameModeConfig.m_useParallelAgentUpdate)
 		{
-			if (m_agentActors[index] == nullptr)
+			m_agentParallelUpdater.UpdateAgents(agentSlots);
+			return;
+		}
+
+		for (int index = 0; index < static_cast<int>(agentSlots.size()); index++)
+		{
+			if (agentSlots[index] == nullptr)
 			{
 				continue;
 			}
-			m_agentActors[index]->Update();
+			agentSlots[index]->Update();
 		}
 	}
 }
 
-std::vector<Actor*> PlayGround::GetAllAgents() const
+std::vector<Actor*> const& PlayGround::GetAllAgents() const
 {
-	return m_agentActors;
-}
-
-ActorUID PlayGround::GenerateActorUID(int actorIndex)
-{
-	ActorUID uid = ActorUID(m_actorSalt++, actorIndex);
-	return uid;
+	return m_agentActors.GetSlots();
 }
 
 Actor* PlayGround::SpawnActor(const PlayGroundSpawnInfo& spawnInfo)
 {
 	static int actorCounter = 0;
 
-	for (int i = 0; i < m_agentActors.size(); i++)
-	{
-		if (m_agentActors[i] == nullptr)
-		{
-			ActorUID uid = GenerateActorUID(i);
-
-			Actor* newActor = new Actor(this, m_game, spawnInfo, uid);
-
-			newActor->m_uniqueName = Stringf("%s%i", newActor->m_actorDef->m_name.c_str(), actorCounter++);
-
-			m_agentActors[i] = newActor;
-			return newActor;
-		}
-	}
-
-	int index = static_cast<int>(m_agentActors.size());
-	ActorUID uid = GenerateActorUID(index);
+	ActorUID uid = m_agentActors.AllocateUID();
 
 	Actor* newActor = new Actor(this, m_game, spawnInfo, uid);
 
 	newActor->m_uniqueName = Stringf("%s%i", newActor->m_actorDef->m_name.c_str(), actorCounter++);
 
-	m_agentActors.emplace_back(newActor);
+	m_agentActors.AssignActor(uid, newActor);
 
 	return newActor;
 }
 
 Actor* PlayGround::GetActorByUID(const ActorUID uid) const
 {
-	for (Actor* actor : m_agentActors)
-	{
-		if (actor && actor->GetUID() == uid)
-		{
-			return actor;
-		}
-	}
-	return nullptr;
+	return m_agentActors.GetActor(uid);
 }
 
 void PlayGround::PlayGroundShutDown()
 {
-	SafeDelete(m_agentActors);
+	m_jobCompletionDispatcher.DispatchCompletedJobs(m_agentActors);
+	m_agentActors.DeleteAllActors();
+	m_agentStates.Clear();
 	SafeDelete(m_playGroundModel);
 	SafeDelete(m_gridProp);
 }
@@ -6,6 +6,11 @@
 #include "Engine/Renderer/Material.hpp"
 #include "Engine/Utilities/Model.hpp"
 #include "Engine/Utilities/Prop.hpp"
+#include "Game/ActorSlotMap.hpp"
+#include "Game/AgentSpatialHash.hpp"
+#include "Game/AgentStateStore.hpp"
+#include "Game/AgentParallelUpdater.hpp"
+#include "Game/JobCompletionDispatcher.hpp"
 #include <vector>
 #include <string>
 
@@ -13,7 +18,6 @@ class Controller;
 class Game;
 class PlayerActor;
 class Actor;
-struct ActorUID;
 
 struct PlayGroundTempActorInfo
 {
@@ -46,8 +50,7 @@ public:
 	void PlayGroundUpdate();
 	void UpdateActors();
 
-	std::vector<Actor*> GetAllAgents() const;
-	ActorUID GenerateActorUID(int actorIndex);
+	std::vector<Actor*> const& GetAllAgents() const;
 	Actor* SpawnActor(const PlayGroundSpawnInfo& spawnInfo);
 	Actor* GetActorByUID(const ActorUID uid) const;
 
@@ -57,6 +60,8 @@ public:
 	Game* m_game = nullptr;
 	Model* m_playGroundModel = nullptr;
 	Prop* m_gridProp = nullptr;
+	AgentSpatialHash m_agentSpatialHash;
+	AgentStateStore m_agentStates;
 
 public:
 	//Vec3 m_sunDirection = Vec3(0.f, 0.f, -1000.f);
@@ -70,11 +75,11 @@ public:
 	float m_maxFallOffMultiplier = 1.f;
 
 private:
-	std::vector<Actor*> m_agentActors;
+	ActorSlotMap m_agentActors;
+	AgentParallelUpdater m_agentParallelUpdater;
+	JobCompletionDispatcher m_jobCompletionDispatcher;
 	int m_maxNumAgents = 0;
 	int m_agentID = 0;
-	static const unsigned int MAX_ACTOR_SALT = 0x0000fffeu;
-	unsigned int m_actorSalt = MAX_ACTOR_SALT;
 
 	float m_maxDistance = 22.f;
 };
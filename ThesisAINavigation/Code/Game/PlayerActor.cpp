@@ -116,6 +116,11 @@ void PlayerActor::DebugKeys()
 		m_game->m_clock->StepSingleFrame();
 	}
 
+	if (g_theInput->WasKeyJustPressed('B') && m_game->m_map != nullptr)
+	{
+		m_game->m_map->ToggleNavObstacle(m_position);
+	}
+
 	if (!g_theConsole->IsOpen() && g_theInput->WasKeyJustPressed(KEYCODE_ESC))
 	{
 		g_theApp->HandleQuitRequested();
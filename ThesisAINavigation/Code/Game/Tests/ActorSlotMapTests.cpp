@@ -0,0 +1,70 @@
+#include "Game/Tests/SelfTests.hpp"
+#include "Game/ActorSlotMap.hpp"
+#include <vector>
+
+void SelfTests::RunActorSlotMapTests(SelfTestContext& context)
+{
+	// The slot map only stores the pointers, so stand-ins are enough as long as DeleteAllActors is never called
+	char actorStandIns[4] = {};
+	Actor* actorA = reinterpret_cast<Actor*>(&actorStandIns[0]);
+	Actor* actorB = reinterpret_cast<Actor*>(&actorStandIns[1]);
+	Actor* actorC = reinterpret_cast<Actor*>(&actorStandIns[2]);
+	Actor* actorD = reinterpret_cast<Actor*>(&actorStandIns[3]);
+
+	ActorSlotMap slotMap;
+	ActorUID uidA = slotMap.AllocateUID();
+	slotMap.AssignActor(uidA, actorA);
+	ActorUID uidB = slotMap.AllocateUID();
+	slotMap.AssignActor(uidB, actorB);
+	SELF_TEST_CHECK(context, uidA.GetIndex() == 0 && uidB.GetIndex() == 1);
+	SELF_TEST_CHECK(context, slotMap.GetActor(uidA) == actorA && slotMap.GetActor(uidB) == actorB);
+	SELF_TEST_CHECK(context, slotMap.GetNumActors() == 2);
+	SELF_TEST_CHECK(context, slotMap.GetActor(ActorUID::INVALID) == nullptr);
+
+	// An allocated but unassigned UID does not resolve yet
+	ActorUID uidC = slotMap.AllocateUID();
+	SELF_TEST_CHECK(context, !slotMap.IsValid(uidC));
+	slotMap.AssignActor(uidC, actorC);
+	SELF_TEST_CHECK(context, slotMap.GetActor(uidC) == actorC);
+
+	// Removing hands the actor back once, then the UID is stale
+	SELF_TEST_CHECK(context, slotMap.RemoveActor(uidB) == actorB);
+	SELF_TEST_CHECK(context, slotMap.RemoveActor(uidB) == nullptr);
+	SELF_TEST_CHECK(context, slotMap.GetActor(uidB) == nullptr);
+	SELF_TEST_CHECK(context, slotMap.GetNumActors() == 2);
+	SELF_TEST_CHECK(context, slotMap.GetSlots()[1] == nullptr);
+
+	// The freed slot is reused with the next salt, so the old UID keeps missing after the slot fills again
+	ActorUID uidD = slotMap.AllocateUID();
+	slotMap.AssignActor(uidD, actorD);
+	SELF_TEST_CHECK(context, uidD.GetIndex() == uidB.GetIndex());
+	SELF_TEST_CHECK(context, uidD.GetSalt() == uidB.GetSalt() + 1);
+	SELF_TEST_CHECK(context, uidD != uidB);
+	SELF_TEST_CHECK(context, slotMap.GetActor(uidD) == actorD);
+	SELF_TEST_CHECK(context, slotMap.GetActor(uidB) == nullptr);
+	SELF_TEST_CHECK(context, slotMap.RemoveActor(uidB) == nullptr && slotMap.GetActor(uidD) == actorD);
+	SELF_TEST_CHECK(context, slotMap.GetNumSlots() == 3);
+
+	// One slot cycled through every salt wraps back to zero
+	ActorUID cycledUID = uidA;
+	SELF_TEST_CHECK(context, slotMap.RemoveActor(cycledUID) == actorA);
+	for (unsigned int cycle = 0; cycle < ActorSlotMap::MAX_ACTOR_SALT; cycle++)
+	{
+		cycledUID = slotMap.AllocateUID();
+		slotMap.AssignActor(cycledUID, actorA);
+		slotMap.RemoveActor(cycledUID);
+	}
+	SELF_TEST_CHECK(context, cycledUID.GetIndex() == 0 && cycledUID.GetSalt() == ActorSlotMap::MAX_ACTOR_SALT);
+	ActorUID wrappedUID = slotMap.AllocateUID();
+	SELF_TEST_CHECK(context, wrappedUID.GetIndex() == 0 && wrappedUID.GetSalt() == 0);
+	slotMap.AssignActor(wrappedUID, actorA);
+	SELF_TEST_CHECK(context, wrappedUID.IsValid() && slotMap.GetActor(wrappedUID) == actorA);
+	SELF_TEST_CHECK(context, slotMap.GetNumActors() == 3);
+
+	std::vector<ActorUID> const liveUIDs = { wrappedUID, uidC, uidD };
+	for (ActorUID uid : liveUIDs)
+	{
+		slotMap.RemoveActor(uid);
+	}
+	SELF_TEST_CHECK(context, slotMap.IsEmpty());
+}
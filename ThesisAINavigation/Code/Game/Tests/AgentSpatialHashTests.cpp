@@ -0,0 +1,81 @@
+#include "Game/Tests/SelfTests.hpp"
+#include "Game/AgentSpatialHash.hpp"
+#include "Game/AgentStateStore.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+static std::vector<int> GetSelfTestAgentsInRadius(AgentStateStore const& agentStates, Vec3 const& position, float radius, int slotToIgnore)
+{
+	std::vector<int> agentSlots;
+	for (int slotIndex = 0; slotIndex < agentStates.GetNumSlots(); slotIndex++)
+	{
+		if (slotIndex == slotToIgnore || !agentStates.IsActive(slotIndex)) continue;
+		if (GetDistanceSquared3D(position, agentStates.m_snapshotPositions[slotIndex]) <= radius * radius)
+		{
+			agentSlots.emplace_back(slotIndex);
+		}
+	}
+	return agentSlots;
+}
+
+void SelfTests::RunAgentSpatialHashTests(SelfTestContext& context)
+{
+	// A fixed scatter over negative and positive cells, dense enough that buckets collide
+	AgentStateStore agentStates;
+	int const numAgents = 600;
+	for (int slotIndex = 0; slotIndex < numAgents; slotIndex++)
+	{
+		float x = fmodf(static_cast<float>(slotIndex) * 7.31f, 60.f) - 30.f;
+		float y = fmodf(static_cast<float>(slotIndex) * 3.17f, 40.f) - 20.f;
+		agentStates.AddAgent(slotIndex, Vec3(x, y, 0.f), EulerAngles::ZERO, 0.5f, 1.f, 1.f);
+		agentStates.m_searchRadii[slotIndex] = 1.f + static_cast<float>(slotIndex % 3);
+	}
+	agentStates.ClearSlot(11);
+	agentStates.TakeSnapshot();
+
+	AgentSpatialHash spatialHash;
+	spatialHash.Rebuild(agentStates);
+	SELF_TEST_CHECK(context, spatialHash.GetCellSize() == 3.f);
+	SELF_TEST_CHECK(context, spatialHash.GetNumAgents() == numAgents - 1);
+
+	// Every query has to return exactly what a brute force scan does, inactive and ignored slots left out
+	int numMismatches = 0;
+	for (int slotIndex = 0; slotIndex < numAgents; slotIndex++)
+	{
+		float radius = agentStates.m_searchRadii[slotIndex];
+		std::vector<int> agentSlots;
+		spatialHash.GetAgentsInRadius(agentStates.m_snapshotPositions[slotIndex], radius, agentSlots, slotIndex);
+		std::sort(agentSlots.begin(), agentSlots.end());
+		if (agentSlots != GetSelfTestAgentsInRadius(agentStates, agentStates.m_snapshotPositions[slotIndex], radius, slotIndex))
+		{
+			numMismatches++;
+		}
+	}
+	SELF_TEST_CHECK(context, numMismatches == 0);
+
+	// The radius is inclusive, and a query wider than a cell still finds everything
+	AgentStateStore pairStates;
+	pairStates.AddAgent(0, Vec3(-0.5f, -0.5f, 0.f), EulerAngles::ZERO, 0.5f, 1.f, 1.f);
+	pairStates.AddAgent(1, Vec3(1.5f, -0.5f, 0.f), EulerAngles::ZERO, 0.5f, 1.f, 1.f);
+	pairStates.AddAgent(2, Vec3(9.5f, 9.5f, 0.f), EulerAngles::ZERO, 0.5f, 1.f, 1.f);
+	pairStates.m_searchRadii[0] = 1.f;
+	spatialHash.Rebuild(pairStates);
+
+	std::vector<int> agentSlots;
+	spatialHash.GetAgentsInRadius(Vec3(-0.5f, -0.5f, 0.f), 2.f, agentSlots, 0);
+	SELF_TEST_CHECK(context, agentSlots == std::vector<int>({ 1 }));
+
+	agentSlots.clear();
+	spatialHash.GetAgentsInRadius(Vec3::ZERO, 20.f, agentSlots);
+	std::sort(agentSlots.begin(), agentSlots.end());
+	SELF_TEST_CHECK(context, agentSlots == std::vector<int>({ 0, 1, 2 }));
+
+	// An agent despawned after the rebuild drops out of queries right away
+	pairStates.ClearSlot(1);
+	agentSlots.clear();
+	spatialHash.GetAgentsInRadius(Vec3(-0.5f, -0.5f, 0.f), 2.f, agentSlots, 0);
+	SELF_TEST_CHECK(context, agentSlots.empty());
+}
@@ -0,0 +1,83 @@
+#include "Game/Tests/SelfTests.hpp"
+#include "Game/Diagnostics/FrameTimeHistogram.hpp"
+
+void SelfTests::RunFrameTimeHistogramTests(SelfTestContext& context)
+{
+	// Below the linear limit every microsecond is its own bucket
+	for (unsigned long long microseconds = 0; microseconds < FRAME_TIME_LINEAR_BUCKETS; microseconds++)
+	{
+		int bucketIndex = FrameTimeHistogram::GetBucketIndex(microseconds);
+		SELF_TEST_CHECK(context, bucketIndex == static_cast<int>(microseconds));
+		SELF_TEST_CHECK(context, FrameTimeHistogram::GetBucketUpperMicroseconds(bucketIndex) == microseconds);
+	}
+
+	// Above it, the bucket's upper edge covers the value, stays within ~3% of it, and the previous bucket ends below it
+	bool isEveryUpperEdgeClose = true;
+	bool isEveryBucketOrdered = true;
+	for (unsigned long long microseconds = FRAME_TIME_LINEAR_BUCKETS; microseconds < 100000000ull; microseconds += 1 + (microseconds / 97))
+	{
+		int bucketIndex = FrameTimeHistogram::GetBucketIndex(microseconds);
+		unsigned long long upperMicroseconds = FrameTimeHistogram::GetBucketUpperMicroseconds(bucketIndex);
+		if (upperMicroseconds < microseconds || static_cast<double>(upperMicroseconds - microseconds) > 0.032 * static_cast<double>(microseconds))
+		{
+			isEveryUpperEdgeClose = false;
+		}
+		if (FrameTimeHistogram::GetBucketUpperMicroseconds(bucketIndex - 1) >= microseconds)
+		{
+			isEveryBucketOrdered = false;
+		}
+	}
+	SELF_TEST_CHECK(context, isEveryUpperEdgeClose);
+	SELF_TEST_CHECK(context, isEveryBucketOrdered);
+	SELF_TEST_CHECK(context, FrameTimeHistogram::GetBucketIndex(~0ull) == FRAME_TIME_NUM_BUCKETS - 1);
+	SELF_TEST_CHECK(context, FrameTimeHistogram::GetBucketIndex(64) == FRAME_TIME_LINEAR_BUCKETS);
+	SELF_TEST_CHECK(context, FrameTimeHistogram::GetBucketUpperMicroseconds(FRAME_TIME_LINEAR_BUCKETS) == 65);
+
+	// Percentiles report the upper edge of the bucket holding the rank, counting from 1
+	FrameTimeHistogram histogram;
+	SELF_TEST_CHECK(context, histogram.GetPercentileValue(50.0) == 0);
+	SELF_TEST_CHECK(context, histogram.GetMaxValue() == 0);
+	SELF_TEST_CHECK(context, histogram.GetMeanValue() == 0.0);
+
+	for (unsigned long long value = 1; value <= 100; value++)
+	{
+		histogram.RecordValue(value);
+	}
+	SELF_TEST_CHECK(context, histogram.GetCount() == 100);
+	SELF_TEST_CHECK(context, histogram.GetPercentileValue(0.0) == 1);
+	SELF_TEST_CHECK(context, histogram.GetPercentileValue(50.0) == 50);
+	SELF_TEST_CHECK(context, histogram.GetPercentileValue(99.0) == 99);
+	SELF_TEST_CHECK(context, histogram.GetPercentileValue(100.0) == 101); // 100 shares the [100, 101] bucket
+	SELF_TEST_CHECK(context, histogram.GetMaxValue() == 101);
+	SELF_TEST_CHECK(context, histogram.GetMeanValue() > 50.49 && histogram.GetMeanValue() < 50.51);
+
+	// Seconds are rounded to the nearest microsecond
+	FrameTimeHistogram secondsHistogram;
+	secondsHistogram.Record(0.0000104);
+	secondsHistogram.Record(0.0000196);
+	secondsHistogram.Record(-1.0);
+	SELF_TEST_CHECK(context, secondsHistogram.m_bucketCounts[10] == 1);
+	SELF_TEST_CHECK(context, secondsHistogram.m_bucketCounts[20] == 1);
+	SELF_TEST_CHECK(context, secondsHistogram.m_bucketCounts[0] == 1);
+
+	// Adding and then subtracting a histogram gives back the original buckets
+	FrameTimeHistogram combined = histogram;
+	combined.Add(secondsHistogram);
+	SELF_TEST_CHECK(context, combined.GetCount() == 103);
+	SELF_TEST_CHECK(context, combined.GetPercentileValue(1.0) == 0);
+	combined.Subtract(secondsHistogram);
+	SELF_TEST_CHECK(context, combined.GetCount() == histogram.GetCount());
+	SELF_TEST_CHECK(context, combined.m_bucketCounts == histogram.m_bucketCounts);
+
+	// The tracker's run histogram sees every frame, the 1 s window only the recent ones
+	FrameTimeTracker tracker;
+	for (int frameIndex = 0; frameIndex < 600; frameIndex++)
+	{
+		tracker.RecordFrame((frameIndex == 299) ? 0.1 : 0.01);
+	}
+	SELF_TEST_CHECK(context, tracker.GetRun().GetCount() == 600);
+	SELF_TEST_CHECK(context, tracker.GetRunMaxSeconds() == 0.1);
+	SELF_TEST_CHECK(context, tracker.GetWindow(0).GetCount() < tracker.GetWindow(1).GetCount());
+	SELF_TEST_CHECK(context, tracker.GetWindow(1).GetCount() <= 600);
+	SELF_TEST_CHECK(context, tracker.GetRun().GetPercentileValue(50.0) == FrameTimeHistogram::GetBucketUpperMicroseconds(FrameTimeHistogram::GetBucketIndex(10000)));
+}
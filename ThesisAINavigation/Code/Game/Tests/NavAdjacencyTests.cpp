@@ -0,0 +1,104 @@
+#include "Game/Tests/SelfTests.hpp"
+#include "Game/Navigation/NavBenchmark.hpp"
+#include "Game/Navigation/NavGraph.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include <map>
+#include <vector>
+
+// Every triangle that touches each undirected edge, the slow and obvious way
+static std::map<unsigned long long, std::vector<int>> GetSelfTestEdgeTriangles(NavGraph const& navGraph)
+{
+	std::map<unsigned long long, std::vector<int>> edgeTriangles;
+	for (int triangleIndex = 0; triangleIndex < navGraph.GetNumTriangles(); triangleIndex++)
+	{
+		NavTriangle const& triangle = navGraph.m_triangles[triangleIndex];
+		for (int edge = 0; edge < 3; edge++)
+		{
+			edgeTriangles[MakeNavEdgeKey(triangle.m_vertexIndexes[edge], triangle.m_vertexIndexes[(edge + 1) % 3])].emplace_back(triangleIndex);
+		}
+	}
+	return edgeTriangles;
+}
+
+static void ResetSelfTestNeighbors(NavGraph& navGraph)
+{
+	for (NavTriangle& triangle : navGraph.m_triangles)
+	{
+		for (int edge = 0; edge < 3; edge++)
+		{
+			triangle.m_neighborIndexes[edge] = NAV_INVALID_INDEX;
+		}
+	}
+}
+
+static bool HasSameNeighbors(NavGraph const& navGraphA, NavGraph const& navGraphB)
+{
+	for (int triangleIndex = 0; triangleIndex < navGraphA.GetNumTriangles(); triangleIndex++)
+	{
+		for (int edge = 0; edge < 3; edge++)
+		{
+			if (navGraphA.m_triangles[triangleIndex].m_neighborIndexes[edge] != navGraphB.m_triangles[triangleIndex].m_neighborIndexes[edge]) return false;
+		}
+	}
+	return true;
+}
+
+void SelfTests::RunNavAdjacencyTests(SelfTestContext& context)
+{
+	NavGraph navGraph;
+	NavBenchmark::BuildGridGraph(IntVec2(40, 30), 3, navGraph);
+	std::map<unsigned long long, std::vector<int>> edgeTriangles = GetSelfTestEdgeTriangles(navGraph);
+
+	// Each edge links the other triangle on it, both ways, and only the grid's outline stays open
+	int numWrongNeighbors = 0;
+	int numOpenEdges = 0;
+	for (int triangleIndex = 0; triangleIndex < navGraph.GetNumTriangles(); triangleIndex++)
+	{
+		NavTriangle const& triangle = navGraph.m_triangles[triangleIndex];
+		for (int edge = 0; edge < 3; edge++)
+		{
+			std::vector<int> const& sharing = edgeTriangles[MakeNavEdgeKey(triangle.m_vertexIndexes[edge], triangle.m_vertexIndexes[(edge + 1) % 3])];
+			int expectedNeighbor = (sharing.size() == 2) ? ((sharing[0] == triangleIndex) ? sharing[1] : sharing[0]) : NAV_INVALID_INDEX;
+			int neighbor = triangle.m_neighborIndexes[edge];
+			if (neighbor != expectedNeighbor) numWrongNeighbors++;
+			if (neighbor == NAV_INVALID_INDEX)
+			{
+				numOpenEdges++;
+				continue;
+			}
+
+			NavTriangle const& neighborTriangle = navGraph.m_triangles[neighbor];
+			bool isLinkedBack = neighborTriangle.m_neighborIndexes[0] == triangleIndex || neighborTriangle.m_neighborIndexes[1] == triangleIndex || neighborTriangle.m_neighborIndexes[2] == triangleIndex;
+			if (!isLinkedBack) numWrongNeighbors++;
+		}
+	}
+	SELF_TEST_CHECK(context, numWrongNeighbors == 0);
+	SELF_TEST_CHECK(context, numOpenEdges == 2 * ((40 - 1) + (30 - 1)));
+
+	// Linking two halves on their own and stitching the open edges gives the same graph as one pass
+	NavGraph stitchedGraph = navGraph;
+	ResetSelfTestNeighbors(stitchedGraph);
+	int halfTriangles = stitchedGraph.GetNumTriangles() / 2;
+	stitchedGraph.LinkEdges(0, halfTriangles, false);
+	stitchedGraph.LinkEdges(halfTriangles, stitchedGraph.GetNumTriangles(), false);
+	SELF_TEST_CHECK(context, !HasSameNeighbors(stitchedGraph, navGraph));
+	stitchedGraph.LinkEdges(0, stitchedGraph.GetNumTriangles(), true);
+	SELF_TEST_CHECK(context, HasSameNeighbors(stitchedGraph, navGraph));
+
+	// Three triangles on one edge: the first two pair up and the third is left open on it
+	NavGraph fanGraph;
+	fanGraph.m_vertices = { Vec3(0.f, 0.f, 0.f), Vec3(1.f, 0.f, 0.f), Vec3(0.5f, 1.f, 0.f), Vec3(0.5f, -1.f, 0.f), Vec3(0.5f, 0.5f, 1.f) };
+	fanGraph.m_triangles.resize(3);
+	int const fanVertexIndexes[3][3] = { { 0, 1, 2 }, { 1, 0, 3 }, { 0, 1, 4 } };
+	for (int triangleIndex = 0; triangleIndex < 3; triangleIndex++)
+	{
+		for (int corner = 0; corner < 3; corner++)
+		{
+			fanGraph.m_triangles[triangleIndex].m_vertexIndexes[corner] = fanVertexIndexes[triangleIndex][corner];
+		}
+	}
+	fanGraph.LinkEdges(0, 3, false);
+	SELF_TEST_CHECK(context, fanGraph.m_triangles[0].m_neighborIndexes[0] == 1);
+	SELF_TEST_CHECK(context, fanGraph.m_triangles[1].m_neighborIndexes[0] == 0);
+	SELF_TEST_CHECK(context, fanGraph.m_triangles[2].m_neighborIndexes[0] == NAV_INVALID_INDEX);
+}
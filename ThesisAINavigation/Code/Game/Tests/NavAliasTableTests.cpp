@@ -0,0 +1,97 @@
+#include "Game/Tests/SelfTests.hpp"
+#include "Game/Navigation/NavAliasTable.hpp"
+#include "Game/Navigation/NavBenchmark.hpp"
+#include "Game/Navigation/NavGraph.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include <cmath>
+#include <vector>
+
+// Exact pick probabilities of one range: a uniform slot, then either the slot or its alias
+static std::vector<double> GetSelfTestPickProbabilities(NavAliasTable const& aliasTable, int firstSlot, int numSlots)
+{
+	std::vector<double> probabilities(static_cast<size_t>(numSlots), 0.0);
+	for (int slot = firstSlot; slot < firstSlot + numSlots; slot++)
+	{
+		double keep = static_cast<double>(aliasTable.m_probabilities[slot]);
+		probabilities[slot - firstSlot] += keep / numSlots;
+
+		int alias = aliasTable.m_aliases[slot];
+		if (alias >= firstSlot && alias < firstSlot + numSlots)
+		{
+			probabilities[alias - firstSlot] += (1.0 - keep) / numSlots;
+		}
+	}
+	return probabilities;
+}
+
+static bool IsRangeMatchingWeights(NavAliasTable const& aliasTable, std::vector<float> const& weights, int firstSlot, int numSlots)
+{
+	double totalWeight = 0.0;
+	for (int slot = firstSlot; slot < firstSlot + numSlots; slot++)
+	{
+		totalWeight += weights[slot];
+	}
+
+	std::vector<double> probabilities = GetSelfTestPickProbabilities(aliasTable, firstSlot, numSlots);
+	for (int offset = 0; offset < numSlots; offset++)
+	{
+		double expected = (totalWeight > 0.0) ? weights[firstSlot + offset] / totalWeight : 1.0 / numSlots;
+		if (fabs(probabilities[offset] - expected) > 1e-5) return false;
+	}
+	return true;
+}
+
+void SelfTests::RunNavAliasTableTests(SelfTestContext& context)
+{
+	// Two ranges side by side, one skewed with a zero weight and one all zero
+	std::vector<float> const weights = { 1.f, 0.f, 6.f, 2.f, 0.5f, 0.5f, 0.f, 0.f, 0.f };
+	NavAliasTable aliasTable;
+	aliasTable.Resize(static_cast<int>(weights.size()));
+	aliasTable.BuildRange(weights, 0, 6);
+	aliasTable.BuildRange(weights, 6, 3);
+
+	SELF_TEST_CHECK(context, IsRangeMatchingWeights(aliasTable, weights, 0, 6));
+	SELF_TEST_CHECK(context, IsRangeMatchingWeights(aliasTable, weights, 6, 3));
+
+	// Every pick over a fine sweep of both random numbers stays in its range, and weight zero is never picked
+	int numOutOfRange = 0;
+	int numZeroWeightPicks = 0;
+	for (int slotStep = 0; slotStep <= 100; slotStep++)
+	{
+		for (int aliasStep = 0; aliasStep <= 100; aliasStep++)
+		{
+			float slotZeroToOne = static_cast<float>(slotStep) / 100.f;
+			float aliasZeroToOne = static_cast<float>(aliasStep) / 100.f;
+			int pick = aliasTable.Sample(0, 6, slotZeroToOne, aliasZeroToOne);
+			if (pick < 0 || pick >= 6) numOutOfRange++;
+			else if (weights[pick] == 0.f && aliasZeroToOne < 1.f) numZeroWeightPicks++;
+
+			int uniformPick = aliasTable.Sample(6, 3, slotZeroToOne, aliasZeroToOne);
+			if (uniformPick < 6 || uniformPick >= 9) numOutOfRange++;
+		}
+	}
+	SELF_TEST_CHECK(context, numOutOfRange == 0);
+	SELF_TEST_CHECK(context, numZeroWeightPicks == 0);
+
+	// Triangles are weighted by area, over a whole jittered grid
+	NavGraph navGraph;
+	NavBenchmark::BuildGridGraph(IntVec2(24, 18), 5, navGraph);
+	std::vector<float> triangleAreas;
+	for (int slot = 0; slot < static_cast<int>(navGraph.m_componentTriangles.size()); slot++)
+	{
+		triangleAreas.emplace_back(navGraph.GetTriangleArea(navGraph.m_componentTriangles[slot]));
+	}
+	SELF_TEST_CHECK(context, static_cast<int>(triangleAreas.size()) == navGraph.GetNumTriangles());
+	SELF_TEST_CHECK(context, IsRangeMatchingWeights(navGraph.m_areaSampler, triangleAreas, 0, navGraph.GetNumTriangles()));
+
+	// Points are drawn inside their triangle, folded pairs included
+	int numOutsidePoints = 0;
+	for (int step = 0; step < 64; step++)
+	{
+		int triangleIndex = navGraph.GetRandomTriangle(static_cast<float>(step) / 64.f, 0.5f);
+		float u = static_cast<float>(step % 8) / 8.f + 0.05f;
+		float v = static_cast<float>(step / 8) / 8.f + 0.05f;
+		if (!navGraph.IsPointInsideTriangleXY(triangleIndex, navGraph.GetPointInTriangle(triangleIndex, u, v))) numOutsidePoints++;
+	}
+	SELF_TEST_CHECK(context, numOutsidePoints == 0);
+}
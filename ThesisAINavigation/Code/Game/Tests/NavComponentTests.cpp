@@ -0,0 +1,79 @@
+#include "Game/Tests/SelfTests.hpp"
+#include "Game/Navigation/NavBenchmark.hpp"
+#include "Game/Navigation/NavGraph.hpp"
+#include "Game/Navigation/NavPathfinder.hpp"
+#include "Game/Navigation/NavSearchContext.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include <vector>
+
+void SelfTests::RunNavComponentTests(SelfTestContext& context)
+{
+	// Grid graphs write two triangles per quad, row by row
+	int const gridWidth = 30;
+	int const gridHeight = 20;
+	int const numQuadsX = gridWidth - 1;
+	NavGraph navGraph;
+	NavBenchmark::BuildGridGraph(IntVec2(gridWidth, gridHeight), 11, navGraph);
+	SELF_TEST_CHECK(context, navGraph.HasUpToDateComponents());
+	SELF_TEST_CHECK(context, navGraph.GetNumComponents() == 1);
+
+	int westTriangle = navGraph.FindNearestTriangle(Vec3(3.f, 10.f, 0.f));
+	int eastTriangle = navGraph.FindNearestTriangle(Vec3(25.f, 10.f, 0.f));
+	SELF_TEST_CHECK(context, navGraph.IsGoalReachable(westTriangle, eastTriangle));
+
+	// A wall one quad wide from top to bottom splits the map in two
+	int const wallQuadX = 12;
+	for (int triangleIndex = 0; triangleIndex < navGraph.GetNumTriangles(); triangleIndex++)
+	{
+		if ((triangleIndex / 2) % numQuadsX == wallQuadX)
+		{
+			navGraph.SetTriangleCostScale(triangleIndex, NAV_BLOCKED_COST_SCALE);
+		}
+	}
+	SELF_TEST_CHECK(context, !navGraph.HasUpToDateComponents());
+	navGraph.LabelComponents();
+	SELF_TEST_CHECK(context, navGraph.HasUpToDateComponents());
+	SELF_TEST_CHECK(context, navGraph.GetNumComponents() == 2);
+
+	int wallTriangle = (wallQuadX * 2) + (5 * numQuadsX * 2);
+	int westNeighborTriangle = navGraph.FindNearestTriangle(Vec3(8.f, 4.f, 0.f));
+	SELF_TEST_CHECK(context, navGraph.GetComponent(wallTriangle) == NAV_INVALID_INDEX);
+	SELF_TEST_CHECK(context, navGraph.GetComponent(westTriangle) != navGraph.GetComponent(eastTriangle));
+
+	// Across the wall and onto it are rejected, the same side is not, and a start on the wall rules nothing out
+	SELF_TEST_CHECK(context, !navGraph.IsGoalReachable(westTriangle, eastTriangle));
+	SELF_TEST_CHECK(context, !navGraph.IsGoalReachable(eastTriangle, westTriangle));
+	SELF_TEST_CHECK(context, !navGraph.IsGoalReachable(westTriangle, wallTriangle));
+	SELF_TEST_CHECK(context, !navGraph.IsGoalReachable(westTriangle, NAV_INVALID_INDEX));
+	SELF_TEST_CHECK(context, navGraph.IsGoalReachable(westTriangle, westNeighborTriangle));
+	SELF_TEST_CHECK(context, navGraph.IsGoalReachable(wallTriangle, eastTriangle));
+
+	// What the components reject, the search cannot find either
+	NavPathfinder pathfinder(&navGraph);
+	NavSearchContext& searchContext = NavSearchContext::GetForCurrentThread();
+	SELF_TEST_CHECK(context, !pathfinder.FindCorridor(westTriangle, eastTriangle, searchContext));
+	SELF_TEST_CHECK(context, pathfinder.FindCorridor(westTriangle, westNeighborTriangle, searchContext));
+
+	// Goals drawn from a component stay in it
+	int westComponent = navGraph.GetComponent(westTriangle);
+	int numStrayGoals = 0;
+	for (int sampleIndex = 0; sampleIndex < 200; sampleIndex++)
+	{
+		float zeroToOne = static_cast<float>(sampleIndex) / 200.f;
+		int goalTriangle = navGraph.GetRandomTriangleInComponent(westComponent, zeroToOne, 1.f - zeroToOne);
+		if (navGraph.GetComponent(goalTriangle) != westComponent) numStrayGoals++;
+	}
+	SELF_TEST_CHECK(context, numStrayGoals == 0);
+
+	// Lifting the wall joins the halves again
+	for (int triangleIndex = 0; triangleIndex < navGraph.GetNumTriangles(); triangleIndex++)
+	{
+		if (navGraph.IsTriangleBlocked(triangleIndex))
+		{
+			navGraph.SetTriangleCostScale(triangleIndex, 1.f);
+		}
+	}
+	navGraph.LabelComponents();
+	SELF_TEST_CHECK(context, navGraph.GetNumComponents() == 1);
+	SELF_TEST_CHECK(context, navGraph.IsGoalReachable(westTriangle, eastTriangle));
+}
@@ -0,0 +1,105 @@
+#include "Game/Tests/SelfTests.hpp"
+#include "Game/Navigation/NavBenchmark.hpp"
+#include "Game/Navigation/NavDStarLite.hpp"
+#include "Game/Navigation/NavGraph.hpp"
+#include "Game/Navigation/NavPathfinder.hpp"
+#include "Game/Navigation/NavSearchContext.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+// FLT_MAX when the corridor steps into a blocked triangle or two triangles that are not neighbors
+static float GetSelfTestCorridorCost(NavGraph const& navGraph, std::vector<int> const& corridor)
+{
+	float cost = 0.f;
+	for (int corridorIndex = 1; corridorIndex < static_cast<int>(corridor.size()); corridorIndex++)
+	{
+		float edgeCost = navGraph.GetEdgeCost(corridor[corridorIndex - 1], corridor[corridorIndex]);
+		if (edgeCost == FLT_MAX) return FLT_MAX;
+		cost += edgeCost;
+	}
+	return cost;
+}
+
+static bool IsSameCost(float costA, float costB)
+{
+	return costA != FLT_MAX && costB != FLT_MAX && fabsf(costA - costB) <= 0.001f * costA + 0.001f;
+}
+
+void SelfTests::RunNavDStarLiteTests(SelfTestContext& context)
+{
+	NavGraph navGraph;
+	NavBenchmark::BuildGridGraph(IntVec2(48, 48), 7, navGraph);
+	NavPathfinder pathfinder(&navGraph);
+	NavSearchContext& searchContext = NavSearchContext::GetForCurrentThread();
+
+	int startTriangle = navGraph.FindNearestTriangle(Vec3(3.f, 3.f, 0.f));
+	int goalTriangle = navGraph.FindNearestTriangle(Vec3(44.f, 40.f, 0.f));
+
+	// The first plan is a full search and has to match A*
+	NavDStarLite planner;
+	std::vector<int> corridor;
+	SELF_TEST_CHECK(context, planner.Plan(&navGraph, startTriangle, goalTriangle));
+	SELF_TEST_CHECK(context, planner.ExtractCorridor(corridor) && corridor.front() == startTriangle && corridor.back() == goalTriangle);
+	SELF_TEST_CHECK(context, pathfinder.FindCorridor(startTriangle, goalTriangle, searchContext));
+	SELF_TEST_CHECK(context, IsSameCost(GetSelfTestCorridorCost(navGraph, corridor), GetSelfTestCorridorCost(navGraph, searchContext.m_corridor)));
+	if (corridor.size() < 20) return;
+
+	// Move a few steps along the corridor and drop a blocker across the middle of what is left
+	int movedStartTriangle = corridor[5];
+	Vec3 blockCenter = navGraph.m_triangles[corridor[corridor.size() / 2]].m_centroid;
+	std::vector<int> blockedTriangles;
+	for (int triangleIndex = 0; triangleIndex < navGraph.GetNumTriangles(); triangleIndex++)
+	{
+		if (triangleIndex == movedStartTriangle || triangleIndex == goalTriangle) continue;
+		if (GetDistanceSquared3D(navGraph.m_triangles[triangleIndex].m_centroid, blockCenter) < 25.f)
+		{
+			navGraph.SetTriangleCostScale(triangleIndex, NAV_BLOCKED_COST_SCALE);
+			blockedTriangles.emplace_back(triangleIndex);
+		}
+	}
+	SELF_TEST_CHECK(context, planner.HasPendingChanges(&navGraph));
+
+	// The repair routes around the blocker at the same cost as a fresh search, and expands less
+	SELF_TEST_CHECK(context, planner.Plan(&navGraph, movedStartTriangle, goalTriangle));
+	SELF_TEST_CHECK(context, !planner.HasPendingChanges(&navGraph));
+	int numRepairExpanded = planner.m_lastPlanStats.m_numExpanded;
+	SELF_TEST_CHECK(context, planner.ExtractCorridor(corridor) && corridor.front() == movedStartTriangle);
+	float repairedCost = GetSelfTestCorridorCost(navGraph, corridor);
+	SELF_TEST_CHECK(context, repairedCost != FLT_MAX);
+
+	SELF_TEST_CHECK(context, pathfinder.FindCorridor(movedStartTriangle, goalTriangle, searchContext));
+	SELF_TEST_CHECK(context, IsSameCost(repairedCost, GetSelfTestCorridorCost(navGraph, searchContext.m_corridor)));
+
+	NavDStarLite freshPlanner;
+	SELF_TEST_CHECK(context, freshPlanner.Plan(&navGraph, movedStartTriangle, goalTriangle));
+	SELF_TEST_CHECK(context, numRepairExpanded > 0 && numRepairExpanded < freshPlanner.m_lastPlanStats.m_numExpanded);
+
+	// Lifting the blocker again repairs back to the unobstructed optimum
+	for (int triangleIndex : blockedTriangles)
+	{
+		navGraph.SetTriangleCostScale(triangleIndex, 1.f);
+	}
+	SELF_TEST_CHECK(context, planner.Plan(&navGraph, movedStartTriangle, goalTriangle));
+	SELF_TEST_CHECK(context, planner.ExtractCorridor(corridor));
+	SELF_TEST_CHECK(context, pathfinder.FindCorridor(movedStartTriangle, goalTriangle, searchContext));
+	SELF_TEST_CHECK(context, IsSameCost(GetSelfTestCorridorCost(navGraph, corridor), GetSelfTestCorridorCost(navGraph, searchContext.m_corridor)));
+
+	// A goal walled off completely is reported as unreachable instead of a corridor through the wall
+	NavTriangle const& goal = navGraph.m_triangles[goalTriangle];
+	for (int edge = 0; edge < 3; edge++)
+	{
+		if (goal.m_neighborIndexes[edge] != NAV_INVALID_INDEX)
+		{
+			navGraph.SetTriangleCostScale(goal.m_neighborIndexes[edge], NAV_BLOCKED_COST_SCALE);
+		}
+	}
+	SELF_TEST_CHECK(context, !planner.Plan(&navGraph, movedStartTriangle, goalTriangle));
+	SELF_TEST_CHECK(context, !planner.ExtractCorridor(corridor));
+
+	// A rebuilt graph is never repaired against, the planner starts over
+	NavBenchmark::BuildGridGraph(IntVec2(48, 48), 7, navGraph);
+	SELF_TEST_CHECK(context, planner.Plan(&navGraph, movedStartTriangle, goalTriangle));
+	SELF_TEST_CHECK(context, planner.ExtractCorridor(corridor) && corridor.back() == goalTriangle);
+}
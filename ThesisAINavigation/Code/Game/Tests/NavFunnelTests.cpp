@@ -0,0 +1,65 @@
+#include "Game/Tests/SelfTests.hpp"
+#include "Game/Navigation/NavGraph.hpp"
+#include "Game/Navigation/NavPathfinder.hpp"
+#include <cmath>
+#include <vector>
+
+static bool IsSamePointXY(Vec3 const& pointA, Vec3 const& pointB)
+{
+	return fabsf(pointA.x - pointB.x) <= 0.001f && fabsf(pointA.y - pointB.y) <= 0.001f;
+}
+
+void SelfTests::RunNavFunnelTests(SelfTestContext& context)
+{
+	// An L shaped corridor on an unjittered 6x6 vertex grid: the bottom row of quads, then the right
+	// column. The only corner a walker has to turn at is the inner corner of the L at (4, 1).
+	int const gridSize = 6;
+	std::vector<Vec3> vertices;
+	std::vector<int> vertexMapping;
+	for (int y = 0; y < gridSize; y++)
+	{
+		for (int x = 0; x < gridSize; x++)
+		{
+			bool isInCorridor = (y <= 1) || (x >= 4);
+			vertexMapping.emplace_back(isInCorridor ? static_cast<int>(vertices.size()) : NAV_INVALID_INDEX);
+			if (isInCorridor)
+			{
+				vertices.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.f);
+			}
+		}
+	}
+
+	NavGraph navGraph;
+	navGraph.Build(vertices, gridSize, gridSize, vertexMapping);
+	SELF_TEST_CHECK(context, navGraph.GetNumTriangles() == 18);
+	SELF_TEST_CHECK(context, navGraph.GetNumComponents() == 1);
+
+	NavPathfinder pathfinder(&navGraph);
+	std::vector<Vec3> path;
+
+	// Goal at the front, corners after it in reverse walking order
+	Vec3 const start(0.5f, 0.5f, 0.f);
+	Vec3 const goal(4.5f, 4.5f, 0.f);
+	Vec3 const innerCorner(4.f, 1.f, 0.f);
+	SELF_TEST_CHECK(context, pathfinder.ComputeAStar(start, goal, path));
+	SELF_TEST_CHECK(context, path.size() == 2 && IsSamePointXY(path[0], goal) && IsSamePointXY(path[1], innerCorner));
+
+	// Walking the other way turns at the same corner
+	SELF_TEST_CHECK(context, pathfinder.ComputeAStar(goal, start, path));
+	SELF_TEST_CHECK(context, path.size() == 2 && IsSamePointXY(path[0], start) && IsSamePointXY(path[1], innerCorner));
+
+	// Along one arm there is nothing to turn at, the goal is the only waypoint
+	Vec3 const armEnd(3.5f, 0.25f, 0.f);
+	SELF_TEST_CHECK(context, pathfinder.ComputeAStar(start, armEnd, path));
+	SELF_TEST_CHECK(context, path.size() == 1 && IsSamePointXY(path[0], armEnd));
+
+	// Start and goal in the same triangle
+	Vec3 const sameTriangleGoal(0.75f, 0.2f, 0.f);
+	SELF_TEST_CHECK(context, pathfinder.ComputeAStar(start, sameTriangleGoal, path));
+	SELF_TEST_CHECK(context, path.size() == 1 && IsSamePointXY(path[0], sameTriangleGoal));
+
+	// The path length follows the corners: start to the inner corner, then up the right arm
+	SELF_TEST_CHECK(context, pathfinder.ComputeAStar(start, goal, path));
+	float expectedLength = sqrtf((3.5f * 3.5f) + (0.5f * 0.5f)) + sqrtf((0.5f * 0.5f) + (3.5f * 3.5f));
+	SELF_TEST_CHECK(context, fabsf(NavPathfinder::GetPathLength(start, path) - expectedLength) <= 0.001f);
+}
@@ -0,0 +1,124 @@
+#include "Game/Tests/SelfTests.hpp"
+#include "Game/Navigation/NavBenchmark.hpp"
+#include "Game/Navigation/NavGraph.hpp"
+#include "Game/Navigation/NavGraphCache.hpp"
+#include "Game/Navigation/NavHierarchy.hpp"
+#include "Game/Navigation/NavLandmarks.hpp"
+#include "Game/Navigation/NavSearchContext.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+template<typename ElementType>
+static bool IsSameBytes(std::vector<ElementType> const& arrayA, std::vector<ElementType> const& arrayB)
+{
+	return arrayA.size() == arrayB.size() && (arrayA.empty() || memcmp(arrayA.data(), arrayB.data(), arrayA.size() * sizeof(ElementType)) == 0);
+}
+
+static std::vector<char> ReadSelfTestFile(std::string const& filePath)
+{
+	std::ifstream file(filePath, std::ios::binary);
+	return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static void WriteSelfTestFile(std::string const& filePath, std::vector<char> const& bytes)
+{
+	std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+	file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+void SelfTests::RunNavGraphCacheTests(SelfTestContext& context)
+{
+	NavGraph navGraph;
+	NavBenchmark::BuildGridGraph(IntVec2(60, 60), 11, navGraph);
+	NavHierarchy navHierarchy;
+	navHierarchy.Build(&navGraph);
+	NavLandmarks landmarks;
+	landmarks.Build(&navGraph, 4);
+
+	// A key no real terrain produces, so the test never overwrites or reads a game cache file
+	NavGraphCacheKey key;
+	key.m_gridWidth = 60;
+	key.m_gridHeight = 60;
+	key.m_seed = 0x5E1F7E57;
+	key.m_heightMapHash = 0x5E1F7E575E1F7E57ull;
+	std::string cachePath = NavGraphCache::GetCachePath(key);
+	std::remove(cachePath.c_str());
+
+	NavGraph loadedGraph;
+	NavHierarchy loadedHierarchy;
+	NavLandmarks loadedLandmarks;
+	SELF_TEST_CHECK(context, !NavGraphCache::Load(key, loadedGraph, loadedHierarchy, loadedLandmarks));
+
+	// Everything saved comes back byte for byte, and the loaded layers are built for the loaded graph
+	SELF_TEST_CHECK(context, NavGraphCache::Save(key, navGraph, navHierarchy, landmarks));
+	SELF_TEST_CHECK(context, NavGraphCache::Load(key, loadedGraph, loadedHierarchy, loadedLandmarks));
+	SELF_TEST_CHECK(context, IsSameBytes(loadedGraph.m_vertices, navGraph.m_vertices));
+	SELF_TEST_CHECK(context, IsSameBytes(loadedGraph.m_triangles, navGraph.m_triangles));
+	SELF_TEST_CHECK(context, IsSameBytes(loadedHierarchy.m_nodes, navHierarchy.m_nodes));
+	SELF_TEST_CHECK(context, IsSameBytes(loadedHierarchy.m_edges, navHierarchy.m_edges));
+	SELF_TEST_CHECK(context, IsSameBytes(loadedHierarchy.m_clusterNodes, navHierarchy.m_clusterNodes));
+	SELF_TEST_CHECK(context, IsSameBytes(loadedHierarchy.m_landmarkNodes, navHierarchy.m_landmarkNodes));
+	SELF_TEST_CHECK(context, IsSameBytes(loadedHierarchy.m_landmarkDistances, navHierarchy.m_landmarkDistances));
+	SELF_TEST_CHECK(context, IsSameBytes(loadedLandmarks.m_landmarkTriangles, landmarks.m_landmarkTriangles));
+	SELF_TEST_CHECK(context, IsSameBytes(loadedLandmarks.m_distances, landmarks.m_distances));
+	SELF_TEST_CHECK(context, loadedHierarchy.IsBuiltFor(&loadedGraph));
+	SELF_TEST_CHECK(context, loadedLandmarks.IsBuiltFor(&loadedGraph));
+
+	// The loaded hierarchy answers a long query with the same corridor as the one it was saved from
+	NavSearchContext& searchContext = NavSearchContext::GetForCurrentThread();
+	int startTriangle = 0;
+	int goalTriangle = navGraph.GetNumTriangles() - 1;
+	SELF_TEST_CHECK(context, navHierarchy.FindCorridor(startTriangle, goalTriangle, searchContext));
+	std::vector<int> savedCorridor = searchContext.m_corridor;
+	SELF_TEST_CHECK(context, loadedHierarchy.FindCorridor(startTriangle, goalTriangle, searchContext));
+	SELF_TEST_CHECK(context, searchContext.m_corridor == savedCorridor);
+
+	// A different heightmap is a different key
+	NavGraphCacheKey otherKey = key;
+	otherKey.m_heightMapHash++;
+	NavGraph otherGraph;
+	NavHierarchy otherHierarchy;
+	NavLandmarks otherLandmarks;
+	SELF_TEST_CHECK(context, !NavGraphCache::Load(otherKey, otherGraph, otherHierarchy, otherLandmarks));
+
+	// Damaged files are misses, never partial loads
+	std::vector<char> fileBytes = ReadSelfTestFile(cachePath);
+	SELF_TEST_CHECK(context, fileBytes.size() > 4);
+
+	std::vector<char> truncatedBytes(fileBytes.begin(), fileBytes.begin() + fileBytes.size() / 2);
+	WriteSelfTestFile(cachePath, truncatedBytes);
+	SELF_TEST_CHECK(context, !NavGraphCache::Load(key, otherGraph, otherHierarchy, otherLandmarks));
+
+	std::vector<char> wrongMagicBytes = fileBytes;
+	wrongMagicBytes[0] = static_cast<char>(~wrongMagicBytes[0]);
+	WriteSelfTestFile(cachePath, wrongMagicBytes);
+	SELF_TEST_CHECK(context, !NavGraphCache::Load(key, otherGraph, otherHierarchy, otherLandmarks));
+
+	// A triangle vertex index pointing past the vertex array fails the consistency check
+	std::vector<char> corruptBytes = fileBytes;
+	std::vector<char> triangleBytes(sizeof(NavTriangle));
+	memcpy(triangleBytes.data(), &navGraph.m_triangles[5], sizeof(NavTriangle));
+	auto foundTriangle = std::search(corruptBytes.begin(), corruptBytes.end(), triangleBytes.begin(), triangleBytes.end());
+	SELF_TEST_CHECK(context, foundTriangle != corruptBytes.end());
+	if (foundTriangle != corruptBytes.end())
+	{
+		int badVertexIndex = static_cast<int>(navGraph.m_vertices.size()) + 1000;
+		memcpy(&*foundTriangle, &badVertexIndex, sizeof(int));
+		WriteSelfTestFile(cachePath, corruptBytes);
+		SELF_TEST_CHECK(context, !NavGraphCache::Load(key, otherGraph, otherHierarchy, otherLandmarks));
+	}
+
+	// Without landmark tables the graph and hierarchy still round-trip, and the landmarks come back unbuilt
+	NavLandmarks emptyLandmarks;
+	SELF_TEST_CHECK(context, NavGraphCache::Save(key, navGraph, navHierarchy, emptyLandmarks));
+	SELF_TEST_CHECK(context, NavGraphCache::Load(key, otherGraph, otherHierarchy, otherLandmarks));
+	SELF_TEST_CHECK(context, IsSameBytes(otherGraph.m_triangles, navGraph.m_triangles));
+	SELF_TEST_CHECK(context, otherHierarchy.IsBuiltFor(&otherGraph));
+	SELF_TEST_CHECK(context, !otherLandmarks.IsBuiltFor(&otherGraph));
+
+	std::remove(cachePath.c_str());
+}
@@ -0,0 +1,54 @@
+#include "Game/Tests/SelfTests.hpp"
+#include "Game/Navigation/NavPathCache.hpp"
+#include <vector>
+
+void SelfTests::RunNavPathCacheTests(SelfTestContext& context)
+{
+	std::vector<int> const corridorA = { 1, 7, 2 };
+	std::vector<int> const corridorB = { 3, 8, 9, 4 };
+	std::vector<int> const corridorC = { 5, 6 };
+	std::vector<int> corridor;
+
+	NavPathCache pathCache(2);
+	SELF_TEST_CHECK(context, !pathCache.TryGetCorridor(1, 2, 1, corridor));
+	SELF_TEST_CHECK(context, pathCache.GetNumMisses() == 1);
+
+	pathCache.StoreCorridor(1, 2, 1, corridorA);
+	pathCache.StoreCorridor(3, 4, 1, corridorB);
+	SELF_TEST_CHECK(context, pathCache.GetNumEntries() == 2);
+
+	// The key is ordered, the reverse pair is a different corridor
+	SELF_TEST_CHECK(context, !pathCache.TryGetCorridor(2, 1, 1, corridor));
+
+	// Touching (1, 2) leaves (3, 4) as the least recently used, so it is the one the next store evicts
+	SELF_TEST_CHECK(context, pathCache.TryGetCorridor(1, 2, 1, corridor) && corridor == corridorA);
+	pathCache.StoreCorridor(5, 6, 1, corridorC);
+	SELF_TEST_CHECK(context, pathCache.GetNumEntries() == 2);
+	SELF_TEST_CHECK(context, !pathCache.TryGetCorridor(3, 4, 1, corridor));
+	SELF_TEST_CHECK(context, pathCache.TryGetCorridor(1, 2, 1, corridor) && corridor == corridorA);
+	SELF_TEST_CHECK(context, pathCache.TryGetCorridor(5, 6, 1, corridor) && corridor == corridorC);
+
+	// A second store of a cached pair keeps the first corridor
+	pathCache.StoreCorridor(5, 6, 1, corridorB);
+	SELF_TEST_CHECK(context, pathCache.TryGetCorridor(5, 6, 1, corridor) && corridor == corridorC);
+	SELF_TEST_CHECK(context, pathCache.GetNumEntries() == 2);
+
+	SELF_TEST_CHECK(context, pathCache.GetNumHits() == 4);
+	SELF_TEST_CHECK(context, pathCache.GetNumMisses() == 3);
+
+	// A newer graph version drops every entry, and so does an older one
+	SELF_TEST_CHECK(context, !pathCache.TryGetCorridor(1, 2, 2, corridor));
+	SELF_TEST_CHECK(context, pathCache.GetNumEntries() == 0);
+	pathCache.StoreCorridor(1, 2, 2, corridorA);
+	SELF_TEST_CHECK(context, !pathCache.TryGetCorridor(1, 2, 1, corridor));
+	SELF_TEST_CHECK(context, pathCache.GetNumEntries() == 0);
+
+	pathCache.StoreCorridor(1, 2, 1, corridorA);
+	pathCache.Clear();
+	SELF_TEST_CHECK(context, pathCache.GetNumEntries() == 0);
+
+	NavPathCache disabledCache(0);
+	disabledCache.StoreCorridor(1, 2, 1, corridorA);
+	SELF_TEST_CHECK(context, disabledCache.GetNumEntries() == 0);
+	SELF_TEST_CHECK(context, !disabledCache.TryGetCorridor(1, 2, 1, corridor));
+}
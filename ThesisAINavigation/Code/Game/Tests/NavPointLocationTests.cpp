@@ -0,0 +1,77 @@
+#include "Game/Tests/SelfTests.hpp"
+#include "Game/Navigation/NavBenchmark.hpp"
+#include "Game/Navigation/NavGraph.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include <vector>
+
+static float GetSelfTestCentroidDistanceSq(NavGraph const& navGraph, int triangleIndex, Vec3 const& point)
+{
+	Vec3 const& centroid = navGraph.m_triangles[triangleIndex].m_centroid;
+	float dx = centroid.x - point.x;
+	float dy = centroid.y - point.y;
+	return (dx * dx) + (dy * dy);
+}
+
+void SelfTests::RunNavPointLocationTests(SelfTestContext& context)
+{
+	NavGraph navGraph;
+	NavBenchmark::BuildGridGraph(IntVec2(36, 28), 9, navGraph);
+
+	// The same graph without its bucket grid scans every triangle, which is what the grid has to agree with
+	NavGraph scannedGraph = navGraph;
+	scannedGraph.m_gridCellFirstTriangles.clear();
+	scannedGraph.m_gridCellTriangles.clear();
+
+	// Points on the mesh land in a triangle that contains them, with or without the grid
+	int numMissedInside = 0;
+	int numWrongTriangles = 0;
+	for (int stepY = 0; stepY < 40; stepY++)
+	{
+		for (int stepX = 0; stepX < 50; stepX++)
+		{
+			Vec3 point(1.f + (static_cast<float>(stepX) * 0.67f), 1.f + (static_cast<float>(stepY) * 0.63f), 0.f);
+			int triangleIndex = navGraph.FindContainingTriangle(point);
+			int scannedTriangle = scannedGraph.FindContainingTriangle(point);
+			if (scannedTriangle == NAV_INVALID_INDEX) continue;
+
+			if (triangleIndex == NAV_INVALID_INDEX) numMissedInside++;
+			else if (!navGraph.IsPointInsideTriangleXY(triangleIndex, point)) numWrongTriangles++;
+		}
+	}
+	SELF_TEST_CHECK(context, numMissedInside == 0);
+	SELF_TEST_CHECK(context, numWrongTriangles == 0);
+
+	// Off the mesh, near and far, nearest means the nearest centroid
+	std::vector<Vec3> const offMeshPoints = { Vec3(-0.5f, 10.f, 0.f), Vec3(40.f, 30.f, 0.f), Vec3(-200.f, -150.f, 0.f), Vec3(17.f, 500.f, 0.f), Vec3(36.2f, 3.f, 0.f) };
+	int numNotNearest = 0;
+	for (Vec3 const& point : offMeshPoints)
+	{
+		if (navGraph.FindContainingTriangle(point) != NAV_INVALID_INDEX) continue;
+
+		int nearestTriangle = navGraph.FindNearestTriangle(point);
+		int scannedTriangle = scannedGraph.FindNearestTriangle(point);
+		if (nearestTriangle == NAV_INVALID_INDEX || GetSelfTestCentroidDistanceSq(navGraph, nearestTriangle, point) > GetSelfTestCentroidDistanceSq(navGraph, scannedTriangle, point))
+		{
+			numNotNearest++;
+		}
+	}
+	SELF_TEST_CHECK(context, numNotNearest == 0);
+
+	// A hint from a moment ago walks a few edges, a stale or bad hint still finds the triangle
+	Vec3 const walkerStart(5.3f, 5.7f, 0.f);
+	int hintTriangle = navGraph.FindNearestTriangle(walkerStart);
+	int numLostWalks = 0;
+	for (int step = 1; step <= 60; step++)
+	{
+		Vec3 point(walkerStart.x + (static_cast<float>(step) * 0.4f), walkerStart.y + (static_cast<float>(step) * 0.3f), 0.f);
+		hintTriangle = navGraph.FindNearestTriangleFromHint(point, hintTriangle);
+		if (!navGraph.IsPointInsideTriangleXY(hintTriangle, point)) numLostWalks++;
+	}
+	SELF_TEST_CHECK(context, numLostWalks == 0);
+
+	Vec3 const farPoint(33.4f, 24.6f, 0.f);
+	int farTriangle = navGraph.FindNearestTriangleFromHint(farPoint, 0);
+	SELF_TEST_CHECK(context, navGraph.IsPointInsideTriangleXY(farTriangle, farPoint));
+	SELF_TEST_CHECK(context, navGraph.FindNearestTriangleFromHint(farPoint, NAV_INVALID_INDEX) == navGraph.FindNearestTriangle(farPoint));
+	SELF_TEST_CHECK(context, navGraph.FindNearestTriangleFromHint(farPoint, navGraph.GetNumTriangles()) == navGraph.FindNearestTriangle(farPoint));
+}
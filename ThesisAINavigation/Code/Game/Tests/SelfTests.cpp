@@ -0,0 +1,48 @@
+#include "Game/Tests/SelfTests.hpp"
+#include <cstdio>
+
+void SelfTestContext::Check(bool condition, char const* expression, char const* fileName, int lineNumber)
+{
+	m_numChecks++;
+	if (condition) return;
+
+	m_numFailures++;
+	printf("FAILED: %s (%s:%d)\n", expression, fileName, lineNumber);
+}
+
+int SelfTests::RunAll()
+{
+	struct Suite
+	{
+		char const* m_name;
+		void (*m_run)(SelfTestContext&);
+	};
+	Suite const suites[] =
+	{
+		{ "ActorSlotMap", &RunActorSlotMapTests },
+		{ "AgentSpatialHash", &RunAgentSpatialHashTests },
+		{ "FrameTimeHistogram", &RunFrameTimeHistogramTests },
+		{ "NavPathCache", &RunNavPathCacheTests },
+		{ "NavFunnel", &RunNavFunnelTests },
+		{ "NavAdjacency", &RunNavAdjacencyTests },
+		{ "NavComponents", &RunNavComponentTests },
+		{ "NavAliasTable", &RunNavAliasTableTests },
+		{ "NavPointLocation", &RunNavPointLocationTests },
+		{ "NavDStarLite", &RunNavDStarLiteTests },
+		{ "NavGraphCache", &RunNavGraphCacheTests },
+	};
+
+	SelfTestContext totals;
+	for (Suite const& suite : suites)
+	{
+		SelfTestContext context;
+		suite.m_run(context);
+		printf("%-20s %4d checks, %d failed\n", suite.m_name, context.m_numChecks, context.m_numFailures);
+
+		totals.m_numChecks += context.m_numChecks;
+		totals.m_numFailures += context.m_numFailures;
+	}
+
+	printf("=== Self Tests ===\n%d checks, %d failed\n", totals.m_numChecks, totals.m_numFailures);
+	return totals.m_numFailures;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+//------------------------------------------------------------------------------------------------
+// Counts checks and failures for one selftest run. A failed check prints its expression, file and
+// line and the suite keeps going, so a single run lists every failure.
+struct SelfTestContext
+{
+	void Check(bool condition, char const* expression, char const* fileName, int lineNumber);
+
+	int m_numChecks = 0;
+	int m_numFailures = 0;
+};
+
+#define SELF_TEST_CHECK(context, condition) (context).Check((condition), #condition, __FILE__, __LINE__)
+
+//------------------------------------------------------------------------------------------------
+// Unit checks run by the headless "selftest" argument. Suites that build landmarks queue jobs, so
+// the JobSystem has to be running.
+class SelfTests
+{
+public:
+	// Returns the number of failed checks
+	static int RunAll();
+
+	static void RunActorSlotMapTests(SelfTestContext& context);
+	static void RunAgentSpatialHashTests(SelfTestContext& context);
+	static void RunFrameTimeHistogramTests(SelfTestContext& context);
+	static void RunNavPathCacheTests(SelfTestContext& context);
+	static void RunNavFunnelTests(SelfTestContext& context);
+	static void RunNavAdjacencyTests(SelfTestContext& context);
+	static void RunNavComponentTests(SelfTestContext& context);
+	static void RunNavAliasTableTests(SelfTestContext& context);
+	static void RunNavPointLocationTests(SelfTestContext& context);
+	static void RunNavDStarLiteTests(SelfTestContext& context);
+	static void RunNavGraphCacheTests(SelfTestContext& context);
+};